@@ -0,0 +1,301 @@
+#ifndef BATCH_JSON_HPP_
+#define BATCH_JSON_HPP_
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace Batch {
+
+// ============================================================================
+// Минимальный JSON для потока задач: один плоский объект на строку
+// ============================================================================
+
+// Значение поля объекта. Массивы — только из чисел, вложенные объекты не поддерживаются.
+struct JsonValue {
+    enum class Type { Null, Bool, Number, String, Array };
+
+    Type type = Type::Null;
+    bool boolean = false;
+    double number = 0.0;
+    std::vector<double> numbers; // Элементы Array
+    std::string string; // Для String — значение, для остальных — исходный текст
+};
+
+using JsonObject = std::map<std::string, JsonValue>;
+
+namespace detail {
+
+inline void skipSpaces(const std::string &text, size_t &pos)
+{
+    while (pos < text.size() && (text[pos] == ' ' || text[pos] == '\t' || text[pos] == '\r' || text[pos] == '\n')) {
+        ++pos;
+    }
+}
+
+// Дописывает символ с кодом code в UTF-8
+inline void appendUtf8(std::string &out, unsigned code)
+{
+    if (code < 0x80) {
+        out += static_cast<char>(code);
+    } else if (code < 0x800) {
+        out += static_cast<char>(0xC0 | (code >> 6));
+        out += static_cast<char>(0x80 | (code & 0x3F));
+    } else {
+        out += static_cast<char>(0xE0 | (code >> 12));
+        out += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (code & 0x3F));
+    }
+}
+
+inline bool parseString(const std::string &text, size_t &pos, std::string &out)
+{
+    if (pos >= text.size() || text[pos] != '"') {
+        return false;
+    }
+    ++pos;
+    out.clear();
+    while (pos < text.size()) {
+        const char c = text[pos++];
+        if (c == '"') {
+            return true;
+        }
+        if (c != '\\') {
+            out += c;
+            continue;
+        }
+        if (pos >= text.size()) {
+            return false;
+        }
+        const char e = text[pos++];
+        switch (e) {
+        case '"':  out += '"'; break;
+        case '\\': out += '\\'; break;
+        case '/':  out += '/'; break;
+        case 'b':  out += '\b'; break;
+        case 'f':  out += '\f'; break;
+        case 'n':  out += '\n'; break;
+        case 'r':  out += '\r'; break;
+        case 't':  out += '\t'; break;
+        case 'u': {
+            if (pos + 4 > text.size()) {
+                return false;
+            }
+            char *end = nullptr;
+            const std::string hex = text.substr(pos, 4);
+            const unsigned code = static_cast<unsigned>(std::strtoul(hex.c_str(), &end, 16));
+            if (end != hex.c_str() + 4) {
+                return false;
+            }
+            appendUtf8(out, code);
+            pos += 4;
+            break;
+        }
+        default:
+            return false;
+        }
+    }
+    return false;
+}
+
+inline bool parseNumber(const std::string &text, size_t &pos, double &out)
+{
+    const char *begin = text.c_str() + pos;
+    char *end = nullptr;
+    out = std::strtod(begin, &end);
+    if (end == begin) {
+        return false;
+    }
+    pos += static_cast<size_t>(end - begin);
+    return true;
+}
+
+// [число, ...]
+inline bool parseNumberArray(const std::string &text, size_t &pos, std::vector<double> &out)
+{
+    if (pos >= text.size() || text[pos] != '[') {
+        return false;
+    }
+    ++pos;
+    out.clear();
+    skipSpaces(text, pos);
+    if (pos < text.size() && text[pos] == ']') {
+        ++pos;
+        return true;
+    }
+    while (true) {
+        double number = 0.0;
+        skipSpaces(text, pos);
+        if (!parseNumber(text, pos, number)) {
+            return false;
+        }
+        out.push_back(number);
+        skipSpaces(text, pos);
+        if (pos < text.size() && text[pos] == ',') {
+            ++pos;
+            continue;
+        }
+        if (pos < text.size() && text[pos] == ']') {
+            ++pos;
+            return true;
+        }
+        return false;
+    }
+}
+
+} // namespace detail
+
+/**
+ * Разбор строки вида {"key": value, ...}, где value — строка, число,
+ * true/false, null или массив чисел. При ошибке возвращает false и описание в error.
+ */
+inline bool parseJsonObject(const std::string &text, JsonObject &out, std::string &error)
+{
+    using namespace detail;
+    out.clear();
+    size_t pos = 0;
+    skipSpaces(text, pos);
+    if (pos >= text.size() || text[pos] != '{') {
+        error = "ожидался JSON-объект";
+        return false;
+    }
+    ++pos;
+    skipSpaces(text, pos);
+    if (pos < text.size() && text[pos] == '}') {
+        ++pos;
+    } else {
+        while (true) {
+            std::string key;
+            skipSpaces(text, pos);
+            if (!parseString(text, pos, key)) {
+                error = "ожидалось имя поля в позиции " + std::to_string(pos);
+                return false;
+            }
+            skipSpaces(text, pos);
+            if (pos >= text.size() || text[pos] != ':') {
+                error = "ожидалось ':' после \"" + key + "\"";
+                return false;
+            }
+            ++pos;
+            skipSpaces(text, pos);
+
+            JsonValue value;
+            const size_t start = pos;
+            if (pos < text.size() && text[pos] == '"') {
+                value.type = JsonValue::Type::String;
+                if (!parseString(text, pos, value.string)) {
+                    error = "незакрытая строка в поле \"" + key + "\"";
+                    return false;
+                }
+            } else if (text.compare(pos, 4, "true") == 0) {
+                value.type = JsonValue::Type::Bool;
+                value.boolean = true;
+                pos += 4;
+            } else if (text.compare(pos, 5, "false") == 0) {
+                value.type = JsonValue::Type::Bool;
+                pos += 5;
+            } else if (text.compare(pos, 4, "null") == 0) {
+                pos += 4;
+            } else if (pos < text.size() && text[pos] == '[') {
+                value.type = JsonValue::Type::Array;
+                if (!parseNumberArray(text, pos, value.numbers)) {
+                    error = "поле \"" + key + "\" должно быть массивом чисел";
+                    return false;
+                }
+            } else {
+                if (!parseNumber(text, pos, value.number)) {
+                    error = "неподдерживаемое значение поля \"" + key + "\"";
+                    return false;
+                }
+                value.type = JsonValue::Type::Number;
+            }
+            if (value.type != JsonValue::Type::String) {
+                value.string = text.substr(start, pos - start);
+            }
+            out[key] = std::move(value);
+
+            skipSpaces(text, pos);
+            if (pos < text.size() && text[pos] == ',') {
+                ++pos;
+                continue;
+            }
+            if (pos < text.size() && text[pos] == '}') {
+                ++pos;
+                break;
+            }
+            error = "ожидалось ',' или '}' в позиции " + std::to_string(pos);
+            return false;
+        }
+    }
+    skipSpaces(text, pos);
+    if (pos != text.size()) {
+        error = "лишние символы после объекта";
+        return false;
+    }
+    return true;
+}
+
+// Строка в кавычках с экранированием
+inline std::string jsonString(const std::string &value)
+{
+    std::string out = "\"";
+    for (const char c : value) {
+        switch (c) {
+        case '"':  out += "\\\""; break;
+        case '\\': out += "\\\\"; break;
+        case '\n': out += "\\n"; break;
+        case '\r': out += "\\r"; break;
+        case '\t': out += "\\t"; break;
+        default:
+            if (static_cast<unsigned char>(c) < 0x20) {
+                char buffer[8];
+                std::snprintf(buffer, sizeof(buffer), "\\u%04x", static_cast<unsigned>(c));
+                out += buffer;
+            } else {
+                out += c;
+            }
+        }
+    }
+    out += '"';
+    return out;
+}
+
+// Число без потери точности; NaN и бесконечности — null
+inline std::string jsonNumber(double value)
+{
+    if (!std::isfinite(value)) {
+        return "null";
+    }
+    char buffer[32];
+    std::snprintf(buffer, sizeof(buffer), "%.17g", value);
+    return buffer;
+}
+
+// Массив чисел через jsonNumber()
+inline std::string jsonNumberArray(const std::vector<double> &values)
+{
+    std::string out = "[";
+    for (size_t i = 0; i < values.size(); ++i) {
+        out += (i ? "," : "") + jsonNumber(values[i]);
+    }
+    out += ']';
+    return out;
+}
+
+// Массив строк через jsonString()
+inline std::string jsonStringArray(const std::vector<std::string> &values)
+{
+    std::string out = "[";
+    for (size_t i = 0; i < values.size(); ++i) {
+        out += (i ? "," : "") + jsonString(values[i]);
+    }
+    out += ']';
+    return out;
+}
+
+} // namespace Batch
+
+#endif // BATCH_JSON_HPP_
@@ -0,0 +1,589 @@
+#ifndef BATCH_TASK_HPP_
+#define BATCH_TASK_HPP_
+
+#include <Batch/Json.hpp>
+#include <ConjugateGradient/ConjugateGradient.hpp>
+#include <CoordinateDescent/CoordinateDescent.hpp>
+#include <GradientDescent/GradientDescent.hpp>
+#include <SolverCore/MultiStart.hpp>
+#include <SolverCore/Sampling.hpp>
+#include <SolverCore/ThreadPool.hpp>
+#include <SolverCore/VectorSolver.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Batch {
+
+// Полный тип алгоритма. Значения совпадают с FullAlgoType в Sources/AppEnums.hpp
+enum class FullAlgoType : int {
+    INVALID = 0,
+    CDB     = 1, // Coordinate Descent Basic
+    CDS     = 2, // Coordinate Descent Steepest
+    GDB     = 3, // Gradient Descent Basic
+    GDS     = 4, // Gradient Descent Steepest
+    GDR     = 5, // Gradient Descent Ravine
+    CGB     = 6  // Conjugate Gradient Basic
+};
+
+inline FullAlgoType fullAlgoTypeFromString(const std::string &name)
+{
+    if (name == "CDB") return FullAlgoType::CDB;
+    if (name == "CDS") return FullAlgoType::CDS;
+    if (name == "GDB") return FullAlgoType::GDB;
+    if (name == "GDS") return FullAlgoType::GDS;
+    if (name == "GDR") return FullAlgoType::GDR;
+    if (name == "CGB") return FullAlgoType::CGB;
+    return FullAlgoType::INVALID;
+}
+
+inline const char *fullAlgoTypeToString(FullAlgoType type)
+{
+    switch (type) {
+    case FullAlgoType::CDB: return "CDB";
+    case FullAlgoType::CDS: return "CDS";
+    case FullAlgoType::GDB: return "GDB";
+    case FullAlgoType::GDS: return "GDS";
+    case FullAlgoType::GDR: return "GDR";
+    case FullAlgoType::CGB: return "CGB";
+    default:                return "INVALID";
+    }
+}
+
+/**
+ * Задача пакетного режима. Поля и значения по умолчанию совпадают
+ * с InputData методов; enum-поля задаются именами (StepType::CONSTANT -> "CONSTANT").
+ *
+ *   {"id": 1, "function": "x^2+y^2", "algorithm": "GDS", "extremum": "MINIMUM",
+ *    "x_left_bound": -5, "x_right_bound": 5, "result_precision": 6}
+ *
+ * "start_count" > 0 включает мультистарт (Batch::runMultiStart): задача
+ * функции x и y решается из стольких точек области поиска, и в результат
+ * попадают все найденные локальные экстремумы.
+ *
+ *   {"function": "(x^2+y-11)^2+(x+y^2-7)^2", "algorithm": "GDS", "start_count": 32,
+ *    "start_sampling": "SOBOL", "x_left_bound": -5, "x_right_bound": 5,
+ *    "y_left_bound": -5, "y_right_bound": 5}
+ *
+ * Функция с переменными помимо x и y, или задача с любым из массивов
+ * "initial", "lower_bounds", "upper_bounds", решается SC::VectorSolver.
+ * Массивы идут в порядке переменных (по алфавиту, x2 < x10); границы
+ * по умолчанию — x_left_bound и x_right_bound.
+ *
+ *   {"function": "(x1-1)^2+(x2+2)^2+x3^2", "algorithm": "CGB", "initial": [0, 0, 1]}
+ */
+struct Task {
+    std::string id;                   // Поле "id" как JSON-текст (пусто — не задано)
+    FullAlgoType algorithm = FullAlgoType::INVALID;
+    std::string function;
+    bool maximize = false;            // "extremum": "MINIMUM" | "MAXIMUM"
+    int step_type = 0;                // "step": "CONSTANT" | "COEFFICIENT" | "ADAPTIVE"
+    double step_size = 0.1;           // GD: постоянный или коэффициентный шаг
+    double step_x = 0.1;              // CD: шаг по X
+    double step_y = 0.1;              // CD: шаг по Y
+    double initial_x = 0.0;
+    double initial_y = 0.0;
+    double x_left_bound = -1000.0;
+    double x_right_bound = 1000.0;
+    double y_left_bound = -1000.0;
+    double y_right_bound = 1000.0;
+    int result_precision = 8;
+    int computation_precision = 15;
+    int max_iterations = 1000;
+    int max_function_calls = 10000;
+    int evaluator_type = 0;           // "evaluator": "MUPARSER" | "TAPE" | "NATIVE"
+    int line_search_type = 0;         // "line_search": "SEQUENTIAL" | "BATCHED" | "GOLDEN" | "WOLFE"
+    std::vector<double> initial;      // Начальная точка по всем переменным (пусто — не задана)
+    std::vector<double> lower_bounds;
+    std::vector<double> upper_bounds;
+    int start_count = 0;              // Число начальных точек мультистарта (0 — один запуск из initial_x, initial_y)
+    int start_sampling = 0;           // "start_sampling": "LATIN_HYPERCUBE" | "SOBOL"
+    int start_seed = 0;               // Зерно латинского гиперкуба
+    double merge_radius = 1e-3;       // Точки ближе — один локальный экстремум
+};
+
+namespace detail {
+
+inline bool readNumber(const JsonObject &object, const char *key, double &out, std::string &error)
+{
+    auto it = object.find(key);
+    if (it == object.end()) {
+        return true;
+    }
+    if (it->second.type != JsonValue::Type::Number) {
+        error = std::string("поле \"") + key + "\" должно быть числом";
+        return false;
+    }
+    out = it->second.number;
+    return true;
+}
+
+inline bool readInt(const JsonObject &object, const char *key, int &out, std::string &error)
+{
+    double value = out;
+    if (!readNumber(object, key, value, error)) {
+        return false;
+    }
+    out = static_cast<int>(value);
+    return true;
+}
+
+inline bool readNumbers(const JsonObject &object, const char *key, std::vector<double> &out, std::string &error)
+{
+    auto it = object.find(key);
+    if (it == object.end()) {
+        return true;
+    }
+    if (it->second.type != JsonValue::Type::Array) {
+        error = std::string("поле \"") + key + "\" должно быть массивом чисел";
+        return false;
+    }
+    out = it->second.numbers;
+    return true;
+}
+
+// Имя из names -> его индекс
+template <size_t N>
+inline bool readEnum(const JsonObject &object, const char *key, const char *const (&names)[N], int &out,
+                     std::string &error)
+{
+    auto it = object.find(key);
+    if (it == object.end()) {
+        return true;
+    }
+    for (size_t i = 0; i < N; ++i) {
+        if (it->second.type == JsonValue::Type::String && it->second.string == names[i]) {
+            out = static_cast<int>(i);
+            return true;
+        }
+    }
+    error = std::string("неизвестное значение поля \"") + key + "\"";
+    return false;
+}
+
+} // namespace detail
+
+inline bool parseTask(const std::string &line, Task &task, std::string &error)
+{
+    using namespace detail;
+    JsonObject object;
+    if (!parseJsonObject(line, object, error)) {
+        return false;
+    }
+    task = Task{};
+
+    auto id = object.find("id");
+    if (id != object.end()) {
+        task.id = (id->second.type == JsonValue::Type::String) ? jsonString(id->second.string) : id->second.string;
+    }
+
+    auto function = object.find("function");
+    if (function == object.end() || function->second.type != JsonValue::Type::String) {
+        error = "не задано поле \"function\"";
+        return false;
+    }
+    task.function = function->second.string;
+
+    auto algorithm = object.find("algorithm");
+    if (algorithm == object.end() || algorithm->second.type != JsonValue::Type::String ||
+        (task.algorithm = fullAlgoTypeFromString(algorithm->second.string)) == FullAlgoType::INVALID) {
+        error = "поле \"algorithm\" должно быть одним из CDB, CDS, GDB, GDS, GDR, CGB";
+        return false;
+    }
+
+    static const char *const extremums[] = { "MINIMUM", "MAXIMUM" };
+    static const char *const steps[] = { "CONSTANT", "COEFFICIENT", "ADAPTIVE" };
+    static const char *const evaluators[] = { "MUPARSER", "TAPE", "NATIVE" };
+    static const char *const lineSearches[] = { "SEQUENTIAL", "BATCHED", "GOLDEN", "WOLFE" };
+    static const char *const samplings[] = { "LATIN_HYPERCUBE", "SOBOL" };
+    int extremum = 0;
+    if (!readEnum(object, "extremum", extremums, extremum, error)) {
+        return false;
+    }
+    task.maximize = (extremum == 1);
+
+    return readEnum(object, "step", steps, task.step_type, error) &&
+           readEnum(object, "evaluator", evaluators, task.evaluator_type, error) &&
+           readEnum(object, "line_search", lineSearches, task.line_search_type, error) &&
+           readEnum(object, "start_sampling", samplings, task.start_sampling, error) &&
+           readNumber(object, "step_size", task.step_size, error) &&
+           readNumber(object, "step_x", task.step_x, error) &&
+           readNumber(object, "step_y", task.step_y, error) &&
+           readNumber(object, "initial_x", task.initial_x, error) &&
+           readNumber(object, "initial_y", task.initial_y, error) &&
+           readNumber(object, "x_left_bound", task.x_left_bound, error) &&
+           readNumber(object, "x_right_bound", task.x_right_bound, error) &&
+           readNumber(object, "y_left_bound", task.y_left_bound, error) &&
+           readNumber(object, "y_right_bound", task.y_right_bound, error) &&
+           readInt(object, "result_precision", task.result_precision, error) &&
+           readInt(object, "computation_precision", task.computation_precision, error) &&
+           readInt(object, "max_iterations", task.max_iterations, error) &&
+           readInt(object, "max_function_calls", task.max_function_calls, error) &&
+           readNumbers(object, "initial", task.initial, error) &&
+           readNumbers(object, "lower_bounds", task.lower_bounds, error) &&
+           readNumbers(object, "upper_bounds", task.upper_bounds, error) &&
+           readInt(object, "start_count", task.start_count, error) &&
+           readInt(object, "start_seed", task.start_seed, error) &&
+           readNumber(object, "merge_radius", task.merge_radius, error);
+}
+
+namespace detail {
+
+// Общие поля всех методов
+template <typename Data>
+inline void fillCommon(const Task &task, Data &data)
+{
+    data.function = task.function;
+    data.extremum_type = task.maximize ? decltype(data.extremum_type)::MAXIMUM
+                                       : decltype(data.extremum_type)::MINIMUM;
+    data.initial_x = task.initial_x;
+    data.initial_y = task.initial_y;
+    data.x_left_bound = task.x_left_bound;
+    data.x_right_bound = task.x_right_bound;
+    data.y_left_bound = task.y_left_bound;
+    data.y_right_bound = task.y_right_bound;
+    data.result_precision = task.result_precision;
+    data.computation_precision = task.computation_precision;
+    data.max_iterations = task.max_iterations;
+    data.max_function_calls = task.max_function_calls;
+    data.evaluator_type = static_cast<decltype(data.evaluator_type)>(task.evaluator_type);
+    data.line_search_type = static_cast<decltype(data.line_search_type)>(task.line_search_type);
+}
+
+inline void fillCDData(const Task &task, CD::InputData &data)
+{
+    data = CD::InputData{};
+    fillCommon(task, data);
+    data.algorithm_type = (task.algorithm == FullAlgoType::CDB)
+        ? CD::AlgorithmType::BASIC_COORDINATE_DESCENT
+        : CD::AlgorithmType::STEEPEST_COORDINATE_DESCENT;
+    data.step_type = static_cast<CD::StepType>(task.step_type);
+    data.step_type_x = data.step_type;
+    data.step_type_y = data.step_type;
+    if (data.step_type == CD::StepType::COEFFICIENT) {
+        data.coefficient_step_size_x = task.step_x;
+        data.coefficient_step_size_y = task.step_y;
+    } else {
+        data.constant_step_size_x = task.step_x;
+        data.constant_step_size_y = task.step_y;
+    }
+}
+
+inline void fillGDData(const Task &task, GD::InputData &data)
+{
+    data = GD::InputData{};
+    fillCommon(task, data);
+    data.algorithm_type = (task.algorithm == FullAlgoType::GDB) ? GD::AlgorithmType::GRADIENT_DESCENT
+                        : (task.algorithm == FullAlgoType::GDS) ? GD::AlgorithmType::STEEPEST_DESCENT
+                                                                : GD::AlgorithmType::RAVINE_METHOD;
+    data.step_type = static_cast<GD::StepType>(task.step_type);
+    data.constant_step_size = task.step_size;
+    data.coefficient_step_size = task.step_size;
+}
+
+inline void fillCGData(const Task &task, CG::InputData &data)
+{
+    data = CG::InputData{};
+    fillCommon(task, data);
+    data.algorithm_type = CG::AlgorithmType::CONJUGATE_GRADIENT;
+}
+
+// Массивы по переменным или переменные помимо x и y. Функция, которую
+// SC::Expression не разбирает, остаётся двумерным методам (и muParser)
+inline bool isVectorTask(const Task &task)
+{
+    if (!task.initial.empty() || !task.lower_bounds.empty() || !task.upper_bounds.empty()) {
+        return true;
+    }
+    SC::Expression expression;
+    if (!expression.parseVector(task.function)) {
+        return false;
+    }
+    for (const std::string &name : expression.variables()) {
+        if (name != "x" && name != "y") {
+            return true;
+        }
+    }
+    return false;
+}
+
+inline void fillVectorData(const Task &task, SC::VectorInputData &data)
+{
+    data = SC::VectorInputData{};
+    data.function = task.function;
+    data.method = static_cast<SC::VectorMethod>(task.algorithm);
+    data.maximize = task.maximize;
+    data.step_type = static_cast<SC::StepRule>(task.step_type);
+    const bool coordinate = (task.algorithm == FullAlgoType::CDB || task.algorithm == FullAlgoType::CDS);
+    data.step_size = coordinate ? task.step_x : task.step_size;
+    data.line_search = static_cast<SC::LineSearchMethod>(task.line_search_type);
+    data.initial = task.initial;
+    data.default_bounds = { task.x_left_bound, task.x_right_bound };
+    // Недостающая граница берётся по умолчанию; несовпадение длин
+    // массивов с числом переменных отвергает setInputData()
+    const size_t count = std::max(task.lower_bounds.size(), task.upper_bounds.size());
+    for (size_t i = 0; i < count; ++i) {
+        SC::Bounds bounds = data.default_bounds;
+        if (!task.lower_bounds.empty()) {
+            bounds.lower = (i < task.lower_bounds.size()) ? task.lower_bounds[i] : bounds.upper;
+        }
+        if (!task.upper_bounds.empty()) {
+            bounds.upper = (i < task.upper_bounds.size()) ? task.upper_bounds[i] : bounds.lower;
+        }
+        data.bounds.push_back(bounds);
+    }
+    data.result_precision = task.result_precision;
+    data.computation_precision = task.computation_precision;
+    data.max_iterations = task.max_iterations;
+    data.max_function_calls = task.max_function_calls;
+}
+
+} // namespace detail
+
+// Итог решения задачи
+struct TaskResult {
+    int status = 0;          // Result метода (0 — успех)
+    std::string message;     // resultToString(status)
+    bool found = false;      // Метод сообщил точку экстремума
+    double x = 0.0;
+    double y = 0.0;
+    double value = 0.0;
+    std::vector<std::string> variables; // Только для SC::VectorSolver: имена переменных
+    std::vector<double> point;          // и точка экстремума по ним
+    int starts = 0;                         // Только для мультистарта: число запусков
+    std::vector<SC::LocalOptimum> optima;   // и все локальные экстремумы, лучший — первым
+    int iterations = 0;      // У мультистарта — суммы по запускам
+    int function_calls = 0;
+    double seconds = 0.0;    // Время setInputData() + solve()
+    SC::SolveStats stats;    // Замеры по фазам solve()
+};
+
+/**
+ * Решает задачи одну за другой. Экземпляры методов (и их парсеры)
+ * переиспользуются между задачами, поэтому в многопоточном режиме нужен
+ * один TaskRunner на поток. Задачи многих переменных идут в SC::VectorSolver.
+ *
+ * Recorder — система отчётности методов; она должна, как SC::ResultRecorder,
+ * давать hasResult(), point() и value(). TaskRunner — вариант без отчётности.
+ */
+template <typename Recorder>
+class BasicTaskRunner {
+public:
+
+    BasicTaskRunner() :
+        m_reporter{},
+        m_cdAlgo{ &m_reporter },
+        m_gdAlgo{ &m_reporter },
+        m_cgAlgo{ &m_reporter },
+        m_vectorAlgo{},
+        m_vectorData{}
+    {
+    }
+
+    BasicTaskRunner(const BasicTaskRunner &) = delete;
+    BasicTaskRunner &operator=(const BasicTaskRunner &) = delete;
+
+    // События фаз всех методов (nullptr — не записывать)
+    void setTrace(SC::Trace *trace)
+    {
+        m_cdAlgo.setTrace(trace);
+        m_gdAlgo.setTrace(trace);
+        m_cgAlgo.setTrace(trace);
+        m_vectorAlgo.setTrace(trace);
+    }
+
+    // Запоминание значений в точках решения у всех методов (SC::ValueMemo)
+    void setValueMemo(bool enabled)
+    {
+        m_cdAlgo.setValueMemo(enabled);
+        m_gdAlgo.setValueMemo(enabled);
+        m_cgAlgo.setValueMemo(enabled);
+    }
+
+    TaskResult run(const Task &task)
+    {
+        if (task.algorithm != FullAlgoType::INVALID && detail::isVectorTask(task)) {
+            detail::fillVectorData(task, m_vectorData);
+            return solveVector();
+        }
+        switch (task.algorithm) {
+        case FullAlgoType::CDB:
+        case FullAlgoType::CDS:
+            detail::fillCDData(task, m_cdData);
+            return solve(m_cdAlgo, m_cdData);
+        case FullAlgoType::GDB:
+        case FullAlgoType::GDS:
+        case FullAlgoType::GDR:
+            detail::fillGDData(task, m_gdData);
+            return solve(m_gdAlgo, m_gdData);
+        case FullAlgoType::CGB:
+            detail::fillCGData(task, m_cgData);
+            return solve(m_cgAlgo, m_cgData);
+        default: {
+            TaskResult result;
+            result.status = -1;
+            result.message = "Алгоритм не поддерживается";
+            return result;
+        }
+        }
+    }
+
+private:
+
+    Recorder m_reporter;
+    CD::CoordinateDescent<Recorder> m_cdAlgo;
+    CD::InputData m_cdData;
+    GD::GradientDescent<Recorder> m_gdAlgo;
+    GD::InputData m_gdData;
+    CG::ConjugateGradient<Recorder> m_cgAlgo;
+    CG::InputData m_cgData;
+    SC::VectorSolver m_vectorAlgo;
+    SC::VectorInputData m_vectorData;
+
+    TaskResult solveVector()
+    {
+        TaskResult result;
+        const auto start = std::chrono::steady_clock::now();
+        auto rv = m_vectorAlgo.setInputData(&m_vectorData);
+        if (rv == SC::VectorResult::Success) {
+            rv = m_vectorAlgo.solve();
+            result.iterations = m_vectorAlgo.getIterations();
+            result.function_calls = m_vectorAlgo.getFunctionCalls();
+            result.stats = m_vectorAlgo.getStats();
+            result.found = (rv != SC::VectorResult::ComputeError && rv != SC::VectorResult::Cancelled);
+            if (result.found) {
+                result.variables = m_vectorAlgo.variables();
+                result.point = m_vectorAlgo.getPoint();
+                result.value = m_vectorAlgo.getOptimumValue();
+            }
+        }
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        result.seconds = elapsed.count();
+        result.status = static_cast<int>(rv);
+        result.message = SC::resultToString(rv);
+        return result;
+    }
+
+    template <typename Method, typename Data>
+    TaskResult solve(Method &method, const Data &data)
+    {
+        TaskResult result;
+        const auto start = std::chrono::steady_clock::now();
+        auto rv = method.setInputData(&data);
+        if (rv == decltype(rv)::Success) {
+            rv = method.solve();
+            result.iterations = method.getIterations();
+            result.function_calls = method.getFunctionCalls();
+            result.stats = method.getStats();
+            result.found = m_reporter.hasResult();
+            if (result.found) {
+                result.x = m_reporter.point().x;
+                result.y = m_reporter.point().y;
+                result.value = m_reporter.value();
+            }
+        }
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        result.seconds = elapsed.count();
+        result.status = static_cast<int>(rv);
+        result.message = resultToString(rv);
+        return result;
+    }
+};
+
+using TaskRunner = BasicTaskRunner<SC::ResultRecorder>;
+
+namespace detail {
+
+template <template <typename> class Method, typename Data>
+TaskResult multiStartResult(const Data &data, const std::vector<SC::Point> &starts, double mergeRadius,
+                            SC::ThreadPool &pool)
+{
+    TaskResult result;
+    const auto start = std::chrono::steady_clock::now();
+    const auto runs = SC::multiStart<Method>(data, starts, mergeRadius, pool);
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    auto status = runs.runs.front().status;
+    for (const auto &run : runs.runs) {
+        result.iterations += run.iterations;
+        result.function_calls += run.functionCalls;
+        if (run.status != decltype(status)::Success) {
+            status = run.status; // Без найденных экстремумов сообщается последняя ошибка
+        }
+    }
+    result.starts = static_cast<int>(starts.size());
+    result.optima = runs.optima;
+    result.found = runs.found();
+    if (result.found) {
+        status = decltype(status)::Success;
+        result.x = runs.best().point.x;
+        result.y = runs.best().point.y;
+        result.value = runs.best().value;
+    }
+    result.seconds = elapsed.count();
+    result.status = static_cast<int>(status);
+    result.message = resultToString(status);
+    return result;
+}
+
+} // namespace detail
+
+/**
+ * Мультистарт задачи (task.start_count > 0): метод запускается из
+ * task.start_count точек области поиска (латинский гиперкуб или Соболь)
+ * на потоках pool через SC::multiStart. x, y и value — лучший экстремум,
+ * optima — все различные; статус — Success, если найден хоть один.
+ * Нельзя вызывать из задачи пула pool.
+ */
+inline TaskResult runMultiStart(const Task &task, SC::ThreadPool &pool)
+{
+    if (task.start_count <= 0) {
+        TaskResult result;
+        result.status = -1;
+        result.message = "Мультистарт — только для задач с start_count > 0";
+        return result;
+    }
+    if (detail::isVectorTask(task)) {
+        TaskResult result;
+        result.status = -1;
+        result.message = "Мультистарт — только для функций x и y";
+        return result;
+    }
+    const SC::Box box{ task.x_left_bound, task.x_right_bound, task.y_left_bound, task.y_right_bound };
+    const auto starts = SC::samplePoints(static_cast<SC::StartSampling>(task.start_sampling),
+                                         static_cast<size_t>(task.start_count), box,
+                                         static_cast<uint64_t>(task.start_seed));
+    switch (task.algorithm) {
+    case FullAlgoType::CDB:
+    case FullAlgoType::CDS: {
+        CD::InputData data;
+        detail::fillCDData(task, data);
+        return detail::multiStartResult<CD::CoordinateDescent>(data, starts, task.merge_radius, pool);
+    }
+    case FullAlgoType::GDB:
+    case FullAlgoType::GDS:
+    case FullAlgoType::GDR: {
+        GD::InputData data;
+        detail::fillGDData(task, data);
+        return detail::multiStartResult<GD::GradientDescent>(data, starts, task.merge_radius, pool);
+    }
+    case FullAlgoType::CGB: {
+        CG::InputData data;
+        detail::fillCGData(task, data);
+        return detail::multiStartResult<CG::ConjugateGradient>(data, starts, task.merge_radius, pool);
+    }
+    default: {
+        TaskResult result;
+        result.status = -1;
+        result.message = "Алгоритм не поддерживается";
+        return result;
+    }
+    }
+}
+
+} // namespace Batch
+
+#endif // BATCH_TASK_HPP_
@@ -0,0 +1,711 @@
+//
+// optdemo-bench — набор замеров для отслеживания регрессий производительности.
+//
+// Запускает каждый FullAlgoType (CDB, CDS, GDB, GDS, GDR, CGB) с каждым
+// поддерживаемым им типом шага на классических тестовых функциях и пишет
+// результаты в JSON: время, итерации, вызовы функции, ошибку результата
+// и пиковую память. Задачи выполняются по очереди в одном потоке,
+// чтобы время не зависело от соседних запусков.
+//
+//   optdemo-bench [-r N] [-o файл] [--evaluator MUPARSER|TAPE|NATIVE]
+//                 [--line-search SEQUENTIAL|BATCHED|GOLDEN|WOLFE] [--reporter NULL|TABLES]
+//                 [--baseline SEQUENTIAL|BATCHED|GOLDEN|WOLFE|NONE]
+//                 [--trace файл] [--filter ПОДСТРОКА]
+//                 [--multistart N [--threads M]] [--check-memo]
+//
+//   -r N        повторов каждого запуска для замера времени (по умолчанию 5)
+//   -o          файл для JSON (по умолчанию stdout)
+//   --reporter  NULL — без отчётности (как optdemo-batch), TABLES — методы
+//               строят таблицы и сообщения в памяти, как для ReportWriter;
+//               разница показывает стоимость отчётности
+//   --baseline  способ поиска шага для сравнения (по умолчанию GOLDEN):
+//               каждый вариант дополнительно запускается с ним столько же
+//               раз; "baseline_function_calls" и "baseline_time_ms_median"
+//               запуска и "summary" — вызовы функции и сумма медианных
+//               времён по FullAlgoType в обоих режимах, их сокращение и
+//               ускорение
+//   --trace     файл для событий фаз в формате Chrome trace (chrome://tracing,
+//               Perfetto), по дорожке на запуск; память под события входит
+//               в peak_heap_bytes
+//   --multistart  вместо обычных запусков — мультистарт (Batch::runMultiStart)
+//               из N точек Соболя на пулах из 1, 2, 4, ... потоков до M (по
+//               умолчанию — число ядер): "runs" — медианное время по числу
+//               потоков, ускорение относительно одного потока и число
+//               найденных локальных экстремумов
+//   --check-memo  вместо замеров — проверка SC::ValueMemo: каждый вариант
+//               решается с запоминанием значений и градиентов в точках и без
+//               него; точка и значение должны совпасть с точностью результата
+//               задачи (10^-result_precision). Код возврата 2, если нет
+//
+
+// Поле "phases" запуска — замеры по фазам последнего повтора (SC::SolveStats);
+// без них, если проект собран с SOLVERCORE_INSTRUMENT=OFF.
+//
+#include <Batch/Json.hpp>
+#include <Batch/Task.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <new>
+#include <streambuf>
+#include <string>
+#include <thread>
+#include <variant>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
+
+// ============================================================================
+// Учёт кучи: текущий и пиковый объём, выделенный через operator new
+// ============================================================================
+
+namespace {
+
+std::atomic<size_t> g_heapCurrent{ 0 };
+std::atomic<size_t> g_heapPeak{ 0 };
+
+// Заголовок перед каждым блоком хранит его размер (с выравниванием max_align_t)
+constexpr size_t kHeader = alignof(std::max_align_t);
+
+void *trackedAlloc(size_t size)
+{
+    void *raw = std::malloc(size + kHeader);
+    if (!raw) {
+        throw std::bad_alloc();
+    }
+    *static_cast<size_t *>(raw) = size;
+    const size_t current = g_heapCurrent.fetch_add(size, std::memory_order_relaxed) + size;
+    size_t peak = g_heapPeak.load(std::memory_order_relaxed);
+    while (current > peak && !g_heapPeak.compare_exchange_weak(peak, current, std::memory_order_relaxed)) {
+    }
+    return static_cast<char *>(raw) + kHeader;
+}
+
+void trackedFree(void *ptr) noexcept
+{
+    if (!ptr) {
+        return;
+    }
+    void *raw = static_cast<char *>(ptr) - kHeader;
+    g_heapCurrent.fetch_sub(*static_cast<size_t *>(raw), std::memory_order_relaxed);
+    std::free(raw);
+}
+
+} // namespace
+
+void *operator new(size_t size) { return trackedAlloc(size); }
+void *operator new[](size_t size) { return trackedAlloc(size); }
+void operator delete(void *ptr) noexcept { trackedFree(ptr); }
+void operator delete[](void *ptr) noexcept { trackedFree(ptr); }
+void operator delete(void *ptr, size_t) noexcept { trackedFree(ptr); }
+void operator delete[](void *ptr, size_t) noexcept { trackedFree(ptr); }
+
+namespace {
+
+// Пиковый размер резидентной памяти процесса (КБ), -1 — недоступно
+long peakRssKb()
+{
+#if defined(__unix__) || defined(__APPLE__)
+    rusage usage{};
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+        return -1;
+    }
+#if defined(__APPLE__)
+    return usage.ru_maxrss / 1024; // На macOS — байты
+#else
+    return usage.ru_maxrss;
+#endif
+#else
+    return -1;
+#endif
+}
+
+// ============================================================================
+// Тестовые функции
+// ============================================================================
+
+struct TestFunction {
+    const char *name;
+    const char *expression;
+    double bound;                       // Область [-bound, bound]^2
+    double start_x, start_y;            // Начальное приближение
+    double step;                        // Шаг для постоянного/коэффициентного режима
+    double optimum;                     // Значение в глобальном минимуме
+    std::vector<SC::Point> minimizers;  // Все точки глобального минимума
+};
+
+const std::vector<TestFunction> &testFunctions()
+{
+    static const std::vector<TestFunction> functions = {
+        { "rosenbrock", "(1-x)^2 + 100*(y-x^2)^2", 5.0, -1.2, 1.0, 0.001, 0.0, { { 1.0, 1.0 } } },
+        { "himmelblau", "(x^2+y-11)^2 + (x+y^2-7)^2", 5.0, 0.0, 0.0, 0.01, 0.0,
+          { { 3.0, 2.0 }, { -2.805118, 3.131312 }, { -3.779310, -3.283186 }, { 3.584428, -1.848126 } } },
+        { "beale", "(1.5-x+x*y)^2 + (2.25-x+x*y^2)^2 + (2.625-x+x*y^3)^2", 4.5, 1.0, 1.0, 0.01, 0.0,
+          { { 3.0, 0.5 } } },
+        { "booth", "(x+2*y-7)^2 + (2*x+y-5)^2", 10.0, 0.0, 0.0, 0.05, 0.0, { { 1.0, 3.0 } } },
+        { "matyas", "0.26*(x^2+y^2) - 0.48*x*y", 10.0, 5.0, -3.0, 0.1, 0.0, { { 0.0, 0.0 } } },
+        { "rastrigin", "20 + x^2 - 10*cos(2*_pi*x) + y^2 - 10*cos(2*_pi*y)", 5.12, 0.4, -0.3, 0.001, 0.0,
+          { { 0.0, 0.0 } } },
+        { "quadratic_k1e2", "x^2 + 100*y^2", 10.0, 3.0, 2.0, 0.005, 0.0, { { 0.0, 0.0 } } },
+        { "quadratic_k1e4", "x^2 + 10000*y^2", 10.0, 3.0, 2.0, 0.00005, 0.0, { { 0.0, 0.0 } } },
+        { "quadratic_rotated", "(x+y)^2 + 1000*(x-y)^2", 10.0, 3.0, -2.0, 0.0005, 0.0, { { 0.0, 0.0 } } }
+    };
+    return functions;
+}
+
+// ============================================================================
+// Отчётность
+// ============================================================================
+
+// Включённая отчётность: собирает таблицы и сообщения в памяти, не записывая
+// их в файл, — так в замер попадает построение строк, но не ввод-вывод.
+class TableRecorder : public SC::ResultRecorder {
+public:
+
+    using Cell = std::variant<std::string, double, long long, bool>;
+
+    static constexpr bool enabled = true;
+
+    int begin()
+    {
+        m_messages.clear();
+        m_cells.clear();
+        m_tables = 0;
+        return SC::ResultRecorder::begin();
+    }
+
+    void insertValue(const std::string &name, double) { m_messages.push_back(name); }
+    void insertMessage(const std::string &text) { m_messages.push_back(text); }
+    int beginTable(const std::string &, const std::vector<std::string> &) { return ++m_tables; }
+    int insertRow(int, const std::vector<Cell> &row)
+    {
+        m_cells.insert(m_cells.end(), row.begin(), row.end());
+        return 0;
+    }
+    void endTable(int) {}
+    void insertStats(const SC::SolveStats &) {}
+
+private:
+
+    std::vector<std::string> m_messages;
+    std::vector<Cell> m_cells;
+    int m_tables = 0;
+};
+
+// ============================================================================
+// Запуски
+// ============================================================================
+
+struct Variant {
+    Batch::FullAlgoType algorithm;
+    int step_type; // -1 — метод не использует тип шага
+};
+
+const char *stepTypeToString(int stepType)
+{
+    switch (stepType) {
+    case 0:  return "CONSTANT";
+    case 1:  return "COEFFICIENT";
+    case 2:  return "ADAPTIVE";
+    default: return nullptr;
+    }
+}
+
+std::vector<Variant> variants()
+{
+    using Batch::FullAlgoType;
+    std::vector<Variant> out;
+    for (FullAlgoType algorithm : { FullAlgoType::CDB, FullAlgoType::CDS, FullAlgoType::GDB }) {
+        for (int step = 0; step < 3; ++step) {
+            out.push_back({ algorithm, step });
+        }
+    }
+    for (FullAlgoType algorithm : { FullAlgoType::GDS, FullAlgoType::GDR, FullAlgoType::CGB }) {
+        out.push_back({ algorithm, -1 });
+    }
+    return out;
+}
+
+struct Options {
+    int repeats = 5;
+    const char *output = nullptr;
+    int evaluator_type = 0;
+    int line_search_type = 0;
+    int baseline = 2; // Способ поиска шага для сравнения; 4 — NONE
+    int reporter = 0; // 0 — NULL, 1 — TABLES
+    const char *trace = nullptr;
+    std::string filter;
+    int multistart = 0; // Число начальных точек мультистарта; 0 — обычные запуски
+    unsigned threads = 0; // Наибольшее число потоков мультистарта; 0 — число ядер
+    bool checkMemo = false; // Проверка SC::ValueMemo вместо замеров
+};
+
+// {"function":{"count":..,"seconds":..},...,"lineSearchEvaluations":..,"memoHits":..,"totalSeconds":..}
+std::string statsJson(const SC::SolveStats &stats)
+{
+    using Batch::jsonNumber;
+    std::string out = "{";
+    for (int i = 0; i < SC::kPhaseCount; ++i) {
+        out += "\"" + std::string(SC::phaseToString(static_cast<SC::Phase>(i))) + "\":{\"count\":" +
+               std::to_string(stats.phases[i].count) + ",\"seconds\":" + jsonNumber(stats.phases[i].seconds) + "},";
+    }
+    out += "\"lineSearchEvaluations\":" + std::to_string(stats.lineSearchEvaluations);
+    out += ",\"memoHits\":" + std::to_string(stats.memoHits);
+    out += ",\"totalSeconds\":" + jsonNumber(stats.totalSeconds) + "}";
+    return out;
+}
+
+// Расстояние от (x, y) до ближайшей точки минимума
+double pointError(const TestFunction &function, double x, double y)
+{
+    double error = std::numeric_limits<double>::infinity();
+    for (const auto &p : function.minimizers) {
+        error = std::min(error, std::hypot(x - p.x, y - p.y));
+    }
+    return error;
+}
+
+// Суммарные вызовы функции и медианные времена одного FullAlgoType: в замеряемом режиме и в базовом
+struct CallTotals {
+    Batch::FullAlgoType algorithm;
+    long long calls = 0;
+    long long baseline = 0;
+    double time_ms = 0.0;
+    double baseline_time_ms = 0.0;
+};
+
+// Выполняет задачу repeats раз; возвращает медианное время (мс), в times — все замеры
+template <typename Runner>
+double timeRuns(Runner &runner, const Batch::Task &task, int repeats, Batch::TaskResult &result,
+                std::vector<double> &times)
+{
+    times.clear();
+    for (int i = 0; i < repeats; ++i) {
+        const auto start = std::chrono::steady_clock::now();
+        result = runner.run(task);
+        const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+        times.push_back(elapsed.count());
+    }
+    std::sort(times.begin(), times.end());
+    return times[times.size() / 2];
+}
+
+bool hasBaseline(const Options &options)
+{
+    return options.baseline != 4;
+}
+
+Batch::Task makeTask(const TestFunction &function, const Variant &variant, const Options &options)
+{
+    Batch::Task task;
+    task.algorithm = variant.algorithm;
+    task.function = function.expression;
+    task.step_type = std::max(variant.step_type, 0);
+    task.step_size = function.step;
+    task.step_x = function.step;
+    task.step_y = function.step;
+    task.initial_x = function.start_x;
+    task.initial_y = function.start_y;
+    task.x_left_bound = -function.bound;
+    task.x_right_bound = function.bound;
+    task.y_left_bound = -function.bound;
+    task.y_right_bound = function.bound;
+    task.result_precision = 8;
+    task.computation_precision = 15;
+    task.max_iterations = 10000;
+    task.max_function_calls = 100000;
+    task.evaluator_type = options.evaluator_type;
+    task.line_search_type = options.line_search_type;
+    return task;
+}
+
+template <typename Runner>
+std::string runVariant(Runner &runner, const TestFunction &function, const Variant &variant,
+                       const Options &options, SC::Trace *trace, CallTotals &totals)
+{
+    const Batch::Task task = makeTask(function, variant, options);
+    std::vector<double> times;
+    Batch::TaskResult result;
+    g_heapPeak.store(g_heapCurrent.load());
+    const size_t heapBefore = g_heapCurrent.load();
+    const double median = timeRuns(runner, task, options.repeats, result, times);
+    const size_t heapPeak = g_heapPeak.load() - heapBefore;
+    totals.calls += result.function_calls;
+    totals.time_ms += median;
+
+    // Базовый режим: столько же повторов, без трассы
+    int baselineCalls = 0;
+    double baselineMedian = 0.0;
+    if (hasBaseline(options)) {
+        Batch::Task baselineTask = task;
+        baselineTask.line_search_type = options.baseline;
+        Batch::TaskResult baselineResult;
+        std::vector<double> baselineTimes;
+        runner.setTrace(nullptr);
+        baselineMedian = timeRuns(runner, baselineTask, options.repeats, baselineResult, baselineTimes);
+        runner.setTrace(trace);
+        baselineCalls = baselineResult.function_calls;
+        totals.baseline += baselineCalls;
+        totals.baseline_time_ms += baselineMedian;
+    }
+
+    using Batch::jsonNumber;
+    using Batch::jsonString;
+    std::string out = "{";
+    out += "\"function\":" + jsonString(function.name);
+    out += ",\"algorithm\":" + jsonString(Batch::fullAlgoTypeToString(variant.algorithm));
+    const char *step = stepTypeToString(variant.step_type);
+    out += ",\"step\":" + (step ? jsonString(step) : std::string("null"));
+    out += ",\"status\":" + std::to_string(result.status);
+    out += ",\"message\":" + jsonString(result.message);
+    out += ",\"time_ms_min\":" + jsonNumber(times.front());
+    out += ",\"time_ms_median\":" + jsonNumber(median);
+    out += ",\"iterations\":" + std::to_string(result.iterations);
+    out += ",\"function_calls\":" + std::to_string(result.function_calls);
+    if (hasBaseline(options)) {
+        out += ",\"baseline_function_calls\":" + std::to_string(baselineCalls);
+        out += ",\"baseline_time_ms_median\":" + jsonNumber(baselineMedian);
+    }
+    if (result.found) {
+        out += ",\"x\":" + jsonNumber(result.x);
+        out += ",\"y\":" + jsonNumber(result.y);
+        out += ",\"f\":" + jsonNumber(result.value);
+        out += ",\"error_x\":" + jsonNumber(pointError(function, result.x, result.y));
+        out += ",\"error_f\":" + jsonNumber(std::abs(result.value - function.optimum));
+    } else {
+        out += ",\"x\":null,\"y\":null,\"f\":null,\"error_x\":null,\"error_f\":null";
+    }
+    if (result.stats.enabled) {
+        out += ",\"phases\":" + statsJson(result.stats);
+    }
+    out += ",\"peak_heap_bytes\":" + std::to_string(heapPeak);
+    out += ",\"peak_rss_kb\":" + std::to_string(peakRssKb());
+    out += "}";
+    return out;
+}
+
+// Поглощает отладочный вывод методов
+class NullBuffer : public std::streambuf {
+protected:
+    int overflow(int c) override { return traits_type::not_eof(c); }
+    std::streamsize xsputn(const char *, std::streamsize n) override { return n; }
+};
+
+template <size_t N>
+bool parseName(const char *value, const char *const (&names)[N], int &out)
+{
+    for (size_t i = 0; i < N; ++i) {
+        if (std::strcmp(value, names[i]) == 0) {
+            out = static_cast<int>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+void printUsage()
+{
+    std::fprintf(stderr, "usage: optdemo-bench [-r N] [-o file] [--evaluator MUPARSER|TAPE|NATIVE]\n"
+                         "                     [--line-search SEQUENTIAL|BATCHED|GOLDEN|WOLFE] [--reporter NULL|TABLES]\n"
+                         "                     [--baseline SEQUENTIAL|BATCHED|GOLDEN|WOLFE|NONE]\n"
+                         "                     [--trace file] [--filter TEXT]\n"
+                         "                     [--multistart N [--threads M]] [--check-memo]\n");
+}
+
+// "summary": вызовы функции и время по FullAlgoType, их сокращение и ускорение относительно базового режима
+void writeSummary(const std::vector<CallTotals> &totals, FILE *output)
+{
+    std::fprintf(output, ",\"summary\":[");
+    bool first = true;
+    for (const CallTotals &t : totals) {
+        const double reduction = (t.baseline > 0) ? 1.0 - double(t.calls) / double(t.baseline) : 0.0;
+        const double speedup = (t.time_ms > 0.0) ? t.baseline_time_ms / t.time_ms : 0.0;
+        std::fprintf(output, "%s\n  {\"algorithm\":%s,\"function_calls\":%lld,\"baseline_function_calls\":%lld,"
+                             "\"reduction\":%s,\"time_ms\":%s,\"baseline_time_ms\":%s,\"speedup\":%s}",
+                     first ? "" : ",", Batch::jsonString(Batch::fullAlgoTypeToString(t.algorithm)).c_str(),
+                     t.calls, t.baseline, Batch::jsonNumber(reduction).c_str(), Batch::jsonNumber(t.time_ms).c_str(),
+                     Batch::jsonNumber(t.baseline_time_ms).c_str(), Batch::jsonNumber(speedup).c_str());
+        std::fprintf(stderr, "%-4s function calls %10lld, baseline %10lld, reduction %6.1f%%, "
+                             "time %9.3f ms, baseline %9.3f ms, speed-up %5.2fx\n",
+                     Batch::fullAlgoTypeToString(t.algorithm), t.calls, t.baseline, 100.0 * reduction,
+                     t.time_ms, t.baseline_time_ms, speedup);
+        first = false;
+    }
+    std::fprintf(output, "\n]");
+}
+
+// Мультистарт одного варианта на пулах из 1, 2, 4, ... потоков
+std::string runMultiStartVariant(const TestFunction &function, const Variant &variant, const Options &options)
+{
+    Batch::Task task = makeTask(function, variant, options);
+    task.start_count = options.multistart;
+    task.start_sampling = static_cast<int>(SC::StartSampling::Sobol);
+
+    const unsigned maxThreads = options.threads ? options.threads : std::max(1u, std::thread::hardware_concurrency());
+    std::vector<unsigned> threadCounts;
+    for (unsigned threads = 1; threads < maxThreads; threads *= 2) {
+        threadCounts.push_back(threads);
+    }
+    threadCounts.push_back(maxThreads);
+
+    using Batch::jsonNumber;
+    using Batch::jsonString;
+    std::string out = "{";
+    out += "\"function\":" + jsonString(function.name);
+    out += ",\"algorithm\":" + jsonString(Batch::fullAlgoTypeToString(variant.algorithm));
+    const char *step = stepTypeToString(variant.step_type);
+    out += ",\"step\":" + (step ? jsonString(step) : std::string("null"));
+    out += ",\"starts\":" + std::to_string(options.multistart);
+
+    Batch::TaskResult result;
+    double single = 0.0;
+    std::string timings;
+    for (unsigned threads : threadCounts) {
+        SC::ThreadPool pool(threads);
+        std::vector<double> times;
+        for (int i = 0; i < options.repeats; ++i) {
+            const auto start = std::chrono::steady_clock::now();
+            result = Batch::runMultiStart(task, pool);
+            const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+            times.push_back(elapsed.count());
+        }
+        std::sort(times.begin(), times.end());
+        const double median = times[times.size() / 2];
+        if (threads == 1) {
+            single = median;
+        }
+        const double speedup = (median > 0.0) ? single / median : 0.0;
+        timings += std::string(timings.empty() ? "" : ",") + "{\"threads\":" + std::to_string(threads) +
+                   ",\"time_ms_median\":" + jsonNumber(median) + ",\"speedup\":" + jsonNumber(speedup) + "}";
+        std::fprintf(stderr, "  %2u threads %9.3f ms, speed-up %5.2fx\n", threads, median, speedup);
+    }
+    out += ",\"status\":" + std::to_string(result.status);
+    out += ",\"optima\":" + std::to_string(result.optima.size());
+    out += ",\"function_calls\":" + std::to_string(result.function_calls);
+    out += ",\"threads\":[" + timings + "]}";
+    return out;
+}
+
+void runMultiStartAll(const Options &options, FILE *output)
+{
+    bool first = true;
+    for (const auto &function : testFunctions()) {
+        for (const auto &variant : variants()) {
+            const std::string label = std::string(function.name) + "/" + Batch::fullAlgoTypeToString(variant.algorithm);
+            if (!options.filter.empty() && label.find(options.filter) == std::string::npos) {
+                continue;
+            }
+            const char *step = stepTypeToString(variant.step_type);
+            std::fprintf(stderr, "%-32s %-12s\n", label.c_str(), step ? step : "-");
+            const std::string run = runMultiStartVariant(function, variant, options);
+            std::fprintf(output, "%s\n  %s", first ? "" : ",", run.c_str());
+            first = false;
+        }
+    }
+    std::fprintf(output, "\n]");
+}
+
+// Одна задача с SC::ValueMemo и без него; true — результаты совпали с точностью результата
+std::string checkMemoVariant(Batch::TaskRunner &runner, const TestFunction &function, const Variant &variant,
+                             const Options &options, bool &passed)
+{
+    const Batch::Task task = makeTask(function, variant, options);
+    runner.setValueMemo(true);
+    const Batch::TaskResult memo = runner.run(task);
+    runner.setValueMemo(false);
+    const Batch::TaskResult plain = runner.run(task);
+    runner.setValueMemo(true);
+
+    const double tolerance = std::pow(10.0, -task.result_precision);
+    auto close = [tolerance](double a, double b) {
+        return (std::isnan(a) && std::isnan(b)) || std::abs(a - b) <= tolerance;
+    };
+    passed = memo.status == plain.status && memo.found == plain.found &&
+             (!memo.found || (close(memo.x, plain.x) && close(memo.y, plain.y) && close(memo.value, plain.value)));
+
+    using Batch::jsonNumber;
+    using Batch::jsonString;
+    std::string out = "{";
+    out += "\"function\":" + jsonString(function.name);
+    out += ",\"algorithm\":" + jsonString(Batch::fullAlgoTypeToString(variant.algorithm));
+    const char *step = stepTypeToString(variant.step_type);
+    out += ",\"step\":" + (step ? jsonString(step) : std::string("null"));
+    out += ",\"passed\":" + std::string(passed ? "true" : "false");
+    out += ",\"tolerance\":" + jsonNumber(tolerance);
+    for (const auto &[name, result] : { std::make_pair("memo", &memo), std::make_pair("plain", &plain) }) {
+        out += ",\"" + std::string(name) + "\":{\"status\":" + std::to_string(result->status);
+        out += ",\"function_calls\":" + std::to_string(result->function_calls);
+        if (result->found) {
+            out += ",\"x\":" + jsonNumber(result->x) + ",\"y\":" + jsonNumber(result->y) +
+                   ",\"f\":" + jsonNumber(result->value);
+        }
+        out += "}";
+    }
+    out += "}";
+    return out;
+}
+
+// Все варианты с SC::ValueMemo и без него; возвращает число расхождений
+int checkMemoAll(const Options &options, FILE *output)
+{
+    Batch::TaskRunner runner;
+    int failures = 0;
+    bool first = true;
+    for (const auto &function : testFunctions()) {
+        for (const auto &variant : variants()) {
+            const std::string label = std::string(function.name) + "/" + Batch::fullAlgoTypeToString(variant.algorithm);
+            if (!options.filter.empty() && label.find(options.filter) == std::string::npos) {
+                continue;
+            }
+            bool passed = false;
+            const std::string run = checkMemoVariant(runner, function, variant, options, passed);
+            std::fprintf(output, "%s\n  %s", first ? "" : ",", run.c_str());
+            first = false;
+            const char *step = stepTypeToString(variant.step_type);
+            std::fprintf(stderr, "%-32s %-12s %s\n", label.c_str(), step ? step : "-", passed ? "ok" : "MISMATCH");
+            failures += passed ? 0 : 1;
+        }
+    }
+    std::fprintf(output, "\n]");
+    std::fprintf(output, ",\"memo_mismatches\":%d", failures);
+    return failures;
+}
+
+template <typename Runner>
+void runAll(Runner &runner, const Options &options, FILE *output, SC::Trace *trace)
+{
+    runner.setTrace(trace);
+    std::vector<CallTotals> totals;
+    bool first = true;
+    for (const auto &function : testFunctions()) {
+        for (const auto &variant : variants()) {
+            const std::string label = std::string(function.name) + "/" + Batch::fullAlgoTypeToString(variant.algorithm);
+            if (!options.filter.empty() && label.find(options.filter) == std::string::npos) {
+                continue;
+            }
+            const char *step = stepTypeToString(variant.step_type);
+            if (trace) {
+                trace->beginRun(label + (step ? std::string("/") + step : std::string()));
+            }
+            auto it = std::find_if(totals.begin(), totals.end(),
+                                   [&](const CallTotals &t) { return t.algorithm == variant.algorithm; });
+            if (it == totals.end()) {
+                it = totals.insert(totals.end(), CallTotals{ variant.algorithm });
+            }
+            const std::string run = runVariant(runner, function, variant, options, trace, *it);
+            std::fprintf(output, "%s\n  %s", first ? "" : ",", run.c_str());
+            first = false;
+            std::fprintf(stderr, "%-32s %-12s done\n", label.c_str(), step ? step : "-");
+        }
+    }
+    std::fprintf(output, "\n]");
+    if (hasBaseline(options)) {
+        writeSummary(totals, output);
+    }
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    static const char *const evaluators[] = { "MUPARSER", "TAPE", "NATIVE" };
+    static const char *const lineSearches[] = { "SEQUENTIAL", "BATCHED", "GOLDEN", "WOLFE" };
+    static const char *const baselines[] = { "SEQUENTIAL", "BATCHED", "GOLDEN", "WOLFE", "NONE" };
+    static const char *const reporters[] = { "NULL", "TABLES" };
+    Options options;
+    for (int i = 1; i < argc; ++i) {
+        const bool hasValue = (i + 1 < argc);
+        if (std::strcmp(argv[i], "-r") == 0 && hasValue) {
+            options.repeats = std::max(1, std::atoi(argv[++i]));
+        } else if (std::strcmp(argv[i], "-o") == 0 && hasValue) {
+            options.output = argv[++i];
+        } else if (std::strcmp(argv[i], "--evaluator") == 0 && hasValue &&
+                   parseName(argv[i + 1], evaluators, options.evaluator_type)) {
+            ++i;
+        } else if (std::strcmp(argv[i], "--line-search") == 0 && hasValue &&
+                   parseName(argv[i + 1], lineSearches, options.line_search_type)) {
+            ++i;
+        } else if (std::strcmp(argv[i], "--baseline") == 0 && hasValue &&
+                   parseName(argv[i + 1], baselines, options.baseline)) {
+            ++i;
+        } else if (std::strcmp(argv[i], "--reporter") == 0 && hasValue &&
+                   parseName(argv[i + 1], reporters, options.reporter)) {
+            ++i;
+        } else if (std::strcmp(argv[i], "--trace") == 0 && hasValue) {
+            options.trace = argv[++i];
+        } else if (std::strcmp(argv[i], "--filter") == 0 && hasValue) {
+            options.filter = argv[++i];
+        } else if (std::strcmp(argv[i], "--multistart") == 0 && hasValue) {
+            options.multistart = std::max(1, std::atoi(argv[++i]));
+        } else if (std::strcmp(argv[i], "--threads") == 0 && hasValue) {
+            options.threads = static_cast<unsigned>(std::max(1, std::atoi(argv[++i])));
+        } else if (std::strcmp(argv[i], "--check-memo") == 0) {
+            options.checkMemo = true;
+        } else {
+            printUsage();
+            return (std::strcmp(argv[i], "-h") == 0 || std::strcmp(argv[i], "--help") == 0) ? 0 : 1;
+        }
+    }
+
+    FILE *output = stdout;
+    if (options.output) {
+        output = std::fopen(options.output, "w");
+        if (!output) {
+            std::fprintf(stderr, "optdemo-bench: cannot open %s\n", options.output);
+            return 1;
+        }
+    }
+
+    NullBuffer nullBuffer;
+    std::streambuf *coutBuffer = std::cout.rdbuf(&nullBuffer);
+
+    std::fprintf(output,
+                 "{\"suite\":\"optdemo-bench\",\"repeats\":%d,\"evaluator\":%s,\"line_search\":%s,\"baseline\":%s,\"reporter\":%s,\"runs\":[",
+                 options.repeats, Batch::jsonString(evaluators[options.evaluator_type]).c_str(),
+                 Batch::jsonString(lineSearches[options.line_search_type]).c_str(),
+                 Batch::jsonString(baselines[options.baseline]).c_str(),
+                 Batch::jsonString(reporters[options.reporter]).c_str());
+    std::unique_ptr<SC::Trace> trace;
+    if (options.trace) {
+        trace = std::make_unique<SC::Trace>();
+    }
+    int memoMismatches = 0;
+    if (options.checkMemo) {
+        memoMismatches = checkMemoAll(options, output);
+    } else if (options.multistart > 0) {
+        runMultiStartAll(options, output);
+    } else if (options.reporter == 1) {
+        Batch::BasicTaskRunner<TableRecorder> runner;
+        runAll(runner, options, output, trace.get());
+    } else {
+        Batch::TaskRunner runner;
+        runAll(runner, options, output, trace.get());
+    }
+    std::fprintf(output, "}\n");
+
+    if (trace) {
+        std::ofstream traceFile(options.trace);
+        trace->write(traceFile);
+        if (!traceFile) {
+            std::fprintf(stderr, "optdemo-bench: cannot write %s\n", options.trace);
+        }
+    }
+
+    std::cout.rdbuf(coutBuffer);
+    if (output != stdout) {
+        std::fclose(output);
+    }
+    return (memoMismatches > 0) ? 2 : 0;
+}
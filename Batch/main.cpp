@@ -0,0 +1,206 @@
+//
+// optdemo-batch — пакетное решение задач без графического интерфейса.
+//
+// Читает задачи в формате JSON Lines (по объекту на строку, см. Batch::Task)
+// из файла или stdin, решает их параллельно и пишет по одной строке
+// результата на задачу в stdout по мере готовности. Порядок строк
+// результата — порядок завершения; поле "line" указывает номер строки задачи.
+//
+// Задача со "start_count" (мультистарт, Batch::runMultiStart) распределяет
+// свои запуски по всем потокам; чтение следующих задач ждёт её завершения.
+// В её строке результата — "starts" и "optima": все найденные локальные
+// экстремумы, лучший — первым.
+//
+//   optdemo-batch [-j N] [-v] [файл]
+//
+//   -j N  число потоков (по умолчанию — число ядер)
+//   -v    не подавлять отладочный вывод методов (идёт в stderr)
+//
+#include <Batch/Json.hpp>
+#include <Batch/Task.hpp>
+#include <SolverCore/ThreadPool.hpp>
+
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+namespace {
+
+// Поглощает отладочный вывод методов, чтобы он не смешивался с результатами
+class NullBuffer : public std::streambuf {
+protected:
+    int overflow(int c) override { return traits_type::not_eof(c); }
+    std::streamsize xsputn(const char *, std::streamsize n) override { return n; }
+};
+
+std::mutex g_outputMutex;
+
+void writeLine(const std::string &line)
+{
+    std::lock_guard<std::mutex> lock(g_outputMutex);
+    std::fwrite(line.data(), 1, line.size(), stdout);
+    std::fputc('\n', stdout);
+    std::fflush(stdout);
+}
+
+std::string resultLine(size_t lineNumber, const Batch::Task &task, const Batch::TaskResult &result)
+{
+    using Batch::jsonNumber;
+    using Batch::jsonString;
+    std::string out = "{";
+    if (!task.id.empty()) {
+        out += "\"id\":" + task.id + ",";
+    }
+    out += "\"line\":" + std::to_string(lineNumber);
+    out += ",\"algorithm\":" + jsonString(Batch::fullAlgoTypeToString(task.algorithm));
+    out += ",\"status\":" + std::to_string(result.status);
+    out += ",\"message\":" + jsonString(result.message);
+    if (result.found && !result.point.empty()) {
+        out += ",\"variables\":" + Batch::jsonStringArray(result.variables);
+        out += ",\"point\":" + Batch::jsonNumberArray(result.point);
+        out += ",\"f\":" + jsonNumber(result.value);
+    } else if (result.found) {
+        out += ",\"x\":" + jsonNumber(result.x);
+        out += ",\"y\":" + jsonNumber(result.y);
+        out += ",\"f\":" + jsonNumber(result.value);
+    }
+    if (result.starts > 0) {
+        out += ",\"starts\":" + std::to_string(result.starts);
+        out += ",\"optima\":[";
+        for (size_t i = 0; i < result.optima.size(); ++i) {
+            const SC::LocalOptimum &optimum = result.optima[i];
+            out += (i ? ",{\"x\":" : "{\"x\":") + jsonNumber(optimum.point.x);
+            out += ",\"y\":" + jsonNumber(optimum.point.y);
+            out += ",\"f\":" + jsonNumber(optimum.value);
+            out += ",\"hits\":" + std::to_string(optimum.hits) + "}";
+        }
+        out += "]";
+    }
+    out += ",\"iterations\":" + std::to_string(result.iterations);
+    out += ",\"function_calls\":" + std::to_string(result.function_calls);
+    out += ",\"time_ms\":" + jsonNumber(result.seconds * 1000.0);
+    out += "}";
+    return out;
+}
+
+std::string errorLine(size_t lineNumber, const std::string &message)
+{
+    return "{\"line\":" + std::to_string(lineNumber) + ",\"status\":null,\"message\":" +
+           Batch::jsonString(message) + "}";
+}
+
+void printUsage()
+{
+    std::fprintf(stderr, "usage: optdemo-batch [-j N] [-v] [file]\n");
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    unsigned threads = 0;
+    bool verbose = false;
+    const char *path = nullptr;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "-j") == 0 && i + 1 < argc) {
+            threads = static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (std::strcmp(argv[i], "-v") == 0) {
+            verbose = true;
+        } else if (std::strcmp(argv[i], "-h") == 0 || std::strcmp(argv[i], "--help") == 0) {
+            printUsage();
+            return 0;
+        } else if (!path && (argv[i][0] != '-' || std::strcmp(argv[i], "-") == 0)) {
+            path = argv[i];
+        } else {
+            printUsage();
+            return 1;
+        }
+    }
+
+    std::ifstream file;
+    std::istream *input = &std::cin;
+    if (path && std::strcmp(path, "-") != 0) {
+        file.open(path);
+        if (!file) {
+            std::fprintf(stderr, "optdemo-batch: cannot open %s\n", path);
+            return 1;
+        }
+        input = &file;
+    }
+
+    NullBuffer nullBuffer;
+    std::streambuf *coutBuffer = std::cout.rdbuf(verbose ? std::cerr.rdbuf() : &nullBuffer);
+
+    SC::ThreadPool pool(threads);
+    std::vector<std::unique_ptr<Batch::TaskRunner>> runners;
+    for (unsigned i = 0; i < pool.size(); ++i) {
+        runners.emplace_back(std::make_unique<Batch::TaskRunner>());
+    }
+
+    // Чтение не уходит далеко вперёд решения: в работе не больше maxInFlight задач
+    const size_t maxInFlight = 4 * static_cast<size_t>(pool.size());
+    size_t inFlight = 0;
+    std::mutex inFlightMutex;
+    std::condition_variable inFlightChanged;
+
+    std::string line;
+    size_t lineNumber = 0;
+    while (std::getline(*input, line)) {
+        ++lineNumber;
+        if (line.find_first_not_of(" \t\r") == std::string::npos) {
+            continue;
+        }
+        auto task = std::make_shared<Batch::Task>();
+        std::string error;
+        if (!Batch::parseTask(line, *task, error)) {
+            writeLine(errorLine(lineNumber, error));
+            continue;
+        }
+
+        if (task->start_count > 0) {
+            std::string out;
+            try {
+                out = resultLine(lineNumber, *task, Batch::runMultiStart(*task, pool));
+            } catch (const std::exception &e) {
+                out = errorLine(lineNumber, e.what());
+            }
+            writeLine(out);
+            continue;
+        }
+
+        {
+            std::unique_lock<std::mutex> lock(inFlightMutex);
+            inFlightChanged.wait(lock, [&] { return inFlight < maxInFlight; });
+            ++inFlight;
+        }
+        pool.submit(static_cast<unsigned>(lineNumber % pool.size()), [&, task, lineNumber](unsigned worker) {
+            std::string out;
+            try {
+                out = resultLine(lineNumber, *task, runners[worker]->run(*task));
+            } catch (const std::exception &e) {
+                out = errorLine(lineNumber, e.what());
+            } catch (...) {
+                out = errorLine(lineNumber, "неизвестная ошибка");
+            }
+            writeLine(out);
+            std::lock_guard<std::mutex> lock(inFlightMutex);
+            --inFlight;
+            inFlightChanged.notify_all();
+        });
+    }
+
+    {
+        std::unique_lock<std::mutex> lock(inFlightMutex);
+        inFlightChanged.wait(lock, [&] { return inFlight == 0; });
+    }
+    std::cout.rdbuf(coutBuffer);
+    return 0;
+}
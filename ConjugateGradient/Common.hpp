@@ -37,7 +37,8 @@ namespace CG {
         InvalidComputationPrecision = -19, // Неверный ввод точности вычислений
         InvalidLogicPrecision = -20,       // Неверный ввод точностей
         OscillationDetected = -23,         // Найдены осцилляции
-        Continue = -24                     // Продолжать итерации (временный статус)
+        Continue = -24,                    // Продолжать итерации (временный статус)
+        Cancelled = -25                    // Решение отменено пользователем
     };
 
     // Тип алгоритма оптимизации
@@ -51,6 +52,21 @@ namespace CG {
         MAXIMUM  // Максимум
     };
 
+    // Способ одномерного поиска шага
+    enum class LineSearchType {
+        SEQUENTIAL, // Вычисления по одной точке (метод Брента, дробление шага)
+        BATCHED,    // Пакетная сетка и параболические уточнения (SC::gridLineSearch)
+        GOLDEN,     // Как SEQUENTIAL, но золотое сечение вместо метода Брента (для сравнения)
+        WOLFE       // Сильные условия Вольфе по значению и градиенту (наискорейший спуск, сопряжённые градиенты)
+    };
+
+    // Способ вычисления целевой функции (см. SC::Backend)
+    enum class EvaluatorType {
+        MUPARSER, // Байткод muParser (по умолчанию)
+        TAPE,     // Регистровая лента инструкций
+        NATIVE    // Машинный код, собранный системным компилятором (откат на TAPE)
+    };
+
     // ============================================================================
     // Структуры входных данных
     // ============================================================================
@@ -81,6 +97,10 @@ namespace CG {
         int max_iterations = 1000;       // Макс. число итераций 
         int max_function_calls = 10000;  // Макс. число вызовов функции
 
+        // --- ВЫЧИСЛЕНИЕ ---
+        EvaluatorType evaluator_type = EvaluatorType::MUPARSER; // Способ вычисления функции
+        LineSearchType line_search_type = LineSearchType::SEQUENTIAL; // Способ поиска шага
+
     };
 
     // ============================================================================
@@ -125,6 +145,7 @@ namespace CG {
         case Result::InvalidComputationPrecision: return "Неверный ввод точности вычислений";
         case Result::InvalidLogicPrecision:       return "Неверный ввод точностей";
         case Result::OscillationDetected:         return "Обнаружены осцилляции";
+        case Result::Cancelled:                   return "Решение отменено";
         default:                                  return "Unknown result";
         }
     }
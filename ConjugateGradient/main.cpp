@@ -12,20 +12,13 @@
 
 using namespace CG;
 
-// Класс-заглушка - реализовывать не нужно!
-class MockReporter {
-public:
-    int begin() { return 0; } // Возвращаем 1, чтобы обойти проверку в solve() (предполагаем опечатку в условии ==0)
-    int end() { return 0; } // Возвращаем 0, чтобы solve() вернул Success при успешном завершении
-};
-
 double MySqr(double a_fVal) { return a_fVal * a_fVal; }
 
 int main()
 {
 
-    using AlgoType = ConjugateGradient<MockReporter>;
-    MockReporter reporter{};
+    using AlgoType = ConjugateGradient<SC::NullReporter>;
+    SC::NullReporter reporter{};
     AlgoType algo{ &reporter };
     InputData data{};
 
@@ -46,7 +46,8 @@ enum class Result : int {
     InvalidStepTypeX = -27,            // Неверный тип шага для X
     InvalidStepTypeY = -28,            // Неверный тип шага для Y
     OscillationDetected = -29,         // Найдены осцилляции
-    Continue = -30                     // Продолжать итерации (временный статус)
+    Continue = -30,                    // Продолжать итерации (временный статус)
+    Cancelled = -31                    // Решение отменено пользователем
 };
 
 // Тип алгоритма оптимизации
@@ -69,6 +70,21 @@ enum class StepType {
     ADAPTIVE     // Адаптивный шаг:     step подбирается автоматически на каждой итерации
 };
 
+// Способ одномерного поиска шага
+enum class LineSearchType {
+    SEQUENTIAL, // Вычисления по одной точке (метод Брента, дробление шага)
+    BATCHED,    // Пакетная сетка и параболические уточнения (SC::gridLineSearch)
+    GOLDEN,     // Как SEQUENTIAL, но золотое сечение вместо метода Брента (для сравнения)
+    WOLFE       // Сильные условия Вольфе по значению и градиенту (наискорейший спуск, сопряжённые градиенты)
+};
+
+// Способ вычисления целевой функции (см. SC::Backend)
+enum class EvaluatorType {
+    MUPARSER, // Байткод muParser (по умолчанию)
+    TAPE,     // Регистровая лента инструкций
+    NATIVE    // Машинный код, собранный системным компилятором (откат на TAPE)
+};
+
 // ============================================================================
 // Структуры входных данных
 // ============================================================================
@@ -114,6 +130,10 @@ struct InputData {
     int max_iterations = 1000;       // Макс. число итераций 
     int max_function_calls = 10000;  // Макс. число вызовов функции
 
+    // --- ВЫЧИСЛЕНИЕ ---
+    EvaluatorType evaluator_type = EvaluatorType::MUPARSER; // Способ вычисления функции
+    LineSearchType line_search_type = LineSearchType::SEQUENTIAL; // Способ поиска шага
+
 };
 
 // ============================================================================
@@ -167,6 +187,7 @@ inline std::string resultToString(Result result) {
         case Result::InvalidStepTypeX:            return "Неверный тип шага для X";
         case Result::InvalidStepTypeY:            return "Неверный тип шага для Y"; 
         case Result::OscillationDetected:         return "Обнаружены осцилляции";
+        case Result::Cancelled:                   return "Решение отменено";
         default:                                  return "Неизвестная ошибка";
     }
 }
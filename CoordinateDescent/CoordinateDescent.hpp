@@ -8,6 +8,12 @@
 
 #include <CoordinateDescent/Common.hpp>
 #include <muParser.h>
+#include <SolverCore/Descent.hpp>
+#include <SolverCore/Instrument.hpp>
+#include <SolverCore/LineSearch.hpp>
+#include <SolverCore/Objective.hpp>
+#include <SolverCore/Progress.hpp>
+#include <SolverCore/Reporter.hpp>
 #include <vector>
 #include <cmath>
 #include <algorithm>
@@ -20,20 +26,16 @@ namespace CD {
 template <typename Reporter>
 class CoordinateDescent {
 
-    // Пример объявления и инициализации констант
-    static constexpr double MIN_STEP{1e-10};       // Минимальный шаг (до 10^-10)
-    static constexpr double STEP_REDUCTION{0.5};   // Коэффициент снижения шага
-    static constexpr double MAX_STEP{1.0};         // Максимальный шаг (до 1.0)
+    static constexpr bool REPORTING{ SC::reporterEnabled<Reporter> }; // Нужны ли таблицы и сообщения
+    static constexpr bool INSTRUMENTED{ SOLVERCORE_INSTRUMENT != 0 }; // Замеры по фазам решения
 
 public:
 
     CoordinateDescent(Reporter *reporter) :
         m_inputData{nullptr},
         m_reporter{reporter},
-        m_parser{}, // Инициализация парсера muParser 
         m_x{0.0},
         m_y{0.0},
-        m_function_calls{0},
         m_iterations{0},
         m_digitResultPrecision{0},
         m_digitComputationPrecision{0},
@@ -46,8 +48,18 @@ public:
     double getX() const          { return m_x; }                        // Получить X
     double getY() const          { return m_y; }                        // Получить Y
     int getIterations() const    { return m_iterations; }               // Получить кол-во итераций
-    int getFunctionCalls() const { return m_function_calls; }           // Получить кол-во вызовов функции
-    double getOptimumValue()     { return evaluateFunction(m_x, m_y); } // Вычисление значение функции в финальной точке
+    int getFunctionCalls() const { return m_objective.calls(); }        // Получить кол-во вызовов функции
+    double getOptimumValue()     { return m_objective.value(m_x, m_y); } // Вычисление значение функции в финальной точке
+
+    // Ход решения и флаг отмены (nullptr — не отслеживать)
+    void setProgress(SC::Progress *progress) { m_progress = progress; }
+
+    // Замеры по фазам последнего solve() (enabled == false, если вырезаны)
+    const SC::SolveStats& getStats() const { return m_instrument.stats(); }
+    // События фаз для Chrome trace (nullptr — не записывать)
+    void setTrace(SC::Trace *trace) { m_instrument.setTrace(trace); }
+    // false — не запоминать значения в точках решения (SC::ValueMemo), для проверки бенчмарком
+    void setValueMemo(bool enabled) { m_objective.setMemo(enabled); }
 
 
     Result setInputData(const InputData *data)
@@ -191,6 +203,7 @@ public:
         }
 
         resetAlgorithmState();
+        m_instrument.begin();
         // Округляем результат
         m_computationPrecision = std::pow(10, -m_inputData->computation_precision);
         m_resultPrecision = std::pow(10, -m_inputData->result_precision);
@@ -203,7 +216,7 @@ public:
             initializeParser();
 
             if (!isFunctionDifferentiableAtStart()) {
-                m_reporter->insertMessage("Функция не дифференцируема...");
+                report([&](auto& reporter) { reporter.insertMessage("Функция не дифференцируема..."); });
                 return Result::NonDifferentiableFunction;
             }
             // Выбор алгоритма
@@ -229,22 +242,26 @@ public:
 
         // Процесс решения и записи отчета (разбить на приватные функции)
 
+        m_instrument.end();
+        if constexpr (REPORTING) {
+            m_reporter->insertStats(m_instrument.stats());
+        }
         if (m_reporter->end() == 0) {
-            return Result::Success;
+            return result;
+        }else {
+            if (result == Result::Success) return Result::Fail;
+            else return result;
         }
-        return Result::Fail;
     }
 
 private:
 
-    std::vector<std::pair<double, double>> m_recent_points;
-    int m_oscillation_count;
-    std::vector<std::string> m_non_diff_functions;
     const InputData *m_inputData; // Настройки алгоритма
     Reporter* m_reporter; // Указатель на систему отчётности
-    mu::Parser m_parser; // Система вычисления
-    double m_x, m_y; // Текущие переменные для парсера
-    int m_function_calls; // Счётчик вызовов функции
+    SC::Progress *m_progress = nullptr; // Ход решения и флаг отмены
+    SC::Instrument<INSTRUMENTED> m_instrument; // Замеры по фазам решения
+    SC::Objective<INSTRUMENTED> m_objective; // Целевая функция: парсеры, AD, способ вычисления, значения в точках
+    double m_x, m_y; // Найденная точка
     int m_iterations; // Счётчик итераций
     int m_digitResultPrecision; // Количество знаков после запятой для результата
     int m_digitComputationPrecision; // Количество знаков после запятой для вычислений
@@ -253,48 +270,44 @@ private:
 
     // Инициализация парсера
     void initializeParser() {
-        m_parser.SetExpr(m_inputData->function); // Загрузка заданной функции
-        m_parser.DefineVar("x", &m_x); // Связывание переменной X с полем m_x
-        m_parser.DefineVar("y", &m_y); // Связывание переменной Y с полем m_y
-        m_function_calls = 0;
+        // Порядок EvaluatorType совпадает с SC::Backend
+        const auto requested = static_cast<SC::Backend>(m_inputData->evaluator_type);
+        const bool batched = (m_inputData->line_search_type == LineSearchType::BATCHED);
+        const SC::Backend active = m_objective.load(m_inputData->function, requested, batched,
+            m_inputData->computation_precision, &m_instrument);
+        if (active != requested) {
+            report([&](auto& reporter) {
+                reporter.insertMessage(std::string("Способ вычисления «") + SC::backendToString(requested) +
+                    "» недоступен (" + m_objective.errorMessage() + "), используется «" +
+                    SC::backendToString(active) + "».");
+            });
+        }
+        // Шаг вдоль одной координаты ищется последовательно или пакетно;
+        // поиски по условиям Вольфе и золотым сечением здесь не реализованы
+        if (m_inputData->line_search_type == LineSearchType::WOLFE ||
+            m_inputData->line_search_type == LineSearchType::GOLDEN) {
+            report([&](auto& reporter) {
+                const bool wolfe = (m_inputData->line_search_type == LineSearchType::WOLFE);
+                reporter.insertMessage(std::string("Поиск шага ") +
+                    (wolfe ? "по условиям Вольфе" : "золотым сечением") +
+                    " не поддерживается покоординатным спуском, используется последовательный.");
+            });
+        }
         m_iterations = 0;
     }
 
     // Метод для сброса состояния алгоритма
     void resetAlgorithmState() {
-        m_function_calls = 0;
         m_iterations = 0;
         m_x = 0.0;
         m_y = 0.0;
-        m_recent_points.clear();
-        m_oscillation_count = 0;
-
-        // Инициализация списка недифференцируемых функций
-        m_non_diff_functions = {
-            "abs(", "|", "sign(", "floor(", "ceil(", "round(",
-            "fmod(", "mod(", "rand(", "max(", "min(", "random"
-        };
+        m_objective.reset();
     }
 
     // Провернка синтаксиса функции
     Result validateFunctionSyntax(const std::string& function) {
-        try {
-            mu::Parser test_parser;
-            double test_x = 0.0;
-            double test_y = 0.0;
-            test_parser.SetExpr(function);
-            test_parser.DefineVar("x", &test_x);
-            test_parser.DefineVar("y", &test_y);
-
-            // Пробуем вычислить в тестовой точке
-            test_parser.Eval();
-
-            return Result::Success;
-        } catch (const mu::Parser::exception_type& e) {
-            return Result::ParseError;
-        } catch (...) {
-            return Result::ParseError;
-        }
+        // Функцию, которую уже проверил любой метод, повторно не проверяем
+        return m_objective.validate(function) ? Result::Success : Result::ParseError;
     }
 
     // Проверка дифференцируемости в начальной точке
@@ -304,44 +317,38 @@ private:
             double y = m_inputData->initial_y;
 
             // Проверяем производные в начальной точке
-            partialDerivativeX(x, y);
-            partialDerivativeY(x, y);
+            m_objective.dx(x, y);
+            m_objective.dy(x, y);
 
             return true;
         }
         catch (...) {
             std::cout << "Функция не дифференцируема в начальной точке ("
                 << m_inputData->initial_x << ", " << m_inputData->initial_y << ")" << std::endl;
-            m_reporter->insertMessage("Функция не дифференцируема в начальной точке ("
-                + std::to_string(m_inputData->initial_x) + ", " + std::to_string(m_inputData->initial_y) + ")");
+            report([&](auto& reporter) {
+                reporter.insertMessage("Функция не дифференцируема в начальной точке ("
+                    + std::to_string(m_inputData->initial_x) + ", " + std::to_string(m_inputData->initial_y) + ")");
+            });
             return false;
         }
     }
 
     Result checkFunctionDifferentiability(const std::string& function) {
         try {
-            // ИСПОЛЬЗУЕМ m_non_diff_functions ВМЕСТО СТАТИЧЕСКОЙ ПЕРЕМЕННОЙ
-            std::string func_lower = function;
-            std::transform(func_lower.begin(), func_lower.end(), func_lower.begin(), ::tolower);
-
-            for (const auto& non_diff_func : m_non_diff_functions) {
-                std::string non_diff_lower = non_diff_func;
-                std::transform(non_diff_lower.begin(), non_diff_lower.end(), non_diff_lower.begin(), ::tolower);
-
-                if (func_lower.find(non_diff_lower) != std::string::npos) {
-                    std::cout << "Обнаружена потенциально недифференцируемая функция: " << non_diff_func << std::endl;
-                    m_reporter->insertMessage("Обнаружена потенциально недифференцируемая функция: " + non_diff_func);
-                    return Result::NonDifferentiableFunction;
-                }
+            // Известные недифференцируемые функции ищутся один раз на функцию, при разборе
+            const std::string& non_diff_func = m_objective.compiled().nonDifferentiable();
+            if (!non_diff_func.empty()) {
+                std::cout << "Обнаружена потенциально недифференцируемая функция: " << non_diff_func << std::endl;
+                report([&](auto& reporter) {
+                    reporter.insertMessage("Обнаружена потенциально недифференцируемая функция: " + non_diff_func);
+                });
+                return Result::NonDifferentiableFunction;
             }
 
             // Проверка численной дифференцируемости
-            mu::Parser test_parser;
+            // Функция уже загружена в парсер метода при проверке синтаксиса
             double test_x = 0.0;
             double test_y = 0.0;
-            test_parser.SetExpr(function);
-            test_parser.DefineVar("x", &test_x);
-            test_parser.DefineVar("y", &test_y);
 
             const int TEST_POINTS = 8;
             std::vector<std::pair<double, double>> test_points;
@@ -363,18 +370,18 @@ private:
                 test_y = point.second;
 
                 try {
-                    double func_value = test_parser.Eval();
+                    double func_value = m_objective.parserValue(test_x, test_y);
                     // Проверяем производные с разной точностью
                     double deriv_x1 = 0.0, deriv_x2 = 0.0;
                     double deriv_y1 = 0.0, deriv_y2 = 0.0;
 
                     // Первая попытка с обычной точностью
-                    deriv_x1 = test_parser.Diff(&test_x, test_x, 1e-6);
-                    deriv_y1 = test_parser.Diff(&test_y, test_y, 1e-6);
+                    deriv_x1 = m_objective.parserDx(test_x, test_y, 1e-6);
+                    deriv_y1 = m_objective.parserDy(test_x, test_y, 1e-6);
 
                     // Вторая попытка с другой точностью для проверки стабильности
-                    deriv_x2 = test_parser.Diff(&test_x, test_x, 1e-7);
-                    deriv_y2 = test_parser.Diff(&test_y, test_y, 1e-7);
+                    deriv_x2 = m_objective.parserDx(test_x, test_y, 1e-7);
+                    deriv_y2 = m_objective.parserDy(test_x, test_y, 1e-7);
 
                     // Проверяем, что производные не "взрываются"
                     if (std::isnan(deriv_x1) || std::isinf(deriv_x1) ||
@@ -384,8 +391,10 @@ private:
                         std::cout << "Производная не определена в точке ("
                             << test_x << ", " << test_y << ")" << std::endl;
 
-                        m_reporter->insertMessage("Производная не определена в точке (" 
-                        + std::to_string(test_x) + ", " + std::to_string(test_y) + ")");
+                        report([&](auto& reporter) {
+                            reporter.insertMessage("Производная не определена в точке (" 
+                            + std::to_string(test_x) + ", " + std::to_string(test_y) + ")");
+                        });
 
                         return Result::NonDifferentiableFunction;
                     }
@@ -394,8 +403,10 @@ private:
                     std::cout << "Функция не дифференцируема в точке ("
                         << test_x << ", " << test_y << "): " << e.GetMsg() << std::endl;
 
-                    m_reporter->insertMessage("Функция не дифференцируема в точке ("
-                        + std::to_string(test_x) + ", " + std::to_string(test_y) + ")");
+                    report([&](auto& reporter) {
+                        reporter.insertMessage("Функция не дифференцируема в точке ("
+                            + std::to_string(test_x) + ", " + std::to_string(test_y) + ")");
+                    });
 
                     return Result::NonDifferentiableFunction;
                 }
@@ -404,25 +415,27 @@ private:
                     std::cout << "Ошибка дифференцирования в точке ("
                         << test_x << ", " << test_y << "): " << e.what() << std::endl;
 
-                    m_reporter->insertMessage("Ошибка дифференцирования в точке ("
-                        + std::to_string(test_x) + ", " + std::to_string(test_y) + ")");
+                    report([&](auto& reporter) {
+                        reporter.insertMessage("Ошибка дифференцирования в точке ("
+                            + std::to_string(test_x) + ", " + std::to_string(test_y) + ")");
+                    });
 
                     return Result::NonDifferentiableFunction;
                 }
             }
             std::cout << "Функция прошла проверку дифференцируемости" << std::endl;
-            m_reporter->insertMessage("Функция прошла проверку дифференцируемости");
+            report([&](auto& reporter) { reporter.insertMessage("Функция прошла проверку дифференцируемости"); });
             return Result::Success;
 
         }
         catch (const mu::Parser::exception_type& e) {
-            std::cout << "Ошибка парсера при проверке дифференцируемости: " << e.GetMsg() << std::endl;\
-            m_reporter->insertMessage("Ошибка парсера при проверке дифференцируемости: ");
+            std::cout << "Ошибка парсера при проверке дифференцируемости: " << e.GetMsg() << std::endl;
+            report([&](auto& reporter) { reporter.insertMessage("Ошибка парсера при проверке дифференцируемости: "); });
             return Result::ParseError;
         }
         catch (const std::exception& e) {
             std::cout << "Общая ошибка при проверке дифференцируемости: " << e.what() << std::endl;
-            m_reporter->insertMessage("Общая ошибка при проверке дифференцируемости: ");
+            report([&](auto& reporter) { reporter.insertMessage("Общая ошибка при проверке дифференцируемости: "); });
             return Result::ComputeError;
         }
     }
@@ -431,239 +444,91 @@ private:
     // ОСНОВНЫЕ ВСПОМОГАТЕЛЬНЫЕ МЕТОДЫ
     // ============================================================================
 
-    // Вычисление функции в точке (x, y)
-    double evaluateFunction(double x, double y) {
-        m_x = x;
-        m_y = y;
-        m_function_calls++;
-        try {
-            return m_parser.Eval();
-        } catch (...) {
-            throw std::runtime_error("Ошибка вычисления функции в точке"); // отловить в solve()
-        }
-    }
-
-    // Вычисление частной производной по X
-    double partialDerivativeX(double x, double y) {
-        double x_old = m_x, y_old = m_y;
-        m_y = y; // Фиксируем y
-        double derivative = m_parser.Diff(&m_x, x, m_computationPrecision); // Вычисление частной производной по X из muParser
-        m_x = x_old;
-        m_y = y_old;
-        return derivative;
-    }
-    
-    // Вычисление частной производной по Y
-    double partialDerivativeY(double x, double y) {
-        double x_old = m_x, y_old = m_y;
-        m_x = x; // Фиксируем x
-        double derivative = m_parser.Diff(&m_y, y, m_computationPrecision); // Вычисление частной производной по Y из muParser
-        m_x = x_old;
-        m_y = y_old;
-        return derivative;
-    }
-
-    // Проверка сходимости
-    Result checkConvergence(double x_old, double y_old,
-        double x_new, double y_new,
-        double f_old, double f_new,
-        double& best_x, double& best_y, double& best_f) {
-
-        double dx = std::abs(x_new - x_old);
-        double dy = std::abs(y_new - y_old);
-        double df = std::abs(f_new - f_old);
-        double coordinate_norm = std::sqrt(dx * dx + dy * dy);
-
-        // ИСПОЛЬЗУЕМ ЧЛЕНЫ КЛАССА ВМЕСТО СТАТИЧЕСКИХ ПЕРЕМЕННЫХ
-        // Сохраняем последние 5 точек
-        m_recent_points.push_back({ x_new, y_new });
-        if (m_recent_points.size() > 5) {
-            m_recent_points.erase(m_recent_points.begin());
-        }
-
-        // Проверяем все возможные циклы в последних точках
-        if (m_recent_points.size() >= 4) {
-            bool found_cycle = false;
-            for (size_t i = 0; i < m_recent_points.size() - 2; ++i) {
-                for (size_t j = i + 1; j < m_recent_points.size() - 1; ++j) {
-                    double dist = std::sqrt(
-                        std::pow(m_recent_points[i].first - m_recent_points[j].first, 2) +
-                        std::pow(m_recent_points[i].second - m_recent_points[j].second, 2)
-                    );
-                    if (dist < m_computationPrecision) {
-                        m_oscillation_count++;
-                        found_cycle = true;
-                        break;
-                    }
-                }
-                if (found_cycle) break;
-            }
-
-            if (m_oscillation_count > 5) {
-                std::cout << "*** STOP: Oscillation detected after "
-                    << m_oscillation_count << " cycles ***" << std::endl;
-                m_reporter->insertMessage("СТОП: Обнаружена осцилляция после " + std::to_string(m_oscillation_count) + " циклов");
-
-                // ПРИНУДИТЕЛЬНО УСТАНАВЛИВАЕМ ЛУЧШУЮ ТОЧКУ
-                if (m_inputData->extremum_type == ExtremumType::MAXIMUM) {
-                    double max_f = best_f;
-                    for (const auto& point : m_recent_points) {
-                        double f_val = evaluateFunction(point.first, point.second);
-                        if (f_val > max_f) {
-                            max_f = f_val;
-                            best_x = point.first;
-                            best_y = point.second;
-                            best_f = f_val;
-                        }
-                    }
-                }
-                else {
-                    double min_f = best_f;
-                    for (const auto& point : m_recent_points) {
-                        double f_val = evaluateFunction(point.first, point.second);
-                        if (f_val < min_f) {
-                            min_f = f_val;
-                            best_x = point.first;
-                            best_y = point.second;
-                            best_f = f_val;
-                        }
-                    }
-                }
-                return Result::OscillationDetected;
-            }
-
-            if (!found_cycle) {
-                m_oscillation_count = 0; // сбрасываем счетчик если цикл прервался
-            }
-        }
-
-        // ОСНОВНОЙ КРИТЕРИЙ СХОДИМОСТИ
-        if (coordinate_norm < m_resultPrecision &&
-            df < m_resultPrecision) {
-
-            double current_f = evaluateFunction(x_new, y_new);
-            if ((m_inputData->extremum_type == ExtremumType::MAXIMUM && current_f > best_f) ||
-                (m_inputData->extremum_type == ExtremumType::MINIMUM && current_f < best_f)) {
-                best_x = x_new;
-                best_y = y_new;
-                best_f = current_f;
-            }
-
-            std::cout << "*** CONVERGENCE: Coordinates and function stabilized ***" << std::endl;
-            m_reporter->insertMessage("СХОДИМОСТЬ: Координаты и функция стабилизировалась");
-            return Result::Success;
-        }
-
-        return Result::Continue;
-    }
-
-    // Проверка границ (на каждой итерации)
-    bool isWithinBounds(double x, double y) {
-        return (x >= m_inputData->x_left_bound && x <= m_inputData->x_right_bound &&
-            y >= m_inputData->y_left_bound && y <= m_inputData->y_right_bound);
-    }
-
     // ============================================================================
-    // РЕАЛИЗАЦИИ ТИПОВ ШАГА
+    // СВЯЗЬ С SC::Descent
     // ============================================================================
 
-    // Постоянный шаг
-    double getConstantStep(double gradient, bool is_x) {
-        // Для минимума: двигаемся ПРОТИВ градиента
-        // Для максимума: двигаемся ПО градиенту
-        double direction = (m_inputData->extremum_type == ExtremumType::MINIMUM) ? -1.0 : 1.0;
-        double sign_gradient = (gradient > 0) ? 1.0 : (gradient < 0 ? -1.0 : 0.0);
-        double constant_step_size = is_x ? m_inputData->constant_step_size_x
-            : m_inputData->constant_step_size_y;
-
-        // Просто умножаем шаг на направление - знак градиента уже учтен в самом градиенте
-        return constant_step_size * direction * sign_gradient;
+    // Ход решения для SC::Descent: таблица шагов покоординатного спуска
+    struct Host {
+        CoordinateDescent *method;
+        int table = 0;
+
+        SC::Instrument<INSTRUMENTED>& instrument() { return method->m_instrument; }
+
+        template <typename Write>
+        void report(Write&& write) { method->report(std::forward<Write>(write)); }
+
+        void begin(const std::vector<double>&, double) {
+            method->report([&](auto& reporter) {
+                table = reporter.beginTable("Шаги базового покоординатного спуска",
+                    { "i", "x", "y", "f(x,y)", "∇f/∂x", "∇f/∂y", "Δx", "Δy" });
+            });
+        }
+
+        void row(const SC::Iterate& it) {
+            // Базовый спуск показывает лучшую точку, наискорейший — текущую
+            const bool basic = (method->m_inputData->algorithm_type == AlgorithmType::BASIC_COORDINATE_DESCENT);
+            const std::vector<double>& point = basic ? *it.best : *it.point;
+            const double f = basic ? it.bestValue : it.value;
+            const std::vector<double>& gradient = *it.gradient;
+            const std::vector<double>& steps = *it.steps;
+            method->report([&](auto& reporter) {
+                reporter.insertRow(table, { it.iteration,
+                                            method->roundComputation(point[0]),
+                                            method->roundComputation(point[1]),
+                                            method->roundComputation(f),
+                                            method->roundComputation(gradient[0]),
+                                            method->roundComputation(gradient[1]),
+                                            method->roundComputation(steps[0]),
+                                            method->roundComputation(steps[1])});
+            });
+        }
+
+        bool cancelled(int iterations, double best_f) {
+            method->m_iterations = iterations;
+            return method->cancelRequested(best_f);
+        }
+    };
+
+    // Итог SC::Descent: причина остановки, таблица хода решения и лучшая точка
+    struct Outcome {
+        SC::Stop stop;
+        int table;
+        double x, y, f;
+    };
+
+    // Решение SC::Descent для (x, y); run(descent) — метод спуска
+    template <typename Run>
+    Outcome descend(Run&& run) {
+        SC::DescentSettings settings;
+        settings.initial = { m_inputData->initial_x, m_inputData->initial_y };
+        settings.lower = { m_inputData->x_left_bound, m_inputData->y_left_bound };
+        settings.upper = { m_inputData->x_right_bound, m_inputData->y_right_bound };
+        settings.minimize = (m_inputData->extremum_type == ExtremumType::MINIMUM);
+        // Порядок StepType и LineSearchType совпадает с SC::StepRule и SC::LineSearchMethod
+        settings.lineSearch = static_cast<SC::LineSearchMethod>(m_inputData->line_search_type);
+        settings.coordinateSteps = {
+            { static_cast<SC::StepRule>(m_inputData->step_type_x),
+              m_inputData->constant_step_size_x, m_inputData->coefficient_step_size_x },
+            { static_cast<SC::StepRule>(m_inputData->step_type_y),
+              m_inputData->constant_step_size_y, m_inputData->coefficient_step_size_y } };
+        settings.maxIterations = m_inputData->max_iterations;
+        settings.maxFunctionCalls = m_inputData->max_function_calls;
+        settings.computationDigits = m_digitComputationPrecision;
+        settings.resultDigits = m_digitResultPrecision;
+        settings.oscillationLimit = 5;
+
+        SC::PlaneFunction<INSTRUMENTED> function{ m_objective };
+        Host host{ this };
+        SC::Descent<SC::PlaneFunction<INSTRUMENTED>, Host> descent{ function, host, settings };
+        const SC::Stop stop = run(descent);
+        m_iterations = descent.iterations();
+        return { stop, host.table, descent.best()[0], descent.best()[1], descent.bestValue() };
     }
 
-    // Коэффициентный шаг (зависимость от градиента)
-    double getCoefficientStep(double gradient, bool is_x) {
-        // Для минимума: двигаемся ПРОТИВ градиента  
-        // Для максимума: двигаемся ПО градиенту
-        double direction = (m_inputData->extremum_type == ExtremumType::MINIMUM) ? -1.0 : 1.0;
-
-        double coefficient_step_size = is_x ? m_inputData->coefficient_step_size_x
-            : m_inputData->coefficient_step_size_y;
-
-        // Градиент уже содержит правильный знак, просто умножаем на направление
-        return coefficient_step_size * gradient * direction;
-    }
-
-    // Адаптивный шаг
-    double getAdaptiveStep(double x, double y, double gradient, bool is_x) {
-        if (std::abs(gradient) < m_computationPrecision) {
-            return 0.0; // Нет смысла двигаться
-        }
-
-        double direction = (m_inputData->extremum_type == ExtremumType::MINIMUM) ? -1.0 : 1.0;
-        double base_step = is_x ? m_inputData->constant_step_size_x
-            : m_inputData->constant_step_size_y;
-
-        // 🔥 КЛЮЧЕВОЕ УЛУЧШЕНИЕ: масштабируем базовый шаг по градиенту
-        // Чем больше |gradient|, тем больше шаг (но не безгранично)
-        double scaled_step = base_step * std::min(10.0, std::max(0.1, std::abs(gradient)));
-
-        // Альтернатива: используем "единичный" шаг вдоль градиента, но ограничиваем
-        // double scaled_step = std::min(MAX_STEP, base_step * std::abs(gradient));
-
-        double current_value = evaluateFunction(x, y);
-        double best_delta = 0.0;
-        double best_value = current_value;
-        bool found_improvement = false;
-
-        // Пробуем шаги вокруг scaled_step
-        std::vector<double> multipliers = { 2.0, 1.0, 0.5, 0.2, 0.1 };
-        for (double mult : multipliers) {
-            double step_size = scaled_step * mult;
-            double delta = direction * step_size;
-            if (gradient < 0) delta = -delta; // коррекция направления
-
-            double x_new = is_x ? x + delta : x;
-            double y_new = is_x ? y : y + delta;
-
-            if (!isWithinBounds(x_new, y_new)) continue;
-
-            double new_value = evaluateFunction(x_new, y_new);
-            bool improvement = (m_inputData->extremum_type == ExtremumType::MINIMUM)
-                ? (new_value < best_value)
-                : (new_value > best_value);
-
-            if (improvement) {
-                best_value = new_value;
-                best_delta = delta;
-                found_improvement = true;
-            }
-        }
-
-        if (found_improvement) {
-            return best_delta;
-        }
-
-        // Если не улучшили — делаем tiny шаг в правильном направлении
-        double tiny_delta = direction * base_step * 0.001;
-        if (gradient < 0) tiny_delta = -tiny_delta;
-        return tiny_delta;
-    }
-
-    double getStepSize(double x, double y, double gradient, bool is_x) {
-        
-        StepType current_step_type = is_x ? m_inputData->step_type_x
-                                          : m_inputData->step_type_y;
-        
-        switch (current_step_type) {
-        case StepType::CONSTANT:
-            return getConstantStep(gradient, is_x);
-        case StepType::COEFFICIENT:
-            return getCoefficientStep(gradient, is_x);
-        case StepType::ADAPTIVE:
-            return getAdaptiveStep(x, y, gradient, is_x);
-        default:
-            return getConstantStep(gradient, is_x);
-        }
+    // Публикация хода решения; true — пользователь запросил отмену
+    bool cancelRequested(double best_f) {
+        return m_progress && m_progress->update(m_iterations, best_f, m_objective.calls());
     }
 
 // ============================================================================
@@ -671,280 +536,127 @@ private:
 // ============================================================================
 
     Result basicCoordinateDescent() {
-        double x = roundComputation(m_inputData->initial_x);
-        double y = roundComputation(m_inputData->initial_y);
-        double f_current = roundComputation(evaluateFunction(x, y));
-
-        auto iterationTable = m_reporter->beginTable("Шаги базового покоординатного спуска",
-            { "i", "x", "y", "f(x,y)", "∇f/∂x", "∇f/∂y", "Δx", "Δy" });
-
-        double best_x = roundComputation(x), best_y = roundComputation(y), best_f = roundComputation(f_current);
-        m_iterations = 0;
-
-        while (m_iterations < m_inputData->max_iterations &&
-            m_function_calls < m_inputData->max_function_calls) {
-
-            double x_old = roundComputation(x), y_old = roundComputation(y);
-            double f_old = roundComputation(f_current);
-
-            // === Шаг по X ===
-            double grad_x = roundComputation(partialDerivativeX(x, y));
-            double step_x = roundComputation(getStepSize(x, y, grad_x, true));
-            x = roundComputation(updateCoordinate(x, step_x, m_inputData->x_left_bound, m_inputData->x_right_bound));
-
-            // === Шаг по Y ===
-            double grad_y = roundComputation(partialDerivativeY(x, y));
-            double step_y = roundComputation(getStepSize(x, y, grad_y, false));
-            y = roundComputation(updateCoordinate(y, step_y, m_inputData->y_left_bound, m_inputData->y_right_bound));
+        const Outcome out = descend([](auto& descent) { return descent.basicCoordinate(); });
+
+        switch (out.stop) {
+        case SC::Stop::Cancelled:
+            m_x = roundResult(out.x);
+            m_y = roundResult(out.y);
+            report([&](auto& reporter) {
+                reporter.endTable(out.table);
+                reporter.insertMessage("Решение прервано пользователем.");
+            });
+            return Result::Cancelled;
+
+        case SC::Stop::OutOfBounds:
+            m_x = roundResult(out.x); m_y = roundResult(out.y);
+            report([&](auto& reporter) {
+                reporter.endTable(out.table);
+                reporter.insertMessage("Выход за границы области");
+            });
+            return Result::OutOfBounds;
+
+        case SC::Stop::Converged:
+        case SC::Stop::Oscillation:
+            m_x = roundResult(out.x); m_y = roundResult(out.y);
+            report([&](auto& reporter) {
+                reporter.endTable(out.table);
+                reporter.insertMessage(out.stop == SC::Stop::Converged
+                    ? "✅Сходимость достигнута"
+                    : "✅Алгоритм завершен: обнаружены осцилляции — возвращена лучшая точка");
+            });
+            ReporterResult(roundResult(out.x), roundResult(out.y), roundResult(out.f), m_objective.calls(), m_iterations);
+            return (out.stop == SC::Stop::Converged) ? Result::Success : Result::OscillationDetected;
 
-            f_current = roundComputation(evaluateFunction(x, y));
-            m_iterations++;
-
-            
-
-            // Обновление лучшей точки
-            bool improved = (m_inputData->extremum_type == ExtremumType::MINIMUM)
-                ? (f_current < best_f) : (f_current > best_f);
-            if (improved) {
-                best_x = roundComputation(x);
-                best_y = roundComputation(y);
-                best_f = roundComputation(f_current);
-            }
-            //m_reporter->insertRow(iterationTable, { m_iterations, x, y, f_current, grad_x, grad_y, step_x, step_y});
-            m_reporter->insertRow(iterationTable, { m_iterations, 
-                                                    roundComputation(best_x),
-                                                    roundComputation(best_y),
-                                                    roundComputation(best_f),
-                                                    roundComputation(grad_x),
-                                                    roundComputation(grad_y),
-                                                    roundComputation(step_x),
-                                                    roundComputation(step_y)});
-
-            // Проверка границ
-            if (!isWithinBounds(x, y)) {
-                m_x = roundResult(best_x); m_y = roundResult(best_y);
-                m_reporter->endTable(iterationTable);
-                m_reporter->insertMessage("Выход за границы области");
-                return Result::OutOfBounds;
-            }
-
-            // === КЛЮЧЕВОЙ ВЫЗОВ: ПРОВЕРКА СХОДИМОСТИ И ОСЦИЛЛЯЦИЙ ===
-            Result conv = checkConvergence(x_old, y_old, x, y, f_old, f_current, best_x, best_y, best_f);
-            if (conv != Result::Continue) {
-                m_x = roundResult(best_x); m_y = roundResult(best_y);
-                m_reporter->endTable(iterationTable);
-
-                switch (conv) {
-                case Result::Success:
-                    m_reporter->insertMessage("✅Сходимость достигнута");
-                    break;
-                case Result::OscillationDetected:
-                    m_reporter->insertMessage("✅Алгоритм завершен: обнаружены осцилляции — возвращена лучшая точка");
-                    break;
-                default:
-                    m_reporter->insertMessage("🔴Останов по коду: " + std::to_string(static_cast<int>(conv)));
-                    break;
-                }
-
-                ReporterResult(roundResult(best_x), roundResult(best_y), roundResult(best_f), m_function_calls, m_iterations);
-                m_reporter->insertResult(roundResult(best_x),
-                                         roundResult(best_y),
-                                         roundResult(best_f));
-                return conv;
-            }
+        default:
+            break;
         }
 
-        m_x = roundComputation(best_x); m_y = roundComputation(best_y);
-        m_reporter->endTable(iterationTable);
+        m_x = roundComputation(out.x); m_y = roundComputation(out.y);
+        report([&](auto& reporter) { reporter.endTable(out.table); });
         Result term = checkTerminationCondition();
-        ReporterResult(roundResult(best_x), roundResult(best_y), roundResult(best_f), m_function_calls, m_iterations);
-        m_reporter->insertResult(roundResult(best_x),
-                                 roundResult(best_y),
-                                 roundResult(best_f));
+        ReporterResult(roundResult(out.x), roundResult(out.y), roundResult(out.f), m_objective.calls(), m_iterations);
         return term;
     }
-    
-    Result steepestCoordinateDescent() {
-        double x = roundComputation(m_inputData->initial_x);
-        double y = roundComputation(m_inputData->initial_y);
-        double f_current = roundComputation(evaluateFunction(x, y));
-        auto iterationTable = m_reporter->beginTable("Шаги базового покоординатного спуска",
-            { "i", "x", "y", "f(x,y)", "∇f/∂x", "∇f/∂y", "Δx", "Δy" });
-
-        double best_x = roundComputation(x), best_y = roundComputation(y), best_f = roundComputation(f_current);
-        m_iterations = 0;
-
-        // Для отслеживания застревания
-        int consecutive_same_coordinate = 0;
-        bool last_was_x = false;
-
-        while (m_iterations < m_inputData->max_iterations &&
-            m_function_calls < m_inputData->max_function_calls) {
-
-            double x_old = roundComputation(x), y_old = roundComputation(y);
-            double f_old = roundComputation(f_current);
-
-            // Вычисление частных производных
-            double grad_x = roundComputation(partialDerivativeX(x, y));
-            double grad_y = roundComputation(partialDerivativeY(x, y));
-
-            // ИСПРАВЛЕНИЕ: Для наискорейшего спуска используем АБСОЛЮТНЫЕ значения градиентов
-            double abs_grad_x = roundComputation(std::abs(grad_x));
-            double abs_grad_y = roundComputation(std::abs(grad_y));
-
-            // Определяем, какую координату оптимизировать
-            bool optimize_x;
-
-            // Если одна координата сильно доминирует - выбираем её
-            if (abs_grad_x > 1.5 * abs_grad_y) {
-                optimize_x = true;
-                consecutive_same_coordinate = last_was_x ? consecutive_same_coordinate + 1 : 1;
-            }
-            else if (abs_grad_y > 1.5 * abs_grad_x) {
-                optimize_x = false;
-                consecutive_same_coordinate = last_was_x ? 1 : consecutive_same_coordinate + 1;
-            }
-            else {
-                // Градиенты близки - чередуем координаты чтобы избежать застревания
-                optimize_x = !last_was_x;
-                consecutive_same_coordinate = 0;
-            }
-
-            // Если долго оптимизируем одну координату - принудительно переключаемся
-            if (consecutive_same_coordinate > 5) {
-                optimize_x = !optimize_x;
-                consecutive_same_coordinate = 0;
-                std::cout << "*** FORCED SWITCH due to consecutive optimizations ***" << std::endl;
-            }
-
-            double step_x = 0.0;
-            double step_y = 0.0;
-            // Выполняем оптимизацию выбранной координаты
-            if (optimize_x) {
-                step_x = roundComputation(getStepSize(x, y, grad_x, true));
-                double x_new = roundComputation(updateCoordinate(x, step_x, m_inputData->x_left_bound, m_inputData->x_right_bound));
-
-                // Проверяем, что шаг действительно изменил координату
-                if (roundComputation(std::abs(x_new - x)) > m_computationPrecision) {
-                    x = roundComputation(x_new);
-                }
-                else {
-                    // Шаг слишком маленький - переключаемся на другую координату
-                    optimize_x = false;
-                    consecutive_same_coordinate = 0;
-                }
-            }
-
-            if (!optimize_x) {
-                step_y = roundComputation(getStepSize(x, y, grad_y, false));
-                double y_new = roundComputation(updateCoordinate(y, step_y, m_inputData->y_left_bound, m_inputData->y_right_bound));
-
-                // Проверяем, что шаг действительно изменил координату
-                if (roundComputation(std::abs(y_new - y)) > m_computationPrecision) {
-                    y = roundComputation(y_new);
-                }
-            }
-
-            last_was_x = optimize_x;
-            f_current = roundComputation(evaluateFunction(x, y));
-            m_iterations++;
-
-            // Обновление лучшей точки
-            bool improvement = (m_inputData->extremum_type == ExtremumType::MINIMUM)
-                ? (f_current < best_f)
-                : (f_current > best_f);
-
-            if (improvement) {
-                best_x = roundComputation(x);
-                best_y = roundComputation(y);
-                best_f = roundComputation(f_current);
-            }
-            m_reporter->insertRow(iterationTable, {
-                                  m_iterations, 
-                                  roundComputation(x),
-                                  roundComputation(y),
-                                  roundComputation(f_current),
-                                  roundComputation(grad_x),
-                                  roundComputation(grad_y),
-                                  roundComputation(step_x),
-                                  roundComputation(step_y)});
-            // Отладочный вывод
-            /*std::cout << "Итерация " << m_iterations
-                << ": grad_x=" << grad_x << " (abs=" << abs_grad_x
-                << "), grad_y=" << grad_y << " (abs=" << abs_grad_y
-                << "), выбрана " << (optimize_x ? "X" : "Y")
-                << ", x=" << x << ", y=" << y << ", f=" << f_current
-                << std::endl;*/
-            
-            if (!isWithinBounds(x, y)) {
-                m_x = roundResult(best_x);
-                m_y = roundResult(best_y);
-                return Result::OutOfBounds;
-            }
 
-            // === КЛЮЧЕВОЙ ВЫЗОВ: ПРОВЕРКА СХОДИМОСТИ И ОСЦИЛЛЯЦИЙ ===
-            Result conv = checkConvergence(x_old, y_old, x, y, f_old, f_current, best_x, best_y, best_f);
-            if (conv != Result::Continue) {
-                m_x = roundResult(best_x); roundResult(m_y = best_y);
-                m_reporter->endTable(iterationTable);
-
-                switch (conv) {
-                case Result::Success:
-                    m_reporter->insertMessage("✅Сходимость достигнута.");
-                    break;
-                case Result::OscillationDetected:
-                    m_reporter->insertMessage("✅Алгоритм завершен: обнаружены осцилляции — возвращена лучшая точка");
-                    break;
-                default:
-                    m_reporter->insertMessage("🔴Останов по коду: " + std::to_string(static_cast<int>(conv)));
-                    break;
-                }
+    Result steepestCoordinateDescent() {
+        const Outcome out = descend([](auto& descent) { return descent.steepestCoordinate(); });
+
+        switch (out.stop) {
+        case SC::Stop::Cancelled:
+            m_x = roundResult(out.x);
+            m_y = roundResult(out.y);
+            report([&](auto& reporter) {
+                reporter.endTable(out.table);
+                reporter.insertMessage("Решение прервано пользователем.");
+            });
+            return Result::Cancelled;
+
+        case SC::Stop::OutOfBounds:
+            m_x = roundResult(out.x);
+            m_y = roundResult(out.y);
+            return Result::OutOfBounds;
+
+        case SC::Stop::Converged:
+        case SC::Stop::Oscillation:
+            m_x = roundResult(out.x); roundResult(m_y = out.y);
+            report([&](auto& reporter) {
+                reporter.endTable(out.table);
+                reporter.insertMessage(out.stop == SC::Stop::Converged
+                    ? "✅Сходимость достигнута."
+                    : "✅Алгоритм завершен: обнаружены осцилляции — возвращена лучшая точка");
+            });
+            ReporterResult(roundResult(out.x), roundResult(out.y), roundResult(out.f), m_objective.calls(), m_iterations);
+            return (out.stop == SC::Stop::Converged) ? Result::Success : Result::OscillationDetected;
 
-                ReporterResult(roundResult(best_x), roundResult(best_y), roundResult(best_f), m_function_calls, m_iterations);
-                m_reporter->insertResult(roundResult(best_x),
-                                         roundResult(best_y),
-                                         roundResult(best_f));
-                return conv;
-            }
-            
-            
+        default:
+            break;
         }
-        m_x = roundResult(best_x); m_y = roundResult(best_y);
-        m_reporter->endTable(iterationTable);
+
+        m_x = roundResult(out.x); m_y = roundResult(out.y);
+        report([&](auto& reporter) { reporter.endTable(out.table); });
         Result term = checkTerminationCondition();
-        ReporterResult(roundResult(best_x), roundResult(best_y), roundResult(best_f), m_function_calls, m_iterations);
-        m_reporter->insertResult(roundResult(best_x),
-                                 roundResult(best_y),
-                                 roundResult(best_f));
+        ReporterResult(roundResult(out.x), roundResult(out.y), roundResult(out.f), m_objective.calls(), m_iterations);
         return term;
     }
 
-    // Обновление координаты с учётом границ
-    double updateCoordinate(double coord, double step,
-                            double lower_bound, double upper_bound) {
-        double new_coord = coord + step;
-        return std::max(lower_bound, std::min(upper_bound, new_coord));
-    }
-
     // Проверка условий завершения
     Result checkTerminationCondition() {
         if (m_iterations >= m_inputData->max_iterations) {
-            m_reporter->insertMessage("Достигнуто максимальное количество итераций");
+            report([&](auto& reporter) { reporter.insertMessage("Достигнуто максимальное количество итераций"); });
             return Result::MaxIterations;
         }
-        if (m_function_calls >= m_inputData->max_function_calls) {
-            m_reporter->insertMessage("Достигнуто максимальное количество вызовов функции");
+        if (m_objective.calls() >= m_inputData->max_function_calls) {
+            report([&](auto& reporter) {
+                reporter.insertMessage("Достигнуто максимальное количество вызовов функции");
+            });
             return Result::MaxFunctionsCalls;
         }
         return Result::Success;
     }
 
+    // Запись в отчёт под замером фазы Reporter. write(reporter) — обобщённая лямбда:
+    // с выключенной отчётностью она не вызывается и не инстанцируется, поэтому строки
+    // таблиц и сообщения не строятся, а Reporter может не иметь этих методов
+    template <typename Write>
+    void report(Write&& write) {
+        if constexpr (REPORTING) {
+            const auto reporting = m_instrument.scope(SC::Phase::Reporter);
+            write(*m_reporter);
+        }
+    }
+
     void ReporterResult(double best_x, double best_y, double best_f, int m_function_calls, int m_iterations) {
         
-        m_reporter->insertMessage("Итого:");
-        m_reporter->insertMessage("Количество итераций: " + std::to_string(m_iterations));
-        m_reporter->insertMessage("Количество вызовов функции: " + std::to_string(m_function_calls));
-        m_reporter->insertResult(best_x, best_y, best_f);
+        report([&](auto& reporter) {
+            reporter.insertMessage("Итого:");
+            reporter.insertMessage("Количество итераций: " + std::to_string(m_iterations));
+            reporter.insertMessage("Количество вызовов функции: " + std::to_string(m_objective.calls()));
+        });
+        // Найденная точка — один раз за solve(), на выходе из метода (до end())
+        if constexpr (SC::reporterWantsResult<Reporter>) {
+            m_reporter->insertResult(best_x, best_y, best_f);
+        }
     }
 
     //Считает количество знаков после запятой
@@ -13,12 +13,6 @@
 
 
 using namespace CD;
-// Класс-заглушка - реализовывать не нужно!
-class MockReporter {
-public:
-	int begin() { return 0; } // Возвращаем 1, чтобы обойти проверку в solve() (предполагаем опечатку в условии ==0)
-	int end() { return 0; } // Возвращаем 0, чтобы solve() вернул Success при успешном завершении
-};
 double MySqr(double a_fVal) { return a_fVal * a_fVal; }
 void testMuparser()
 {
@@ -96,8 +90,8 @@ int main()
 	// SetConsoleCP(1251);
 	// setlocale(LC_ALL, "Russian");
 	// testMuparser(); // Можно закомментировать, если не нужен
-	using AlgoType = CoordinateDescent<MockReporter>;
-	MockReporter reporter{};
+	using AlgoType = CoordinateDescent<SC::NullReporter>;
+	SC::NullReporter reporter{};
 	AlgoType algo{ &reporter };
 	InputData data{};
 	// Ввод данных от пользователя
@@ -44,7 +44,8 @@ enum class Result : int {
     InvalidConstantStepSizeY = -25,     // Неверный ввод постоянного шага Y
     InvalidCoefficientStepSizeY = -26,  // Неверный ввод коэффициентного шага Y
     OscillationDetected = -29,         // Найдены осцилляции
-    Continue = -30                     // Продолжать итераци
+    Continue = -30,                    // Продолжать итераци
+    Cancelled = -31                    // Решение отменено пользователем
 };
 
 // Тип алгоритма оптимизации
@@ -67,6 +68,21 @@ enum class StepType {
     ADAPTIVE     // Адаптивный шаг:     step подбирается автоматически на каждой итерации
 };
 
+// Способ одномерного поиска шага
+enum class LineSearchType {
+    SEQUENTIAL, // Вычисления по одной точке (метод Брента, дробление шага)
+    BATCHED,    // Пакетная сетка и параболические уточнения (SC::gridLineSearch)
+    GOLDEN,     // Как SEQUENTIAL, но золотое сечение вместо метода Брента (для сравнения)
+    WOLFE       // Сильные условия Вольфе по значению и градиенту (наискорейший спуск, сопряжённые градиенты)
+};
+
+// Способ вычисления целевой функции (см. SC::Backend)
+enum class EvaluatorType {
+    MUPARSER, // Байткод muParser (по умолчанию)
+    TAPE,     // Регистровая лента инструкций
+    NATIVE    // Машинный код, собранный системным компилятором (откат на TAPE)
+};
+
 // ============================================================================
 // Структуры входных данных
 // ============================================================================
@@ -112,6 +128,10 @@ struct InputData {
     int max_iterations = 1000;       // Макс. число итераций
     int max_function_calls = 10000;  // Макс. число вызовов функции
 
+    // --- ВЫЧИСЛЕНИЕ ---
+    EvaluatorType evaluator_type = EvaluatorType::MUPARSER; // Способ вычисления функции
+    LineSearchType line_search_type = LineSearchType::SEQUENTIAL; // Способ поиска шага
+
 
 };
 
@@ -160,6 +180,7 @@ inline std::string resultToString(Result result) {
     case Result::InvalidConstantStepSize:       return "Неверный ввод постоянного шага";
     case Result::InvalidCoefficientStepSize:    return "Неверный ввод коэффициентного шага";
     case Result::OscillationDetected:           return "Обнаружены осцилляции";
+    case Result::Cancelled:                     return "Решение отменено";
     default:                                    return "Неизвестная ошибка";
     }
 }
@@ -10,13 +10,6 @@
 #include <string>
 
 using namespace GD;
-// Класс-заглушка - реализовывать не нужно!
-class MockReporter {
-public:
-    int begin() { return 0; } // Возвращаем 0
-    int end() { return 0; } // Возвращаем 0, чтобы solve() вернул Success при успешном завершении
-};
-
 double MySqr(const double a_fVal) { return a_fVal * a_fVal; }
 
 // Конвертация типа шага в строку
@@ -72,8 +65,8 @@ StepType stringToStepType(const std::string& str) {
 int main()
 {
 
-    using AlgoType = GradientDescent<MockReporter>;
-    MockReporter reporter{};
+    using AlgoType = GradientDescent<SC::NullReporter>;
+    SC::NullReporter reporter{};
     AlgoType algo{ &reporter };
     InputData data{};
 
@@ -1,3 +1,5 @@
+pragma ComponentBehavior: Bound
+
 import QtQuick
 import QtQuick.Controls
 import QtQuick.Layouts
@@ -7,19 +9,22 @@ Loader {
     id: root 
 
     required property string title
-    required property var columns
-    required property var rows
+    required property var table   // SolutionTableModel
 
-    property int rowsCnt: rows.length
     property int fontSize: 14
+    property int cellWidth: 150
+    property int padding: 8
+    property int cellHeight: fontSize + padding * 2
+    // The table scrolls inside the report, only the visible rows get delegates
+    property int maxVisibleRows: 20
 
     sourceComponent: Item {
 
-        implicitWidth: tableView.implicitWidth
-        implicitHeight: tableView.implicitHeight
+        implicitWidth: layout.implicitWidth
+        implicitHeight: layout.implicitHeight
 
         ColumnLayout {
-            id: tableView
+            id: layout
             anchors.fill: parent
 
             spacing: 0
@@ -31,28 +36,67 @@ Loader {
                 bottomPadding: 5
             }
 
-            TableRow {
-                rowData: root.columns;
-                header: true;
-                fontSize: root.fontSize;
+            HorizontalHeaderView {
+                id: header
+                syncView: tableView
+                clip: true
+                Layout.preferredWidth: tableView.Layout.preferredWidth
+
+                delegate: Rectangle {
+                    required property var display
+
+                    implicitWidth: root.cellWidth
+                    implicitHeight: headerText.implicitHeight + root.padding * 2
+                    color: "transparent"
+                    border.color: "gray"
+
+                    Text {
+                        id: headerText
+                        anchors.centerIn: parent
+                        width: root.cellWidth - root.padding * 2
+                        text: parent.display
+                        font.pixelSize: root.fontSize
+                        font.bold: true
+                        wrapMode: Text.Wrap
+                        horizontalAlignment: Text.AlignHCenter
+                    }
+                }
             }
 
-            Repeater {
-                id: content
-                
-                model: root.rows
+            TableView {
+                id: tableView
 
-                delegate: Item {
-                    implicitHeight: row.implicitHeight
-                    implicitWidth: row.implicitWidth
+                Layout.preferredWidth: root.table ? root.table.columns * root.cellWidth : 0
+                Layout.preferredHeight: root.table
+                    ? Math.min(root.table.rows, root.maxVisibleRows) * root.cellHeight : 0
 
-                    TableRow{
-                        id: row
-                        rowData: modelData
-                        header: false
-                        fontSize: root.fontSize;
+                model: root.table
+                clip: true
+                boundsBehavior: Flickable.StopAtBounds
+                columnWidthProvider: function() { return root.cellWidth }
+                rowHeightProvider: function() { return root.cellHeight }
+
+                delegate: Rectangle {
+                    required property var display
+
+                    implicitWidth: root.cellWidth
+                    implicitHeight: root.cellHeight
+                    color: "transparent"
+                    border.color: "gray"
+
+                    Text {
+                        anchors.centerIn: parent
+                        width: root.cellWidth - root.padding * 2
+                        text: parent.display
+                        font.pixelSize: root.fontSize
+                        elide: Text.ElideRight
+                        horizontalAlignment: Text.AlignHCenter
                     }
-                } 
+                }
+
+                ScrollBar.vertical: ScrollBar {
+                    policy: (tableView.contentHeight > tableView.height) ? ScrollBar.AlwaysOn : ScrollBar.AlwaysOff
+                }
             }
         }
 
@@ -211,8 +211,7 @@ Rectangle {
                         required property string title
                         required property string text
                         required property double value
-                        required property var columns
-                        required property var rows
+                        required property var table
 
                         implicitWidth: (valueLoader.active 
                             ? valueLoader.implicitWidth : messageLoader.active
@@ -251,8 +250,7 @@ Rectangle {
                             anchors.centerIn: parent
 
                             title: container.title
-                            columns: container.columns
-                            rows: container.rows
+                            table: container.table
 
                             fontSize: root.fontSize
                         }
@@ -291,6 +289,14 @@ Rectangle {
                 }
             }
 
+            StyledButton {
+                id: convertBtn
+                text: root.report.fileName.endsWith(".cbor") ? "Сохранить в JSON" : "Сохранить в CBOR"
+                onReleased: {
+                    controller.convertReport(root.report.fileName)
+                }
+            }
+
             StyledButton {
                 id: deleteBtn
                 text: "Удалить"
@@ -11,6 +11,15 @@ Rectangle {
 
     color: AppPalette.background
 
+    Connections {
+        target: controller
+        function onSolveProgress(iteration, bestValue, evalsPerSecond) {
+            progressLabel.text = "Итерация " + iteration
+                + ", f = " + bestValue.toPrecision(8)
+                + ", " + Math.round(evalsPerSecond) + " выч./с";
+        }
+    }
+
     ColumnLayout {
         id: column
         anchors.fill: parent
@@ -101,6 +110,68 @@ Rectangle {
             Layout.preferredWidth: (parent.width * 0.9)
         }
 
+        StyledComboBox {
+            id: reportFormat
+
+            Layout.alignment: Qt.AlignRight
+            Layout.rightMargin: ((parent.width * 0.05) + 10)
+            Layout.preferredWidth: 200
+
+            model: [
+                { value: ReportFormat.JSON, text: "Отчет в JSON" },
+                { value: ReportFormat.CBOR, text: "Отчет в CBOR (компактный)" }
+            ]
+
+            textRole: "text"
+            valueRole: "value"
+            enabled: !controller.solving
+            Component.onCompleted: currentIndex = indexOfValue(controller.reportFormat)
+            onActivated: controller.reportFormat = currentValue
+        }
+
+        RowLayout {
+            Layout.alignment: Qt.AlignRight
+            Layout.rightMargin: ((parent.width * 0.05) + 10)
+
+            spacing: 10
+
+            StyledComboBox {
+                id: rowPolicy
+                Layout.preferredWidth: 250
+
+                model: [
+                    { value: RowPolicy.ALL, text: "Все итерации" },
+                    { value: RowPolicy.EVERY_NTH, text: "Каждая N-я итерация" },
+                    { value: RowPolicy.LOG_SPACED, text: "N итераций на декаду" },
+                    { value: RowPolicy.IMPROVING, text: "Только улучшающие f" },
+                    { value: RowPolicy.FIRST_LAST, text: "Первые и последние N" }
+                ]
+
+                textRole: "text"
+                valueRole: "value"
+                enabled: !controller.solving
+                Component.onCompleted: currentIndex = indexOfValue(controller.rowPolicy)
+                onActivated: controller.rowPolicy = currentValue
+            }
+
+            StyledTextField {
+                Layout.preferredWidth: 100
+                boxed: true
+                text: controller.rowPolicyParameter
+                visible: controller.rowPolicy !== RowPolicy.ALL
+                         && controller.rowPolicy !== RowPolicy.IMPROVING
+                enabled: !controller.solving
+
+                validator: IntValidator { bottom: 1 }
+
+                onTextEdited: {
+                    if (acceptableInput) {
+                        controller.rowPolicyParameter = parseInt(text);
+                    }
+                }
+            }
+        }
+
         StyledButton {
             id: solveBtn
 
@@ -108,7 +179,8 @@ Rectangle {
             Layout.rightMargin: ((parent.width * 0.05) + 10)
 
             text: "Решить"
-            enabled: inputParams.valid && func.accepted
+            enabled: inputParams.valid && func.accepted && !controller.solving
+            visible: !controller.solving
 
             onReleased: {
                 inputParams.inputData.function = func.text;
@@ -119,11 +191,42 @@ Rectangle {
                 if (rv !== 0) {
                     return;
                 }
+                progressLabel.text = "Решение...";
                 controller.solve();
-                controller.updateQuickInfoModel();
             }
         }
 
+        RowLayout {
+            id: progressRow
+
+            Layout.alignment: Qt.AlignRight
+            Layout.rightMargin: ((parent.width * 0.05) + 10)
+
+            spacing: 10
+            visible: controller.solving
+
+            Label {
+                id: progressLabel
+                text: ""
+            }
+
+            StyledButton {
+                id: cancelBtn
+                text: "Отменить"
+                onReleased: controller.cancelSolve()
+            }
+        }
+
+        Label {
+            id: savingLabel
+
+            Layout.alignment: Qt.AlignRight
+            Layout.rightMargin: ((parent.width * 0.05) + 10)
+
+            text: "Сохранение отчетов: " + controller.pendingReports
+            visible: controller.pendingReports > 0
+        }
+
         Label {
             id: reportListLabel
             Layout.leftMargin: (parent.width * 0.05) + 10
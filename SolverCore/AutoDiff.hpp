@@ -0,0 +1,66 @@
+#ifndef SOLVERCORE_AUTODIFF_HPP_
+#define SOLVERCORE_AUTODIFF_HPP_
+
+#include <SolverCore/CompiledExpressionCache.hpp>
+#include <string>
+
+namespace SC {
+
+/**
+ * Градиент функции двух переменных прямым режимом автоматического
+ * дифференцирования. Значение и обе частные производные считаются за один
+ * проход по выражению; результат для последней точки кешируется, поэтому
+ * пара вызовов dx()/dy() в одной точке стоит одного вычисления.
+ *
+ * Если выражение не поддерживается движком, enabled() == false и методы
+ * должны использовать численное дифференцирование muParser.
+ */
+class AutoDiff {
+public:
+
+    // Копия разобранного выражения: рабочие буферы у каждого экземпляра свои
+    bool init(const CompiledExpression &compiled)
+    {
+        m_hasCache = false;
+        m_enabled = compiled.parsed();
+        if (m_enabled) {
+            m_expression = compiled.expression();
+        }
+        return m_enabled;
+    }
+
+    bool init(const std::string &function)
+    {
+        return init(*CompiledExpressionCache::shared().get(function));
+    }
+
+    bool enabled() const { return m_enabled; }
+    const Expression &expression() const { return m_expression; }
+
+    const Dual &at(double x, double y)
+    {
+        if (!m_hasCache || x != m_cacheX || y != m_cacheY) {
+            m_cache = m_expression.gradient(x, y);
+            m_cacheX = x;
+            m_cacheY = y;
+            m_hasCache = true;
+        }
+        return m_cache;
+    }
+
+    double dx(double x, double y) { return at(x, y).dx; }
+    double dy(double x, double y) { return at(x, y).dy; }
+
+private:
+
+    Expression m_expression;
+    bool m_enabled = false;
+    bool m_hasCache = false;
+    double m_cacheX = 0.0;
+    double m_cacheY = 0.0;
+    Dual m_cache{ 0.0, 0.0, 0.0 };
+};
+
+} // namespace SC
+
+#endif // SOLVERCORE_AUTODIFF_HPP_
@@ -0,0 +1,239 @@
+#ifndef SOLVERCORE_COMPILEDEXPRESSIONCACHE_HPP_
+#define SOLVERCORE_COMPILEDEXPRESSIONCACHE_HPP_
+
+#include <SolverCore/Expression.hpp>
+#include <SolverCore/NativeFunction.hpp>
+#include <SolverCore/Tape.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace SC {
+
+// Функции, из-за которых выражение считается недифференцируемым
+inline const std::vector<std::string> &nonDifferentiableTokens()
+{
+    static const std::vector<std::string> tokens = {
+        "abs(", "|", "sign(", "floor(", "ceil(", "round(",
+        "fmod(", "mod(", "rand(", "max(", "min(", "random"
+    };
+    return tokens;
+}
+
+// Ключ кеша: пробелы по краям убираются, подряд идущие — сводятся к одному
+inline std::string normalizeExpression(const std::string &text)
+{
+    std::string out;
+    out.reserve(text.size());
+    bool space = false;
+    for (char c : text) {
+        if (std::isspace(static_cast<unsigned char>(c))) {
+            space = !out.empty();
+            continue;
+        }
+        if (space) {
+            out += ' ';
+            space = false;
+        }
+        out += c;
+    }
+    return out;
+}
+
+/**
+ * Всё, что зависит только от текста функции: разобранное выражение,
+ * скомпилированная лента, машинный код (собирается при первом запросе)
+ * и результаты статических проверок. После создания не меняется, кроме
+ * отложенных полей, поэтому один экземпляр читают все потоки.
+ *
+ * Expression и Tape держат рабочие буферы, поэтому вычисляют не сами
+ * прототипы, а их копии — по одной у каждого метода (AutoDiff, Evaluator).
+ */
+class CompiledExpression {
+public:
+
+    explicit CompiledExpression(const std::string &text)
+        : m_text{ text }
+        , m_expression{}
+        , m_parsed{ false }
+        , m_tape{}
+        , m_hasTape{ false }
+        , m_nonDifferentiable{}
+        , m_syntax{ UNKNOWN }
+        , m_nativeOnce{}
+        , m_native{}
+        , m_nativeLoaded{ false }
+    {
+        m_parsed = m_expression.parse(text);
+        m_hasTape = m_parsed && m_tape.compile(m_expression);
+
+        std::string lower = text;
+        std::transform(lower.begin(), lower.end(), lower.begin(), ::tolower);
+        for (const std::string &token : nonDifferentiableTokens()) {
+            if (lower.find(token) != std::string::npos) {
+                m_nonDifferentiable = token;
+                break;
+            }
+        }
+    }
+
+    CompiledExpression(const CompiledExpression &) = delete;
+    CompiledExpression &operator=(const CompiledExpression &) = delete;
+
+    const std::string &text() const { return m_text; }
+
+    // Разбор SC::Expression (для AutoDiff и Tape); false — только muParser
+    bool parsed() const { return m_parsed; }
+    const Expression &expression() const { return m_expression; }
+    bool hasTape() const { return m_hasTape; }
+    const Tape &tape() const { return m_tape; }
+
+    // Первая найденная недифференцируемая функция или пустая строка
+    const std::string &nonDifferentiable() const { return m_nonDifferentiable; }
+
+    // Проверка синтаксиса muParser'ом: делает её первый метод, остальные берут результат
+    bool syntaxChecked() const { return m_syntax.load(std::memory_order_acquire) != UNKNOWN; }
+    bool syntaxValid() const { return m_syntax.load(std::memory_order_acquire) == VALID; }
+    void setSyntaxValid(bool valid) const { m_syntax.store(valid ? VALID : INVALID, std::memory_order_release); }
+
+    // Машинный код: собирается один раз на первый запрос, копии делят библиотеку
+    const NativeFunction &native() const
+    {
+        std::call_once(m_nativeOnce, [this] {
+            m_nativeLoaded = m_parsed && m_native.compile(m_expression);
+        });
+        return m_native;
+    }
+    bool nativeLoaded() const
+    {
+        native();
+        return m_nativeLoaded;
+    }
+
+private:
+
+    static constexpr int UNKNOWN = -1;
+    static constexpr int INVALID = 0;
+    static constexpr int VALID = 1;
+
+    std::string m_text;
+    Expression m_expression;
+    bool m_parsed;
+    Tape m_tape;
+    bool m_hasTape;
+    std::string m_nonDifferentiable;
+    mutable std::atomic<int> m_syntax;
+    mutable std::once_flag m_nativeOnce;
+    mutable NativeFunction m_native;
+    mutable bool m_nativeLoaded;
+};
+
+/**
+ * Общий для всех методов и потоков кеш проверок и скомпилированных
+ * представлений функций (CompiledExpression) по нормализованному тексту:
+ * разбор SC::Expression, лента, машинный код, найденная недифференцируемая
+ * функция и итог проверки синтаксиса muParser'ом.
+ *
+ * Байткода muParser здесь нет: копия mu::Parser байткод не переносит и
+ * разбирает строку заново при первом Eval(), поэтому у каждого метода свой
+ * парсер, в который функция загружается один раз (SC::Objective).
+ *
+ * Записи — shared_ptr, поэтому вытеснение из кеша не трогает функции,
+ * с которыми методы ещё работают. Хранится не больше capacity последних
+ * функций.
+ */
+class CompiledExpressionCache {
+public:
+
+    static constexpr size_t DEFAULT_CAPACITY = 64;
+
+    explicit CompiledExpressionCache(size_t capacity = DEFAULT_CAPACITY)
+        : m_mutex{}
+        , m_entries{}
+        , m_order{}
+        , m_capacity{ std::max<size_t>(capacity, 1) }
+        , m_hits{ 0 }
+        , m_misses{ 0 }
+    {
+    }
+
+    static CompiledExpressionCache &shared()
+    {
+        static CompiledExpressionCache cache;
+        return cache;
+    }
+
+    std::shared_ptr<const CompiledExpression> get(const std::string &function)
+    {
+        const std::string key = normalizeExpression(function);
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            auto it = m_entries.find(key);
+            if (it != m_entries.end()) {
+                m_order.splice(m_order.begin(), m_order, it->second.position);
+                ++m_hits;
+                return it->second.compiled;
+            }
+            ++m_misses;
+        }
+
+        // Разбор и компиляция — без блокировки; если два потока разобрали
+        // одну функцию одновременно, в кеше остаётся первая запись
+        auto compiled = std::make_shared<const CompiledExpression>(key);
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_entries.find(key);
+        if (it != m_entries.end()) {
+            return it->second.compiled;
+        }
+        m_order.push_front(key);
+        m_entries.emplace(key, Entry{ compiled, m_order.begin() });
+        while (m_entries.size() > m_capacity) {
+            m_entries.erase(m_order.back());
+            m_order.pop_back();
+        }
+        return compiled;
+    }
+
+    size_t hits() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_hits;
+    }
+    size_t misses() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_misses;
+    }
+
+    void clear()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_entries.clear();
+        m_order.clear();
+    }
+
+private:
+
+    struct Entry {
+        std::shared_ptr<const CompiledExpression> compiled;
+        std::list<std::string>::iterator position; // Место в m_order
+    };
+
+    mutable std::mutex m_mutex;
+    std::unordered_map<std::string, Entry> m_entries;
+    std::list<std::string> m_order; // От недавно использованных к давним
+    size_t m_capacity;
+    size_t m_hits;
+    size_t m_misses;
+};
+
+} // namespace SC
+
+#endif // SOLVERCORE_COMPILEDEXPRESSIONCACHE_HPP_
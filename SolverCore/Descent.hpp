@@ -0,0 +1,985 @@
+#ifndef SOLVERCORE_DESCENT_HPP_
+#define SOLVERCORE_DESCENT_HPP_
+
+#include <SolverCore/Instrument.hpp>
+#include <SolverCore/LineSearch.hpp>
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+namespace SC {
+
+// Тип шага; порядок совпадает с StepType методов
+enum class StepRule {
+    Constant = 0,    // Постоянный шаг
+    Coefficient = 1, // Шаг, пропорциональный производной
+    Adaptive = 2     // Шаг подбирается на каждой итерации
+};
+
+// Одномерный поиск шага; порядок совпадает с LineSearchType методов
+enum class LineSearchMethod {
+    Sequential = 0, // Брент (GD, CG), последовательный перебор шагов (CD)
+    Batched = 1,    // Пакетные вычисления
+    Golden = 2,     // Золотое сечение
+    Wolfe = 3       // Сильные условия Вольфе
+};
+
+// Почему остановился метод
+enum class Stop {
+    Converged,     // Координаты и функция стабилизировались
+    Oscillation,   // Обнаружены осцилляции — лучшая точка из последних
+    OutOfBounds,   // Точка вышла за границы
+    SmallGradient, // Градиент меньше точности вычислений
+    Cancelled,     // Отмена пользователем
+    Limits         // Исчерпаны итерации или вызовы функции
+};
+
+// Шаг: правило и его параметры
+struct StepSize {
+    StepRule rule = StepRule::Constant;
+    double constant = 0.1;    // Постоянный шаг; начальный шаг адаптивного и запасной шаг поиска
+    double coefficient = 0.1; // Коэффициент шага
+};
+
+// Настройки решения. Векторы — по переменным функции
+struct DescentSettings {
+    std::vector<double> initial;
+    std::vector<double> lower;
+    std::vector<double> upper;
+    bool minimize = true;
+    LineSearchMethod lineSearch = LineSearchMethod::Sequential;
+    StepSize step;                        // Шаг градиентных методов
+    std::vector<StepSize> coordinateSteps; // Шаги покоординатного спуска, по переменным
+    int maxIterations = 1000;
+    int maxFunctionCalls = 10000;
+    int computationDigits = 15;           // Знаков после запятой в вычислениях
+    int resultDigits = 8;                 // Знаков после запятой в результате
+    int oscillationLimit = 3;             // Сколько циклов подряд считать осцилляцией
+};
+
+// Данные итерации для таблицы хода решения; метод выбирает нужные столбцы
+struct Iterate {
+    int iteration = 0;
+    const std::vector<double> *point = nullptr;    // Точка после шага
+    double value = 0.0;                            // f в ней (округлённое)
+    const std::vector<double> *gradient = nullptr; // Градиент (округлённый): в начале шага, у CG — в новой точке
+    double gradientNorm = 0.0;                     // Норма градиента (у CG — корень из ||g||^2)
+    const std::vector<double> *best = nullptr;     // Лучшая точка
+    double bestValue = 0.0;
+    const std::vector<double> *steps = nullptr;    // Шаги по координатам (CD)
+    double step = 0.0;                             // Шаг вдоль направления
+    double beta = 0.0;                             // Коэффициент Флетчера — Ривса (CG)
+    double ravineFactor = 0.0;                     // Признак оврага (овражный метод)
+};
+
+/**
+ * Методы спуска для функции любого числа переменных: покоординатный
+ * (базовый и наискорейший), градиентный (с заданным шагом, наискорейший,
+ * овражный) и сопряжённых градиентов. Состояние — векторы по переменным,
+ * границы — свои у каждой переменной. Двумерные методы (GD, CD, CG) —
+ * частный случай: n == 2, и формулы записаны так, что при n == 2 все
+ * вычисления побитово совпадают с прежними формулами для (x, y).
+ *
+ * Function — функция точки (PlaneFunction, VectorFunction):
+ *   size_t size(); int calls();
+ *   double value(const double *point);
+ *   double gradient(const double *point, double *gradient) — значение и градиент;
+ *   double derivative(const double *point, size_t index);
+ *   void valueBatch(const double *points, double *values, int n) — n точек подряд.
+ *
+ * Host — метод, который показывает ход решения:
+ *   Instrument<I> &instrument();
+ *   template <typename Write> void report(Write &&write) — как report() методов;
+ *   void begin(const std::vector<double> &point, double value) — начало таблицы;
+ *   void row(const Iterate &iterate);
+ *   bool cancelled(int iterations, double bestValue) — ход решения и флаг отмены.
+ *
+ * Методы возвращают причину остановки; сообщения об итоге, таблицу и
+ * найденную точку метода оформляет Host. Лучшая точка и значение в ней —
+ * best() и bestValue() (округлены до точности вычислений).
+ */
+template <typename Function, typename Host>
+class Descent {
+
+    static constexpr double MIN_STEP{ 1e-10 };  // Минимальный шаг правила Армихо
+    static constexpr size_t HISTORY_SIZE{ 5 };  // Точек для осцилляций и детекции оврагов
+
+public:
+
+    Descent(Function &function, Host &host, const DescentSettings &settings)
+        : m_function{ function }
+        , m_host{ host }
+        , m_settings{ settings }
+        , m_n{ function.size() }
+        , m_computationPrecision{ std::pow(10.0, -settings.computationDigits) }
+        , m_resultPrecision{ std::pow(10.0, -settings.resultDigits) }
+        , m_batch(static_cast<size_t>(kBatchSize) * function.size())
+    {
+    }
+
+    const std::vector<double> &best() const { return m_best; }
+    double bestValue() const { return m_bestValue; }
+    int iterations() const { return m_iterations; }
+
+    // Базовый градиентный спуск: шаг по правилу m_settings.step
+    Stop gradientDescent()
+    {
+        start(true);
+        std::vector<double> old(m_n), grad(m_n);
+        while (running()) {
+            for (size_t i = 0; i < m_n; ++i) old[i] = round(m_x[i]);
+            const double f_old = round(m_f);
+
+            // 1. Градиент
+            for (size_t i = 0; i < m_n; ++i) grad[i] = round(m_g[i]);
+            const double grad_norm = round(std::sqrt(dot(grad.data(), grad.data(), m_n)));
+
+            // 2. Шаг для всех координат
+            const double step = round(gradientStep(grad, grad_norm));
+
+            // 3. Движение по всем координатам одновременно
+            const double direction = m_settings.minimize ? -1.0 : 1.0;
+            for (size_t i = 0; i < m_n; ++i) {
+                m_x[i] = clamp(i, m_x[i] + direction * step * grad[i]);
+            }
+            moved(true);
+
+            Iterate row;
+            row.gradientNorm = grad_norm;
+            row.step = step;
+            m_host.row(fill(row));
+
+            if (m_host.cancelled(m_iterations, m_bestValue)) return Stop::Cancelled;
+            const Stop conv = checkConvergence(old, f_old);
+            if (conv != Stop::Limits) return conv;
+            if (!withinBounds(m_x)) return Stop::OutOfBounds;
+            if (grad_norm < m_computationPrecision) return Stop::SmallGradient;
+        }
+        return Stop::Limits;
+    }
+
+    // Наискорейший спуск: шаг вдоль антиградиента одномерным поиском
+    Stop steepestDescent()
+    {
+        start(true);
+        std::vector<double> old(m_n), grad(m_n), dir(m_n);
+        WolfeHistory wolfe_history; // Прошлый шаг для LineSearchMethod::Wolfe
+        while (running()) {
+            for (size_t i = 0; i < m_n; ++i) old[i] = round(m_x[i]);
+            const double f_old = round(m_f);
+
+            for (size_t i = 0; i < m_n; ++i) grad[i] = round(m_g[i]);
+            const double grad_norm = round(std::sqrt(dot(grad.data(), grad.data(), m_n)));
+
+            const double direction = m_settings.minimize ? -1.0 : 1.0;
+            double optimal_step = 0.0;
+            for (size_t i = 0; i < m_n; ++i) dir[i] = direction * grad[i];
+            if (!wolfeStep(dir, wolfe_history, optimal_step)) {
+                optimal_step = round(optimalStep(grad, direction, m_settings.step.constant));
+                for (size_t i = 0; i < m_n; ++i) {
+                    m_x[i] = round(clamp(i, m_x[i] + direction * optimal_step * grad[i]));
+                }
+                moved(true);
+            }
+            else {
+                moved(false);
+            }
+
+            Iterate row;
+            row.gradientNorm = grad_norm;
+            row.step = optimal_step;
+            m_host.row(fill(row));
+
+            if (m_host.cancelled(m_iterations, m_bestValue)) return Stop::Cancelled;
+            const Stop conv = checkConvergence(old, f_old);
+            if (conv != Stop::Limits) return conv;
+            if (!withinBounds(m_x)) return Stop::OutOfBounds;
+            if (grad_norm < m_computationPrecision) return Stop::SmallGradient;
+        }
+        return Stop::Limits;
+    }
+
+    // Овражный метод: в овраге шаг идёт вдоль главной оси последних точек
+    Stop ravine()
+    {
+        start(true);
+        std::vector<double> old(m_n), grad(m_n), dir(m_n);
+        std::vector<std::vector<double>> trajectory{ m_x };
+        std::vector<std::vector<double>> gradient_history;
+        while (running()) {
+            for (size_t i = 0; i < m_n; ++i) old[i] = round(m_x[i]);
+            const double f_old = round(m_f);
+
+            // 1. Градиент
+            for (size_t i = 0; i < m_n; ++i) grad[i] = round(m_g[i]);
+            const double grad_norm = round(std::sqrt(dot(grad.data(), grad.data(), m_n)));
+            if (grad_norm < m_computationPrecision) {
+                return Stop::SmallGradient;
+            }
+            gradient_history.push_back(grad);
+            if (gradient_history.size() > HISTORY_SIZE) {
+                gradient_history.erase(gradient_history.begin());
+            }
+
+            // 2. Детекция оврага и направление
+            const double ravine_factor = round(ravineFactor(gradient_history, trajectory));
+            if (ravine_factor > 0.3) {
+                ravineDirection(trajectory, dir); // Сильный овраг — вдоль оврага
+            }
+            else if (ravine_factor > 0.1) {
+                combinedDirection(grad, trajectory, ravine_factor, dir); // Слабый — смесь
+            }
+            else {
+                for (size_t i = 0; i < m_n; ++i) dir[i] = round(grad[i] / grad_norm);
+            }
+
+            // 3. Шаг и переход
+            const double direction_sign = m_settings.minimize ? -1.0 : 1.0;
+            const double optimal_step = round(optimalStep(dir, direction_sign, m_settings.step.constant));
+            for (size_t i = 0; i < m_n; ++i) {
+                m_x[i] = round(clamp(i, m_x[i] + direction_sign * optimal_step * dir[i]));
+            }
+            moved(true);
+            trajectory.push_back(m_x);
+            if (trajectory.size() > HISTORY_SIZE) {
+                trajectory.erase(trajectory.begin());
+            }
+
+            Iterate row;
+            row.gradientNorm = grad_norm;
+            row.ravineFactor = ravine_factor;
+            m_host.row(fill(row));
+
+            if (m_host.cancelled(m_iterations, m_bestValue)) return Stop::Cancelled;
+            const Stop conv = checkConvergence(old, f_old);
+            if (conv != Stop::Limits) return conv;
+            if (!withinBounds(m_x)) return Stop::OutOfBounds;
+        }
+        return Stop::Limits;
+    }
+
+    // Базовый покоординатный спуск: шаг по каждой координате по очереди
+    Stop basicCoordinate()
+    {
+        start(true);
+        std::vector<double> old(m_n), grad(m_n), steps(m_n);
+        while (running()) {
+            for (size_t i = 0; i < m_n; ++i) old[i] = round(m_x[i]);
+            const double f_old = round(m_f);
+
+            for (size_t i = 0; i < m_n; ++i) {
+                // Производная — в точке после шагов по предыдущим координатам
+                grad[i] = round((i == 0) ? m_g[0] : m_function.derivative(m_x.data(), i));
+                steps[i] = round(coordinateStep(grad[i], i));
+                m_x[i] = round(clamp(i, m_x[i] + steps[i]));
+            }
+            moved(true);
+
+            Iterate row;
+            row.gradient = &grad;
+            row.steps = &steps;
+            m_host.row(fill(row));
+
+            if (m_host.cancelled(m_iterations, m_bestValue)) return Stop::Cancelled;
+            if (!withinBounds(m_x)) return Stop::OutOfBounds;
+            const Stop conv = checkConvergence(old, f_old);
+            if (conv != Stop::Limits) return conv;
+        }
+        return Stop::Limits;
+    }
+
+    /**
+     * Наискорейший покоординатный спуск: шаг по координате с наибольшей
+     * частной производной, если она больше остальных в 1.5 раза, иначе по
+     * следующей за прошлой. Больше 5 шагов подряд по одной координате —
+     * принудительное переключение; если шаг не сдвинул координату, шаг
+     * делается по следующим.
+     */
+    Stop steepestCoordinate()
+    {
+        start(true);
+        std::vector<double> old(m_n), grad(m_n), steps(m_n);
+        int consecutive = 0;
+        size_t last = m_n - 1;
+        while (running()) {
+            for (size_t i = 0; i < m_n; ++i) old[i] = round(m_x[i]);
+            const double f_old = round(m_f);
+
+            for (size_t i = 0; i < m_n; ++i) grad[i] = round(m_g[i]);
+
+            // Координата с наибольшей по модулю производной и её доминирование
+            size_t k = 0;
+            for (size_t i = 1; i < m_n; ++i) {
+                if (round(std::abs(grad[i])) > round(std::abs(grad[k]))) k = i;
+            }
+            bool dominant = true;
+            for (size_t i = 0; i < m_n; ++i) {
+                if (i != k && !(round(std::abs(grad[k])) > 1.5 * round(std::abs(grad[i])))) dominant = false;
+            }
+
+            size_t chosen;
+            if (dominant) {
+                chosen = k;
+                consecutive = (k == last) ? consecutive + 1 : 1;
+            }
+            else {
+                // Производные близки — координаты по очереди, чтобы не застрять
+                chosen = (last + 1) % m_n;
+                consecutive = 0;
+            }
+            if (consecutive > 5) {
+                chosen = (chosen + 1) % m_n;
+                consecutive = 0;
+                std::cout << "*** FORCED SWITCH due to consecutive optimizations ***" << std::endl;
+            }
+
+            std::fill(steps.begin(), steps.end(), 0.0);
+            size_t i = chosen;
+            while (true) {
+                steps[i] = round(coordinateStep(grad[i], i));
+                const double moved_to = round(clamp(i, m_x[i] + steps[i]));
+                if (round(std::abs(moved_to - m_x[i])) > m_computationPrecision) {
+                    m_x[i] = round(moved_to);
+                    break;
+                }
+                if (i + 1 >= m_n) {
+                    break;
+                }
+                // Шаг слишком маленький — следующая координата
+                consecutive = 0;
+                ++i;
+            }
+            last = i;
+            moved(true);
+
+            Iterate row;
+            row.gradient = &grad;
+            row.steps = &steps;
+            m_host.row(fill(row));
+
+            if (m_host.cancelled(m_iterations, m_bestValue)) return Stop::Cancelled;
+            if (!withinBounds(m_x)) return Stop::OutOfBounds;
+            const Stop conv = checkConvergence(old, f_old);
+            if (conv != Stop::Limits) return conv;
+        }
+        return Stop::Limits;
+    }
+
+    // Метод сопряжённых градиентов (Флетчер — Ривс, сброс каждые 2 итерации)
+    Stop conjugateGradient()
+    {
+        start(false);
+        std::vector<double> old(m_n), grad(m_n), dir(m_n);
+        for (size_t i = 0; i < m_n; ++i) grad[i] = round(m_g[i]);
+        double grad_norm_old = round(dot(grad.data(), grad.data(), m_n));
+        const double direction_sign = m_settings.minimize ? -1.0 : 1.0;
+        for (size_t i = 0; i < m_n; ++i) dir[i] = direction_sign * grad[i];
+        WolfeHistory wolfe_history; // Прошлый шаг для LineSearchMethod::Wolfe
+
+        while (running()) {
+            old = m_x;
+            const double f_old = round(m_f);
+
+            double optimal_step = 0.0;
+            if (!wolfeStep(dir, wolfe_history, optimal_step)) {
+                optimal_step = round(optimalStep(dir, 1.0, 0.01));
+                for (size_t i = 0; i < m_n; ++i) {
+                    m_x[i] = round(clamp(i, m_x[i] + optimal_step * dir[i]));
+                }
+                moved(true, false);
+            }
+            else {
+                moved(false, false);
+            }
+
+            // Коэффициент Флетчера — Ривса и новое сопряжённое направление
+            for (size_t i = 0; i < m_n; ++i) grad[i] = round(m_g[i]);
+            const double grad_norm_new = round(dot(grad.data(), grad.data(), m_n));
+            const double beta = (m_iterations % 2 == 0) ? 0.0 : (grad_norm_new / grad_norm_old);
+            for (size_t i = 0; i < m_n; ++i) {
+                dir[i] = round(direction_sign * grad[i] + beta * dir[i]);
+            }
+            grad_norm_old = grad_norm_new;
+
+            Iterate row;
+            row.gradient = &grad;
+            row.step = optimal_step;
+            row.beta = beta;
+            row.gradientNorm = std::sqrt(grad_norm_new);
+            m_host.row(fill(row));
+
+            if (m_host.cancelled(m_iterations, m_bestValue)) return Stop::Cancelled;
+            if (!withinBounds(m_x)) return Stop::OutOfBounds;
+            const Stop conv = checkConvergence(old, f_old);
+            if (conv != Stop::Limits) return conv;
+            if (std::sqrt(grad_norm_new) < m_computationPrecision) return Stop::SmallGradient;
+        }
+        return Stop::Limits;
+    }
+
+private:
+
+    Function &m_function;
+    Host &m_host;
+    const DescentSettings &m_settings;
+    const size_t m_n;                  // Число переменных
+    const double m_computationPrecision;
+    const double m_resultPrecision;
+    std::vector<double> m_x;           // Текущая точка
+    std::vector<double> m_g;           // Градиент в ней (не округлён)
+    double m_f = 0.0;                  // Значение в ней (не округлено)
+    std::vector<double> m_best;        // Лучшая точка
+    double m_bestValue = 0.0;
+    int m_iterations = 0;
+    std::vector<std::vector<double>> m_recent_points; // Последние точки для поиска осцилляций
+    int m_oscillation_count = 0;
+    std::vector<double> m_batch;       // Точки пакета, kBatchSize * m_n
+    std::vector<double> m_trial;       // Пробная точка поиска шага
+
+    // ------------------------------------------------------------------------
+    // Состояние решения
+    // ------------------------------------------------------------------------
+
+    // Начальная точка, значение и градиент в ней; roundBest — лучшая точка
+    // округляется (у CG точка и так округлена)
+    void start(bool roundBest)
+    {
+        m_x.resize(m_n);
+        m_g.assign(m_n, 0.0);
+        m_trial.assign(m_n, 0.0);
+        for (size_t i = 0; i < m_n; ++i) m_x[i] = round(m_settings.initial[i]);
+        m_f = m_function.gradient(m_x.data(), m_g.data());
+        const double f_current = round(m_f);
+        m_best.resize(m_n);
+        for (size_t i = 0; i < m_n; ++i) m_best[i] = roundBest ? round(m_x[i]) : m_x[i];
+        m_bestValue = roundBest ? round(f_current) : f_current;
+        m_iterations = 0;
+        m_recent_points.clear();
+        m_oscillation_count = 0;
+        m_host.begin(m_x, f_current);
+    }
+
+    bool running() const
+    {
+        return m_iterations < m_settings.maxIterations && m_function.calls() < m_settings.maxFunctionCalls;
+    }
+
+    // Точка m_x сменилась: evaluate — значение и градиент в ней ещё не вычислены
+    // (после шага по Вольфе они уже есть); обновляется лучшая точка
+    void moved(bool evaluate, bool roundBest = true)
+    {
+        if (evaluate) {
+            m_f = m_function.gradient(m_x.data(), m_g.data());
+        }
+        const double f_current = round(m_f);
+        m_iterations++;
+        if (better(f_current, m_bestValue)) {
+            for (size_t i = 0; i < m_n; ++i) m_best[i] = roundBest ? round(m_x[i]) : m_x[i];
+            m_bestValue = roundBest ? round(f_current) : f_current;
+        }
+    }
+
+    const Iterate &fill(Iterate &row) const
+    {
+        row.iteration = m_iterations;
+        row.point = &m_x;
+        row.value = round(m_f);
+        row.best = &m_best;
+        row.bestValue = m_bestValue;
+        return row;
+    }
+
+    // ------------------------------------------------------------------------
+    // Общие вспомогательные методы
+    // ------------------------------------------------------------------------
+
+    double round(double v) const
+    {
+        double factor = std::pow(10.0, m_settings.computationDigits);
+        return std::round(v * factor) / factor;
+    }
+
+    bool better(double a, double b) const { return m_settings.minimize ? (a < b) : (a > b); }
+
+    double clamp(size_t i, double v) const
+    {
+        return std::max(m_settings.lower[i], std::min(m_settings.upper[i], v));
+    }
+
+    bool withinBounds(const std::vector<double> &point) const
+    {
+        for (size_t i = 0; i < m_n; ++i) {
+            if (!(point[i] >= m_settings.lower[i] && point[i] <= m_settings.upper[i])) return false;
+        }
+        return true;
+    }
+
+    // Проверка сходимости и осцилляций; Stop::Limits — продолжать
+    Stop checkConvergence(const std::vector<double> &old, double f_old)
+    {
+        const auto phase = m_host.instrument().scope(Phase::Convergence);
+
+        double d = std::abs(m_x[0] - old[0]);
+        double squares = d * d;
+        for (size_t i = 1; i < m_n; ++i) {
+            d = std::abs(m_x[i] - old[i]);
+            squares += d * d;
+        }
+        const double coordinate_norm = std::sqrt(squares);
+        const double f_new = round(m_f);
+        const double df = std::abs(f_new - f_old);
+
+        m_recent_points.push_back(m_x);
+        if (m_recent_points.size() > HISTORY_SIZE) {
+            m_recent_points.erase(m_recent_points.begin());
+        }
+
+        // Все возможные циклы в последних точках
+        if (m_recent_points.size() >= 4) {
+            bool found_cycle = false;
+            for (size_t i = 0; i < m_recent_points.size() - 2 && !found_cycle; ++i) {
+                for (size_t j = i + 1; j < m_recent_points.size() - 1; ++j) {
+                    if (distance(m_recent_points[i], m_recent_points[j]) < m_computationPrecision) {
+                        m_oscillation_count++;
+                        found_cycle = true;
+                        break;
+                    }
+                }
+            }
+
+            if (m_oscillation_count > m_settings.oscillationLimit) {
+                std::cout << "*** STOP: Oscillation detected after "
+                    << m_oscillation_count << " cycles ***" << std::endl;
+                m_host.report([&](auto &reporter) {
+                    reporter.insertMessage("СТОП: Обнаружена осцилляция после " + std::to_string(m_oscillation_count) + " циклов");
+                });
+                // Лучшая из последних точек
+                for (const auto &point : m_recent_points) {
+                    const double f_val = m_function.value(point.data());
+                    if (better(f_val, m_bestValue)) {
+                        m_best = point;
+                        m_bestValue = f_val;
+                    }
+                }
+                return Stop::Oscillation;
+            }
+
+            if (!found_cycle) {
+                m_oscillation_count = 0; // Цикл прервался
+            }
+        }
+
+        if (coordinate_norm < m_resultPrecision && df < m_resultPrecision) {
+            const double current_f = m_function.value(m_x.data());
+            if (better(current_f, m_bestValue)) {
+                m_best = m_x;
+                m_bestValue = current_f;
+            }
+            std::cout << "*** CONVERGENCE: Coordinates and function stabilized ***" << std::endl;
+            m_host.report([&](auto &reporter) { reporter.insertMessage("СХОДИМОСТЬ: Координаты и функция стабилизировалась"); });
+            return Stop::Converged;
+        }
+        return Stop::Limits;
+    }
+
+    double distance(const std::vector<double> &a, const std::vector<double> &b) const
+    {
+        double squares = std::pow(a[0] - b[0], 2);
+        for (size_t i = 1; i < m_n; ++i) {
+            squares += std::pow(a[i] - b[i], 2);
+        }
+        return std::sqrt(squares);
+    }
+
+    // ------------------------------------------------------------------------
+    // Шаги градиентного спуска
+    // ------------------------------------------------------------------------
+
+    double gradientStep(const std::vector<double> &grad, double grad_norm)
+    {
+        switch (m_settings.step.rule) {
+        case StepRule::Coefficient: return m_settings.step.coefficient * grad_norm;
+        case StepRule::Adaptive:    return armijoStep(grad);
+        default:                    return m_settings.step.constant;
+        }
+    }
+
+    // Адаптивный шаг: backtracking с условием Армихо
+    double armijoStep(const std::vector<double> &grad)
+    {
+        const auto phase = m_host.instrument().scope(Phase::LineSearch);
+        const double direction = m_settings.minimize ? -1.0 : 1.0;
+        const double beta = 0.5; // Коэффициент уменьшения шага
+        const double c = 0.1;    // Параметр Армихо
+        double step = m_settings.step.constant;
+        const double f_current = m_function.value(m_x.data());
+
+        std::vector<double> dir(m_n);
+        for (size_t i = 0; i < m_n; ++i) dir[i] = direction * grad[i];
+        const double slope = dot(grad.data(), dir.data(), m_n);
+
+        if (m_settings.lineSearch == LineSearchMethod::Batched) {
+            // Те же кандидаты и то же условие, но пачками до 4 точек. Точки строятся
+            // так же, как шаг метода (округлённый шаг, без округления координат),
+            // чтобы значение в принятой точке нашлось в памяти значений
+            auto evaluate = [&](const double *steps, double *values, int n) {
+                for (int k = 0; k < n; ++k) {
+                    const double rounded = round(steps[k]);
+                    double *point = &m_batch[static_cast<size_t>(k) * m_n];
+                    for (size_t i = 0; i < m_n; ++i) point[i] = clamp(i, m_x[i] + rounded * dir[i]);
+                }
+                m_function.valueBatch(m_batch.data(), values, n);
+            };
+            auto armijo = [&](double candidate, double f_new) {
+                const double armijo_rhs = f_current + c * candidate * slope;
+                return m_settings.minimize ? (f_new <= armijo_rhs) : (f_new >= armijo_rhs);
+            };
+            return batchedBacktracking(evaluate, armijo, step, beta, MIN_STEP, MIN_STEP, 4);
+        }
+
+        while (step >= MIN_STEP) {
+            for (size_t i = 0; i < m_n; ++i) m_trial[i] = clamp(i, m_x[i] + step * dir[i]);
+            if (!withinBounds(m_trial)) { // NaN не прижимается к границам
+                step *= beta;
+                continue;
+            }
+            const double f_new = m_function.value(m_trial.data());
+            const double armijo_rhs = f_current + c * step * slope;
+            if (m_settings.minimize ? (f_new <= armijo_rhs) : (f_new >= armijo_rhs)) {
+                return step;
+            }
+            step *= beta;
+        }
+        return MIN_STEP;
+    }
+
+    // Шаг по условиям Вольфе вдоль dir; при успехе m_x, m_f и m_g — в новой
+    // точке. false — шаг ищется одномерным поиском (или поиск не по Вольфе)
+    bool wolfeStep(const std::vector<double> &dir, WolfeHistory &history, double &step)
+    {
+        if (m_settings.lineSearch != LineSearchMethod::Wolfe) {
+            return false;
+        }
+        const auto phase = m_host.instrument().scope(Phase::LineSearch);
+        WolfePoint accepted;
+        const bool found = findWolfeStep(
+            [this](const double *point, double *gradient) { return m_function.gradient(point, gradient); },
+            [this](double v) { return round(v); },
+            m_x, dir, m_f, m_g, m_settings.lower, m_settings.upper, m_settings.minimize,
+            m_computationPrecision, history, step, accepted);
+        if (found) {
+            m_x = accepted.point;
+            m_g = accepted.gradient;
+            m_f = accepted.value;
+        }
+        return found;
+    }
+
+    /**
+     * Шаг вдоль sign * dir одномерным поиском на [0, b], b — начальная
+     * граница (initialStepBound); fallback — если граница не найдена.
+     * Пробные шаги и точки округляются так же, как при переходе по найденному
+     * шагу: принятая точка совпадёт с пробной, и её значение возьмётся из
+     * памяти значений функции.
+     */
+    double optimalStep(const std::vector<double> &dir, double sign, double fallback)
+    {
+        const auto phase = m_host.instrument().scope(Phase::LineSearch);
+        const double a = 0.0;
+        const double b = initialStepBound(dir, sign);
+        if (b <= a) {
+            return fallback;
+        }
+
+        if (m_settings.lineSearch == LineSearchMethod::Batched) {
+            std::vector<double> along(m_n);
+            for (size_t i = 0; i < m_n; ++i) along[i] = sign * dir[i];
+            auto evaluate = [&](const double *steps, double *values, int n) {
+                for (int k = 0; k < n; ++k) {
+                    const double step = round(steps[k]);
+                    double *point = &m_batch[static_cast<size_t>(k) * m_n];
+                    for (size_t i = 0; i < m_n; ++i) point[i] = round(clamp(i, m_x[i] + step * along[i]));
+                }
+                m_function.valueBatch(m_batch.data(), values, n);
+            };
+            return gridLineSearch(evaluate, a, b, m_settings.minimize, m_computationPrecision);
+        }
+
+        auto evaluate = [&](double step) {
+            step = round(step);
+            for (size_t i = 0; i < m_n; ++i) m_trial[i] = round(clamp(i, m_x[i] + sign * step * dir[i]));
+            return m_function.value(m_trial.data());
+        };
+        // Допуск по шагу — точность вычислений: точнее шаг всё равно не различается
+        if (m_settings.lineSearch == LineSearchMethod::Golden) {
+            return goldenSectionSearch(evaluate, a, b, m_settings.minimize, m_computationPrecision);
+        }
+        return brentLineSearch(evaluate, a, b, m_settings.minimize, m_computationPrecision);
+    }
+
+    // Начальная граница шага: не длиннее 0.5 / |dir|, не за границы области
+    // и (в пределах 10 сокращений) с улучшением функции
+    double initialStepBound(const std::vector<double> &dir, double sign)
+    {
+        double max_step = 1.0;
+        const double dir_norm = std::sqrt(dot(dir.data(), dir.data(), m_n));
+        if (dir_norm > 1e-10) {
+            max_step = std::min(1.0, 0.5 / dir_norm);
+        }
+
+        int safety_counter = 0;
+        while (max_step > 1e-10 && safety_counter < 20) {
+            for (size_t i = 0; i < m_n; ++i) m_trial[i] = m_x[i] + sign * max_step * dir[i];
+            if (withinBounds(m_trial)) {
+                const double current_f = m_function.value(m_x.data());
+                const double new_f = m_function.value(m_trial.data());
+                if (better(new_f, current_f) || safety_counter > 10) {
+                    break;
+                }
+            }
+            max_step *= 0.7;
+            safety_counter++;
+        }
+        return max_step;
+    }
+
+    // ------------------------------------------------------------------------
+    // Овражный метод
+    // ------------------------------------------------------------------------
+
+    // Признак оврага от 0 до 1: колебания градиента и вытянутость траектории
+    double ravineFactor(const std::vector<std::vector<double>> &gradients,
+                        const std::vector<std::vector<double>> &trajectory) const
+    {
+        if (gradients.size() < 3) return 0.0;
+        double factor = 0.0;
+        factor += angleVariance(gradients) * 0.6;
+        if (trajectory.size() >= 3) {
+            factor += elongation(trajectory) * 0.4;
+        }
+        return std::min(1.0, factor);
+    }
+
+    // Дисперсия углов между соседними градиентами, нормированная на pi^2
+    double angleVariance(const std::vector<std::vector<double>> &gradients) const
+    {
+        std::vector<double> angles;
+        for (size_t i = 1; i < gradients.size(); ++i) {
+            const double *a = gradients[i - 1].data();
+            const double *b = gradients[i].data();
+            const double product = dot(a, b, m_n);
+            const double norm1 = std::sqrt(dot(a, a, m_n));
+            const double norm2 = std::sqrt(dot(b, b, m_n));
+            if (norm1 > 1e-10 && norm2 > 1e-10) {
+                const double cos_angle = std::max(-1.0, std::min(1.0, product / (norm1 * norm2)));
+                angles.push_back(std::acos(cos_angle));
+            }
+        }
+        if (angles.empty()) return 0.0;
+
+        double mean = 0.0;
+        for (double angle : angles) mean += angle;
+        mean /= angles.size();
+        double variance = 0.0;
+        for (double angle : angles) variance += (angle - mean) * (angle - mean);
+        variance /= angles.size();
+        return std::min(1.0, variance / (M_PI * M_PI));
+    }
+
+    // Вытянутость траектории: длина пути к расстоянию между концами
+    double elongation(const std::vector<std::vector<double>> &trajectory) const
+    {
+        double path_length = 0.0;
+        for (size_t k = 1; k < trajectory.size(); ++k) {
+            double d = trajectory[k][0] - trajectory[k - 1][0];
+            double squares = d * d;
+            for (size_t i = 1; i < m_n; ++i) {
+                d = trajectory[k][i] - trajectory[k - 1][i];
+                squares += d * d;
+            }
+            path_length += std::sqrt(squares);
+        }
+        const double direct_distance = distance(trajectory.back(), trajectory.front());
+        if (direct_distance < 1e-10) return 1.0; // Траектория замкнута — вероятно овраг
+        return std::min(1.0, (path_length / direct_distance - 1.0) / 2.0);
+    }
+
+    // Смесь нормированного градиента и направления оврага с весом factor
+    void combinedDirection(const std::vector<double> &grad, const std::vector<std::vector<double>> &trajectory,
+                           double factor, std::vector<double> &dir) const
+    {
+        const double grad_norm = std::sqrt(dot(grad.data(), grad.data(), m_n));
+        std::vector<double> grad_dir(m_n), ravine_dir(m_n);
+        for (size_t i = 0; i < m_n; ++i) grad_dir[i] = grad[i] / grad_norm;
+        ravineDirection(trajectory, ravine_dir);
+        for (size_t i = 0; i < m_n; ++i) dir[i] = (1.0 - factor) * grad_dir[i] + factor * ravine_dir[i];
+        const double norm = std::sqrt(dot(dir.data(), dir.data(), m_n));
+        if (norm > 1e-10) {
+            for (double &v : dir) v /= norm;
+        }
+        else {
+            dir = grad_dir;
+        }
+    }
+
+    /**
+     * Направление оврага — главная ось последних точек: собственный вектор
+     * ковариационной матрицы с наибольшим собственным числом. Для двух
+     * переменных — по формуле, для большего числа — степенным методом от
+     * хорды траектории.
+     */
+    void ravineDirection(const std::vector<std::vector<double>> &trajectory, std::vector<double> &dir) const
+    {
+        std::fill(dir.begin(), dir.end(), 0.0);
+        if (trajectory.size() < 2) {
+            dir[0] = 1.0;
+            return;
+        }
+        const size_t count = trajectory.size();
+        std::vector<double> mean(m_n, 0.0);
+        for (const auto &point : trajectory) {
+            for (size_t i = 0; i < m_n; ++i) mean[i] += point[i];
+        }
+        for (double &v : mean) v /= count;
+
+        std::vector<double> cov(m_n * m_n, 0.0);
+        for (const auto &point : trajectory) {
+            for (size_t i = 0; i < m_n; ++i) {
+                for (size_t j = i; j < m_n; ++j) {
+                    cov[i * m_n + j] += (point[i] - mean[i]) * (point[j] - mean[j]);
+                }
+            }
+        }
+        for (size_t i = 0; i < m_n; ++i) {
+            for (size_t j = 0; j < i; ++j) cov[i * m_n + j] = cov[j * m_n + i];
+        }
+
+        if (m_n == 2) {
+            const double cov_xx = cov[0], cov_xy = cov[1], cov_yy = cov[3];
+            const double trace = cov_xx + cov_yy;
+            const double determinant = cov_xx * cov_yy - cov_xy * cov_xy;
+            const double eigenvalue = (trace + std::sqrt(trace * trace - 4 * determinant)) / 2;
+            dir[0] = cov_xy;
+            dir[1] = eigenvalue - cov_xx;
+        }
+        else {
+            for (size_t i = 0; i < m_n; ++i) dir[i] = trajectory.back()[i] - trajectory.front()[i];
+            if (!(std::sqrt(dot(dir.data(), dir.data(), m_n)) > 1e-10)) {
+                std::fill(dir.begin(), dir.end(), 1.0);
+            }
+            std::vector<double> next(m_n);
+            for (int iteration = 0; iteration < 50; ++iteration) {
+                for (size_t i = 0; i < m_n; ++i) next[i] = dot(&cov[i * m_n], dir.data(), m_n);
+                const double norm = std::sqrt(dot(next.data(), next.data(), m_n));
+                if (!(norm > 1e-300)) break;
+                for (size_t i = 0; i < m_n; ++i) dir[i] = next[i] / norm;
+            }
+        }
+
+        const double norm = std::sqrt(dot(dir.data(), dir.data(), m_n));
+        if (norm > 1e-10) {
+            for (double &v : dir) v /= norm;
+        }
+    }
+
+    // ------------------------------------------------------------------------
+    // Шаги покоординатного спуска
+    // ------------------------------------------------------------------------
+
+    double coordinateStep(double gradient, size_t i)
+    {
+        const StepSize &step = m_settings.coordinateSteps[i];
+        const double direction = m_settings.minimize ? -1.0 : 1.0;
+        switch (step.rule) {
+        case StepRule::Coefficient:
+            return step.coefficient * gradient * direction;
+        case StepRule::Adaptive:
+            return adaptiveCoordinateStep(gradient, i);
+        default: {
+            const double sign_gradient = (gradient > 0) ? 1.0 : (gradient < 0 ? -1.0 : 0.0);
+            return step.constant * direction * sign_gradient;
+        }
+        }
+    }
+
+    /**
+     * Адаптивный шаг по координате i: базовый шаг, масштабированный по
+     * |производной|, с множителями 2, 1, 0.5, 0.2, 0.1 — лучший из
+     * улучшающих; если улучшения нет — крошечный шаг в нужную сторону.
+     */
+    double adaptiveCoordinateStep(double gradient, size_t i)
+    {
+        const auto phase = m_host.instrument().scope(Phase::LineSearch);
+        if (std::abs(gradient) < m_computationPrecision) {
+            return 0.0; // Нет смысла двигаться
+        }
+        const double direction = m_settings.minimize ? -1.0 : 1.0;
+        const double base_step = m_settings.coordinateSteps[i].constant;
+        const double scaled_step = base_step * std::min(10.0, std::max(0.1, std::abs(gradient)));
+        static constexpr double multipliers[] = { 2.0, 1.0, 0.5, 0.2, 0.1 };
+
+        double best_delta = 0.0;
+        bool found_improvement = false;
+        if (m_settings.lineSearch == LineSearchMethod::Batched) {
+            // Текущая точка и все кандидаты — один пакет; результат и число
+            // вызовов функции совпадают с последовательным вариантом
+            double deltas[kBatchSize], values[kBatchSize];
+            int n = 0;
+            std::copy(m_x.begin(), m_x.end(), m_batch.begin());
+            deltas[n++] = 0.0;
+            for (double mult : multipliers) {
+                double delta = direction * scaled_step * mult;
+                if (gradient < 0) delta = -delta;
+                delta = round(delta);
+                m_trial = m_x;
+                m_trial[i] = round(m_x[i] + delta);
+                if (!withinBounds(m_trial) || n == kBatchSize) continue;
+                std::copy(m_trial.begin(), m_trial.end(), m_batch.begin() + static_cast<size_t>(n) * m_n);
+                deltas[n++] = delta;
+            }
+            m_function.valueBatch(m_batch.data(), values, n);
+            double best_value = values[0];
+            for (int k = 1; k < n; ++k) {
+                if (better(values[k], best_value)) {
+                    best_value = values[k];
+                    best_delta = deltas[k];
+                    found_improvement = true;
+                }
+            }
+        }
+        else {
+            double best_value = m_function.value(m_x.data());
+            for (double mult : multipliers) {
+                const double step_size = scaled_step * mult;
+                double delta = direction * step_size;
+                if (gradient < 0) delta = -delta;
+                delta = round(delta); // Как при переходе: принятая точка найдётся в памяти значений
+                m_trial = m_x;
+                m_trial[i] = round(m_x[i] + delta);
+                if (!withinBounds(m_trial)) continue;
+                const double new_value = m_function.value(m_trial.data());
+                if (better(new_value, best_value)) {
+                    best_value = new_value;
+                    best_delta = delta;
+                    found_improvement = true;
+                }
+            }
+        }
+        if (found_improvement) {
+            return best_delta;
+        }
+        double tiny_delta = direction * base_step * 0.001;
+        if (gradient < 0) tiny_delta = -tiny_delta;
+        return tiny_delta;
+    }
+};
+
+} // namespace SC
+
+#endif // SOLVERCORE_DESCENT_HPP_
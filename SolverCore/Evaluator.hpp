@@ -0,0 +1,98 @@
+#ifndef SOLVERCORE_EVALUATOR_HPP_
+#define SOLVERCORE_EVALUATOR_HPP_
+
+#include <SolverCore/CompiledExpressionCache.hpp>
+#include <string>
+
+namespace SC {
+
+// Способ вычисления целевой функции. Значения совпадают с EvaluatorType
+// в Common.hpp каждого метода.
+enum class Backend : int {
+    MuParser = 0, // Байткод muParser через переменные m_x/m_y (по умолчанию)
+    Tape     = 1, // Регистровая лента SC::Tape
+    Native   = 2  // Машинный код, собранный системным компилятором
+};
+
+/**
+ * Альтернативное вычисление целевой функции. init() пытается подготовить
+ * запрошенный способ и при неудаче откатывается: Native -> Tape -> MuParser.
+ * Для MuParser enabled() == false, и метод продолжает вызывать m_parser.Eval().
+ *
+ * Разбор и компиляция берутся из CompiledExpression (см. CompiledExpressionCache),
+ * здесь — только собственные копии ленты и функции для вычисления.
+ */
+class Evaluator {
+public:
+
+    Backend init(const CompiledExpression &compiled, Backend requested)
+    {
+        m_active = Backend::MuParser;
+        m_error.clear();
+        if (requested == Backend::MuParser) {
+            return m_active;
+        }
+        if (!compiled.parsed()) {
+            m_error = compiled.expression().errorMessage();
+            return m_active;
+        }
+        if (requested == Backend::Native) {
+            if (compiled.nativeLoaded()) {
+                m_native = compiled.native();
+                m_active = Backend::Native;
+                return m_active;
+            }
+            m_error = compiled.native().errorMessage();
+        }
+        if (compiled.hasTape()) {
+            m_tape = compiled.tape();
+            m_active = Backend::Tape;
+        }
+        return m_active;
+    }
+
+    Backend init(const std::string &function, Backend requested)
+    {
+        return init(*CompiledExpressionCache::shared().get(function), requested);
+    }
+
+    bool enabled() const { return m_active != Backend::MuParser; }
+    Backend active() const { return m_active; }
+    const std::string &errorMessage() const { return m_error; }
+
+    double operator()(double x, double y) const
+    {
+        return (m_active == Backend::Native) ? m_native(x, y) : m_tape(x, y);
+    }
+
+    // Пакетное вычисление в n точках
+    void evaluate(const double *xs, const double *ys, double *out, size_t n) const
+    {
+        if (m_active == Backend::Native) {
+            m_native(xs, ys, out, n);
+        } else {
+            m_tape(xs, ys, out, n);
+        }
+    }
+
+private:
+
+    Tape m_tape;
+    NativeFunction m_native;
+    Backend m_active = Backend::MuParser;
+    std::string m_error;
+};
+
+inline const char *backendToString(Backend backend)
+{
+    switch (backend) {
+    case Backend::MuParser: return "muParser";
+    case Backend::Tape:     return "лента инструкций";
+    case Backend::Native:   return "машинный код";
+    default:                return "неизвестно";
+    }
+}
+
+} // namespace SC
+
+#endif // SOLVERCORE_EVALUATOR_HPP_
@@ -0,0 +1,687 @@
+#ifndef SOLVERCORE_EXPRESSION_HPP_
+#define SOLVERCORE_EXPRESSION_HPP_
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <locale>
+#include <map>
+#include <sstream>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace SC {
+
+// ============================================================================
+// Дуальные числа: значение функции и частные производные по x и y
+// ============================================================================
+
+struct Dual {
+    double v;  // Значение
+    double dx; // Производная по x
+    double dy; // Производная по y
+};
+
+inline Dual operator+(const Dual &a, const Dual &b) { return { a.v + b.v, a.dx + b.dx, a.dy + b.dy }; }
+inline Dual operator-(const Dual &a, const Dual &b) { return { a.v - b.v, a.dx - b.dx, a.dy - b.dy }; }
+inline Dual operator-(const Dual &a) { return { -a.v, -a.dx, -a.dy }; }
+inline Dual operator*(const Dual &a, const Dual &b)
+{
+    return { a.v * b.v, a.dx * b.v + a.v * b.dx, a.dy * b.v + a.v * b.dy };
+}
+inline Dual operator/(const Dual &a, const Dual &b)
+{
+    const double inv = 1.0 / b.v;
+    const double q = a.v * inv;
+    return { q, (a.dx - q * b.dx) * inv, (a.dy - q * b.dy) * inv };
+}
+
+// Применение цепного правила: f(a) и f'(a) уже посчитаны
+inline Dual chain(const Dual &a, double value, double derivative)
+{
+    return { value, derivative * a.dx, derivative * a.dy };
+}
+
+// ============================================================================
+// Разобранное выражение
+// ============================================================================
+
+// Операции узлов выражения
+enum class Op : unsigned char {
+    Const, VarX, VarY, Var,
+    Neg, Add, Sub, Mul, Div, Pow,
+    Sin, Cos, Tan, Asin, Acos, Atan,
+    Sinh, Cosh, Tanh, Asinh, Acosh, Atanh,
+    Log2, Log10, Ln, Exp, Sqrt, Sign, Rint, Abs,
+    Min, Max, Atan2
+};
+
+// Знак числа как в muParser: -1, 0 или 1
+inline double sign(double v) { return (v > 0.0) ? 1.0 : ((v < 0.0) ? -1.0 : 0.0); }
+
+// Значение унарной функции для обычного числа
+inline double applyUnary(Op op, double a)
+{
+    switch (op) {
+    case Op::Sin:   return std::sin(a);
+    case Op::Cos:   return std::cos(a);
+    case Op::Tan:   return std::tan(a);
+    case Op::Asin:  return std::asin(a);
+    case Op::Acos:  return std::acos(a);
+    case Op::Atan:  return std::atan(a);
+    case Op::Sinh:  return std::sinh(a);
+    case Op::Cosh:  return std::cosh(a);
+    case Op::Tanh:  return std::tanh(a);
+    case Op::Asinh: return std::asinh(a);
+    case Op::Acosh: return std::acosh(a);
+    case Op::Atanh: return std::atanh(a);
+    case Op::Log2:  return std::log2(a);
+    case Op::Log10: return std::log10(a);
+    case Op::Ln:    return std::log(a);
+    case Op::Exp:   return std::exp(a);
+    case Op::Sqrt:  return std::sqrt(a);
+    case Op::Sign:  return sign(a);
+    case Op::Rint:  return std::floor(a + 0.5);
+    case Op::Abs:   return std::fabs(a);
+    default:        return a;
+    }
+}
+
+// Узел выражения. Аргументы всегда стоят раньше узла (обратная польская запись),
+// поэтому выражение вычисляется одним проходом слева направо.
+struct Node {
+    Op op;        // Операция
+    int a;        // Индекс первого аргумента (или -1)
+    int b;        // Индекс второго аргумента (или -1)
+    double value; // Значение константы для Op::Const, номер переменной для Op::Var
+};
+
+/**
+ * Разбор строки функции в синтаксисе muParser (переменные x и y, константы
+ * _pi и _e, операторы + - * / ^, встроенные функции muParser) и её вычисление
+ * как для обычных чисел, так и для дуальных.
+ *
+ * Если в выражении встречается что-то, чего движок не знает (другие
+ * переменные, операторы сравнения, пользовательские функции), parse()
+ * возвращает false и вызывающая сторона должна использовать muParser.
+ *
+ * parseVector() разбирает функцию многих переменных: переменной считается
+ * любое имя, кроме констант и функций. Переменные нумеруются в естественном
+ * порядке имён (x1, x2, ..., x10), значения передаются массивом в том же порядке.
+ */
+class Expression {
+public:
+
+    Expression() = default;
+
+    // Функция двух переменных x и y
+    bool parse(const std::string &text)
+    {
+        m_vector = false;
+        if (!parseText(text)) {
+            return false;
+        }
+        m_variables = { "x", "y" };
+        return true;
+    }
+
+    // Функция многих переменных
+    bool parseVector(const std::string &text)
+    {
+        m_vector = true;
+        m_variables.clear();
+        if (!parseText(text)) {
+            m_variables.clear();
+            return false;
+        }
+        if (m_variables.empty()) {
+            m_nodes.clear();
+            m_error = "В функции нет переменных";
+            return false;
+        }
+        sortVariables();
+        return true;
+    }
+
+    bool isValid() const { return !m_nodes.empty(); }
+    const std::string &errorMessage() const { return m_error; }
+    const std::vector<Node> &nodes() const { return m_nodes; }
+
+    // Имена переменных в порядке их значений в point
+    const std::vector<std::string> &variables() const { return m_variables; }
+
+    // Значение функции в точке (x, y)
+    double value(double x, double y) const
+    {
+        const double point[2] = { x, y };
+        return run<double>(point, m_values);
+    }
+
+    // Значение функции и обе частные производные за один проход
+    Dual gradient(double x, double y) const
+    {
+        const double point[2] = { x, y };
+        return run<Dual>(point, m_duals);
+    }
+
+    // Значение функции многих переменных
+    double value(const double *point) const
+    {
+        return run<double>(point, m_values);
+    }
+
+    /**
+     * Значение и градиент по всем переменным (grad — variables().size()
+     * элементов): прямой проход и один обратный. Стоимость не зависит от
+     * числа переменных, в отличие от дуальных чисел и разностных производных.
+     */
+    double gradient(const double *point, double *grad) const
+    {
+        const double f = run<double>(point, m_values);
+        reverse(grad);
+        return f;
+    }
+
+private:
+
+    std::vector<Node> m_nodes;
+    std::string m_text;
+    std::string m_error;
+    size_t m_pos = 0;
+    bool m_vector = false;                // Разбор функции многих переменных
+    std::vector<std::string> m_variables;
+    std::vector<bool> m_constant;         // Узел не зависит от переменных
+    mutable std::vector<double> m_values; // Рабочие буферы вычисления
+    mutable std::vector<Dual> m_duals;
+    mutable std::vector<double> m_adjoints;
+
+    bool parseText(const std::string &text)
+    {
+        m_nodes.clear();
+        m_error.clear();
+        m_text = text;
+        m_pos = 0;
+
+        bool ok = parseSum() && skipSpaces() && m_pos == m_text.size();
+        if (!ok) {
+            if (m_error.empty()) {
+                m_error = "Неожиданный символ в позиции " + std::to_string(m_pos);
+            }
+            m_nodes.clear();
+            return false;
+        }
+        eliminateCommonSubexpressions();
+        m_constant.assign(m_nodes.size(), false);
+        for (size_t i = 0; i < m_nodes.size(); ++i) {
+            const Node &node = m_nodes[i];
+            m_constant[i] = (node.op == Op::Const) ||
+                (node.a >= 0 && m_constant[node.a] && (node.b < 0 || m_constant[node.b]));
+        }
+        m_values.resize(m_nodes.size());
+        m_duals.resize(m_nodes.size());
+        m_adjoints.resize(m_nodes.size());
+        return true;
+    }
+
+    // Естественный порядок: общий префикс, затем номер (x2 < x10)
+    static bool naturalLess(const std::string &a, const std::string &b)
+    {
+        auto split = [](const std::string &name) {
+            size_t digits = name.size();
+            while (digits > 0 && std::isdigit(static_cast<unsigned char>(name[digits - 1]))) {
+                --digits;
+            }
+            return digits;
+        };
+        const size_t da = split(a);
+        const size_t db = split(b);
+        const int prefix = a.compare(0, da, b, 0, db);
+        if (prefix != 0) {
+            return prefix < 0;
+        }
+        const std::string na = a.substr(da);
+        const std::string nb = b.substr(db);
+        if (na.size() != nb.size()) {
+            return na.size() < nb.size();
+        }
+        return na < nb;
+    }
+
+    // Переменные нумеруются при разборе по первому вхождению — перенумеровываем
+    void sortVariables()
+    {
+        std::vector<std::string> sorted = m_variables;
+        std::sort(sorted.begin(), sorted.end(), naturalLess);
+        std::vector<int> index(m_variables.size());
+        for (size_t i = 0; i < m_variables.size(); ++i) {
+            index[i] = static_cast<int>(std::find(sorted.begin(), sorted.end(), m_variables[i]) - sorted.begin());
+        }
+        for (Node &node : m_nodes) {
+            if (node.op == Op::Var) {
+                node.value = index[static_cast<size_t>(node.value)];
+            }
+        }
+        m_variables = std::move(sorted);
+    }
+
+    // Обратный проход по значениям из m_values: сопряжённые узлов -> градиент.
+    // Общий узел DAG собирает вклады всех своих потребителей до того, как
+    // до него дойдёт проход: потребители стоят в списке позже
+    void reverse(double *grad) const
+    {
+        const size_t n = m_nodes.size();
+        const std::vector<double> &v = m_values;
+        std::vector<double> &adj = m_adjoints;
+        std::fill(adj.begin(), adj.end(), 0.0);
+        std::fill(grad, grad + m_variables.size(), 0.0);
+        adj[n - 1] = 1.0;
+
+        for (size_t i = n; i-- > 0;) {
+            const Node &node = m_nodes[i];
+            const double g = adj[i];
+            if (g == 0.0 || m_constant[i]) {
+                continue;
+            }
+            switch (node.op) {
+            case Op::VarX:  grad[0] += g; break;
+            case Op::VarY:  grad[1] += g; break;
+            case Op::Var:   grad[static_cast<size_t>(node.value)] += g; break;
+            case Op::Neg:   adj[node.a] -= g; break;
+            case Op::Add:   adj[node.a] += g; adj[node.b] += g; break;
+            case Op::Sub:   adj[node.a] += g; adj[node.b] -= g; break;
+            case Op::Mul:   adj[node.a] += g * v[node.b]; adj[node.b] += g * v[node.a]; break;
+            case Op::Div:   adj[node.a] += g / v[node.b]; adj[node.b] -= g * v[i] / v[node.b]; break;
+            case Op::Min:   adj[less(v[node.b], v[node.a]) ? node.b : node.a] += g; break;
+            case Op::Max:   adj[less(v[node.a], v[node.b]) ? node.b : node.a] += g; break;
+            case Op::Pow:
+            case Op::Atan2: {
+                // Локальные производные — те же формулы, что и для дуальных чисел:
+                // dx — по первому аргументу, dy — по второму
+                const Dual a{ v[node.a], 1.0, 0.0 };
+                const Dual b{ v[node.b], 0.0, m_constant[node.b] ? 0.0 : 1.0 };
+                const Dual d = (node.op == Op::Pow) ? power(a, b) : arcTan2(a, b);
+                adj[node.a] += g * d.dx;
+                adj[node.b] += g * d.dy;
+                break;
+            }
+            default:        adj[node.a] += g * unary(node.op, Dual{ v[node.a], 1.0, 0.0 }).dx; break;
+            }
+        }
+    }
+
+    /**
+     * Слияние общих подвыражений: одинаковые узлы (для + и * — с точностью до
+     * порядка аргументов) заменяются первым из них, и список узлов становится
+     * DAG. Так exp(x*y) в x*exp(x*y) + y*exp(x*y) вычисляется один раз — и для
+     * значения, и для производных. Корень остаётся последним узлом.
+     */
+    void eliminateCommonSubexpressions()
+    {
+        std::map<std::tuple<int, int, int, std::uint64_t>, int> unique;
+        std::vector<int> remap(m_nodes.size());
+        std::vector<Node> nodes;
+        nodes.reserve(m_nodes.size());
+        for (size_t i = 0; i < m_nodes.size(); ++i) {
+            Node node = m_nodes[i];
+            if (node.a >= 0) node.a = remap[node.a];
+            if (node.b >= 0) node.b = remap[node.b];
+            if ((node.op == Op::Add || node.op == Op::Mul) && node.b < node.a) {
+                std::swap(node.a, node.b); // a+b и b+a совпадают побитово
+            }
+            std::uint64_t bits = 0;
+            std::memcpy(&bits, &node.value, sizeof(bits));
+            const auto key = std::make_tuple(static_cast<int>(node.op), node.a, node.b, bits);
+            const auto it = unique.emplace(key, static_cast<int>(nodes.size())).first;
+            if (it->second == static_cast<int>(nodes.size())) {
+                nodes.push_back(node);
+            }
+            remap[i] = it->second;
+        }
+        m_nodes = std::move(nodes);
+    }
+
+    // ------------------------------------------------------------------------
+    // Вычисление
+    // ------------------------------------------------------------------------
+
+    static double variable(double v, int, double) { return v; }
+    static Dual variable(double v, int index, Dual)
+    {
+        return { v, index == 0 ? 1.0 : 0.0, index == 1 ? 1.0 : 0.0 };
+    }
+    static double constant(double v, double) { return v; }
+    static Dual constant(double v, Dual) { return { v, 0.0, 0.0 }; }
+
+    template <typename T>
+    T run(const double *point, std::vector<T> &r) const
+    {
+        const size_t n = m_nodes.size();
+        for (size_t i = 0; i < n; ++i) {
+            const Node &node = m_nodes[i];
+            switch (node.op) {
+            case Op::Const: r[i] = constant(node.value, T{}); break;
+            case Op::VarX:  r[i] = variable(point[0], 0, T{}); break;
+            case Op::VarY:  r[i] = variable(point[1], 1, T{}); break;
+            case Op::Var: {
+                const int index = static_cast<int>(node.value);
+                r[i] = variable(point[index], index, T{});
+                break;
+            }
+            case Op::Neg:   r[i] = -r[node.a]; break;
+            case Op::Add:   r[i] = r[node.a] + r[node.b]; break;
+            case Op::Sub:   r[i] = r[node.a] - r[node.b]; break;
+            case Op::Mul:   r[i] = r[node.a] * r[node.b]; break;
+            case Op::Div:   r[i] = r[node.a] / r[node.b]; break;
+            case Op::Pow:   r[i] = power(r[node.a], r[node.b]); break;
+            case Op::Min:   r[i] = less(r[node.b], r[node.a]) ? r[node.b] : r[node.a]; break;
+            case Op::Max:   r[i] = less(r[node.a], r[node.b]) ? r[node.b] : r[node.a]; break;
+            case Op::Atan2: r[i] = arcTan2(r[node.a], r[node.b]); break;
+            default:        r[i] = unary(node.op, r[node.a]); break;
+            }
+        }
+        return r[n - 1];
+    }
+
+    static bool less(double a, double b) { return a < b; }
+    static bool less(const Dual &a, const Dual &b) { return a.v < b.v; }
+
+    static double power(double a, double b) { return std::pow(a, b); }
+    static Dual power(const Dual &a, const Dual &b)
+    {
+        const double v = std::pow(a.v, b.v);
+        if (b.dx == 0.0 && b.dy == 0.0) {
+            // Постоянный показатель: работает и для отрицательного основания
+            return chain(a, v, b.v * std::pow(a.v, b.v - 1.0));
+        }
+        const double lnA = std::log(a.v);
+        const double da = b.v * std::pow(a.v, b.v - 1.0);
+        return { v, da * a.dx + v * lnA * b.dx, da * a.dy + v * lnA * b.dy };
+    }
+
+    static double arcTan2(double a, double b) { return std::atan2(a, b); }
+    static Dual arcTan2(const Dual &a, const Dual &b)
+    {
+        const double inv = 1.0 / (a.v * a.v + b.v * b.v);
+        return { std::atan2(a.v, b.v),
+                 (b.v * a.dx - a.v * b.dx) * inv,
+                 (b.v * a.dy - a.v * b.dy) * inv };
+    }
+
+    static double unary(Op op, double a) { return applyUnary(op, a); }
+    static Dual unary(Op op, const Dual &a)
+    {
+        const double v = a.v;
+        switch (op) {
+        case Op::Sin:   return chain(a, std::sin(v), std::cos(v));
+        case Op::Cos:   return chain(a, std::cos(v), -std::sin(v));
+        case Op::Tan: {
+            const double t = std::tan(v);
+            return chain(a, t, 1.0 + t * t);
+        }
+        case Op::Asin:  return chain(a, std::asin(v), 1.0 / std::sqrt(1.0 - v * v));
+        case Op::Acos:  return chain(a, std::acos(v), -1.0 / std::sqrt(1.0 - v * v));
+        case Op::Atan:  return chain(a, std::atan(v), 1.0 / (1.0 + v * v));
+        case Op::Sinh:  return chain(a, std::sinh(v), std::cosh(v));
+        case Op::Cosh:  return chain(a, std::cosh(v), std::sinh(v));
+        case Op::Tanh: {
+            const double t = std::tanh(v);
+            return chain(a, t, 1.0 - t * t);
+        }
+        case Op::Asinh: return chain(a, std::asinh(v), 1.0 / std::sqrt(v * v + 1.0));
+        case Op::Acosh: return chain(a, std::acosh(v), 1.0 / std::sqrt(v * v - 1.0));
+        case Op::Atanh: return chain(a, std::atanh(v), 1.0 / (1.0 - v * v));
+        case Op::Log2:  return chain(a, std::log2(v), 1.0 / (v * std::log(2.0)));
+        case Op::Log10: return chain(a, std::log10(v), 1.0 / (v * std::log(10.0)));
+        case Op::Ln:    return chain(a, std::log(v), 1.0 / v);
+        case Op::Exp: {
+            const double e = std::exp(v);
+            return chain(a, e, e);
+        }
+        case Op::Sqrt: {
+            const double s = std::sqrt(v);
+            return chain(a, s, 0.5 / s);
+        }
+        case Op::Sign:  return chain(a, SC::sign(v), 0.0);
+        case Op::Rint:  return chain(a, std::floor(v + 0.5), 0.0);
+        case Op::Abs:   return chain(a, std::fabs(v), SC::sign(v));
+        default:        return a;
+        }
+    }
+
+    // ------------------------------------------------------------------------
+    // Разбор (приоритеты как в muParser: ^ правоассоциативен и сильнее унарного минуса)
+    // ------------------------------------------------------------------------
+
+    int addNode(Op op, int a = -1, int b = -1, double value = 0.0)
+    {
+        m_nodes.push_back({ op, a, b, value });
+        return static_cast<int>(m_nodes.size()) - 1;
+    }
+
+    bool skipSpaces()
+    {
+        while (m_pos < m_text.size() && std::isspace(static_cast<unsigned char>(m_text[m_pos]))) {
+            ++m_pos;
+        }
+        return true;
+    }
+
+    bool accept(char c)
+    {
+        skipSpaces();
+        if (m_pos < m_text.size() && m_text[m_pos] == c) {
+            ++m_pos;
+            return true;
+        }
+        return false;
+    }
+
+    bool fail(const std::string &message)
+    {
+        if (m_error.empty()) {
+            m_error = message;
+        }
+        return false;
+    }
+
+    // Индекс последнего добавленного узла — корень только что разобранного подвыражения
+    int last() const { return static_cast<int>(m_nodes.size()) - 1; }
+
+    bool parseSum()
+    {
+        if (!parseProduct()) return false;
+        while (true) {
+            int left = last();
+            if (accept('+')) {
+                if (!parseProduct()) return false;
+                addNode(Op::Add, left, last());
+            } else if (accept('-')) {
+                if (!parseProduct()) return false;
+                addNode(Op::Sub, left, last());
+            } else {
+                return true;
+            }
+        }
+    }
+
+    bool parseProduct()
+    {
+        if (!parseUnary()) return false;
+        while (true) {
+            int left = last();
+            if (accept('*')) {
+                if (!parseUnary()) return false;
+                addNode(Op::Mul, left, last());
+            } else if (accept('/')) {
+                if (!parseUnary()) return false;
+                addNode(Op::Div, left, last());
+            } else {
+                return true;
+            }
+        }
+    }
+
+    bool parseUnary()
+    {
+        if (accept('-')) {
+            if (!parseUnary()) return false;
+            addNode(Op::Neg, last());
+            return true;
+        }
+        if (accept('+')) {
+            return parseUnary();
+        }
+        return parsePower();
+    }
+
+    bool parsePower()
+    {
+        if (!parsePrimary()) return false;
+        int base = last();
+        if (accept('^')) {
+            if (!parseUnary()) return false; // Правая ассоциативность: 2^3^2 = 2^9
+            addNode(Op::Pow, base, last());
+        }
+        return true;
+    }
+
+    bool parsePrimary()
+    {
+        skipSpaces();
+        if (m_pos >= m_text.size()) {
+            return fail("Неожиданный конец выражения");
+        }
+        const char c = m_text[m_pos];
+        if (c == '(') {
+            ++m_pos;
+            if (!parseSum()) return false;
+            return accept(')') || fail("Ожидалась ')'");
+        }
+        if (std::isdigit(static_cast<unsigned char>(c)) || c == '.') {
+            return parseNumber();
+        }
+        if (std::isalpha(static_cast<unsigned char>(c)) || c == '_') {
+            return parseIdentifier();
+        }
+        return fail(std::string("Неподдерживаемый символ: ") + c);
+    }
+
+    bool parseNumber()
+    {
+        const size_t start = m_pos;
+        while (m_pos < m_text.size() && (std::isdigit(static_cast<unsigned char>(m_text[m_pos])) || m_text[m_pos] == '.')) {
+            ++m_pos;
+        }
+        if (m_pos < m_text.size() && (m_text[m_pos] == 'e' || m_text[m_pos] == 'E')) {
+            size_t p = m_pos + 1;
+            if (p < m_text.size() && (m_text[p] == '+' || m_text[p] == '-')) ++p;
+            if (p < m_text.size() && std::isdigit(static_cast<unsigned char>(m_text[p]))) {
+                m_pos = p;
+                while (m_pos < m_text.size() && std::isdigit(static_cast<unsigned char>(m_text[m_pos]))) ++m_pos;
+            }
+        }
+        // Разбираем в локали "C": Qt-приложение выставляет системную локаль
+        std::istringstream ss(m_text.substr(start, m_pos - start));
+        ss.imbue(std::locale::classic());
+        double value = 0.0;
+        ss >> value;
+        if (ss.fail() || !ss.eof()) {
+            return fail("Некорректное число в позиции " + std::to_string(start));
+        }
+        addNode(Op::Const, -1, -1, value);
+        return true;
+    }
+
+    bool parseIdentifier()
+    {
+        const size_t start = m_pos;
+        while (m_pos < m_text.size() && (std::isalnum(static_cast<unsigned char>(m_text[m_pos])) || m_text[m_pos] == '_')) {
+            ++m_pos;
+        }
+        const std::string name = m_text.substr(start, m_pos - start);
+
+        skipSpaces();
+        const bool call = m_pos < m_text.size() && m_text[m_pos] == '(';
+        if (!call) {
+            if (name == "_pi") { addNode(Op::Const, -1, -1, 3.141592653589793238462643); return true; }
+            if (name == "_e") { addNode(Op::Const, -1, -1, 2.718281828459045235360287); return true; }
+            if (m_vector) {
+                return addVariable(name);
+            }
+            if (name == "x") { addNode(Op::VarX); return true; }
+            if (name == "y") { addNode(Op::VarY); return true; }
+            return fail("Неизвестная переменная: " + name);
+        }
+        ++m_pos;
+
+        // Аргументы функции
+        std::vector<int> args;
+        if (!accept(')')) {
+            do {
+                if (!parseSum()) return false;
+                args.push_back(last());
+            } while (accept(','));
+            if (!accept(')')) return fail("Ожидалась ')'");
+        }
+        return buildCall(name, args);
+    }
+
+    bool addVariable(const std::string &name)
+    {
+        auto it = std::find(m_variables.begin(), m_variables.end(), name);
+        if (it == m_variables.end()) {
+            m_variables.push_back(name);
+            it = m_variables.end() - 1;
+        }
+        addNode(Op::Var, -1, -1, static_cast<double>(it - m_variables.begin()));
+        return true;
+    }
+
+    bool buildCall(const std::string &name, const std::vector<int> &args)
+    {
+        struct UnaryFunc { const char *name; Op op; };
+        static const UnaryFunc unaryFuncs[] = {
+            { "sin", Op::Sin }, { "cos", Op::Cos }, { "tan", Op::Tan },
+            { "asin", Op::Asin }, { "acos", Op::Acos }, { "atan", Op::Atan },
+            { "sinh", Op::Sinh }, { "cosh", Op::Cosh }, { "tanh", Op::Tanh },
+            { "asinh", Op::Asinh }, { "acosh", Op::Acosh }, { "atanh", Op::Atanh },
+            { "log2", Op::Log2 }, { "log10", Op::Log10 }, { "log", Op::Ln }, { "ln", Op::Ln },
+            { "exp", Op::Exp }, { "sqrt", Op::Sqrt }, { "sign", Op::Sign },
+            { "rint", Op::Rint }, { "abs", Op::Abs }
+        };
+        for (const auto &f : unaryFuncs) {
+            if (name == f.name) {
+                if (args.size() != 1) return fail("Неверное число аргументов: " + name);
+                addNode(f.op, args[0]);
+                return true;
+            }
+        }
+        if (name == "atan2") {
+            if (args.size() != 2) return fail("Неверное число аргументов: " + name);
+            addNode(Op::Atan2, args[0], args[1]);
+            return true;
+        }
+        // Функции с переменным числом аргументов сворачиваются в цепочку бинарных
+        if (name == "min" || name == "max" || name == "sum" || name == "avg") {
+            if (args.empty()) return fail("Неверное число аргументов: " + name);
+            const Op op = (name == "min") ? Op::Min : (name == "max") ? Op::Max : Op::Add;
+            int acc = args[0];
+            for (size_t i = 1; i < args.size(); ++i) {
+                acc = addNode(op, acc, args[i]);
+            }
+            if (name == "avg") {
+                int count = addNode(Op::Const, -1, -1, static_cast<double>(args.size()));
+                acc = addNode(Op::Div, acc, count);
+            }
+            return true;
+        }
+        return fail("Неизвестная функция: " + name);
+    }
+};
+
+} // namespace SC
+
+#endif // SOLVERCORE_EXPRESSION_HPP_
@@ -0,0 +1,331 @@
+#ifndef SOLVERCORE_INSTRUMENT_HPP_
+#define SOLVERCORE_INSTRUMENT_HPP_
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#  define SOLVERCORE_TSC 1
+#  if defined(_MSC_VER)
+#    include <intrin.h>
+#  else
+#    include <x86intrin.h>
+#  endif
+#endif
+
+// Замеры по фазам решения. 0 — замеры вырезаются при компиляции
+// (см. опцию SOLVERCORE_INSTRUMENT в CMake)
+#ifndef SOLVERCORE_INSTRUMENT
+#define SOLVERCORE_INSTRUMENT 1
+#endif
+
+namespace SC {
+
+// Фазы решения, по которым ведутся замеры
+enum class Phase {
+    Setup = 0,       // Разбор выражения и подготовка вычислителей
+    Function = 1,    // Вычисления функции (пакет из n точек — n вычислений)
+    Derivative = 2,  // Вычисления частных производных
+    LineSearch = 3,  // Одномерный поиск шага, вместе с вычислениями внутри него
+    Convergence = 4, // Проверки сходимости
+    Reporter = 5     // Вызовы системы отчётности
+};
+
+constexpr int kPhaseCount = 6;
+
+inline const char *phaseToString(Phase phase)
+{
+    switch (phase) {
+    case Phase::Setup:       return "setup";
+    case Phase::Function:    return "function";
+    case Phase::Derivative:  return "derivative";
+    case Phase::LineSearch:  return "lineSearch";
+    case Phase::Convergence: return "convergence";
+    case Phase::Reporter:    return "reporter";
+    }
+    return "unknown";
+}
+
+// Счётчик тактов: TSC на x86, иначе steady_clock в наносекундах
+inline std::uint64_t ticks()
+{
+#if defined(SOLVERCORE_TSC)
+    return __rdtsc();
+#else
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+}
+
+/**
+ * Привязка тактов ticks() к секундам: отметка в начале, отношение —
+ * по прошедшему с неё времени. Отдельная калибровка не нужна, шкала
+ * считается по тому же интервалу, который измерялся.
+ */
+class TickClock {
+public:
+
+    TickClock() { restart(); }
+
+    void restart()
+    {
+        m_startTicks = ticks();
+        m_startTime = std::chrono::steady_clock::now();
+    }
+
+    std::uint64_t startTicks() const { return m_startTicks; }
+
+    // Тактов в секунду на интервале от restart() до сейчас
+    double ticksPerSecond() const
+    {
+        const std::uint64_t elapsedTicks = ticks() - m_startTicks;
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - m_startTime;
+        if (elapsed.count() <= 0.0 || elapsedTicks == 0) {
+            return 1e9;
+        }
+        return static_cast<double>(elapsedTicks) / elapsed.count();
+    }
+
+private:
+
+    std::uint64_t m_startTicks = 0;
+    std::chrono::steady_clock::time_point m_startTime;
+};
+
+struct PhaseStats {
+    long long count = 0;  // Число вызовов (для Function — вычисленных точек)
+    double seconds = 0.0; // Время вместе с вложенными фазами
+};
+
+/**
+ * Итог замеров одного solve(). Время фаз включающее: LineSearch содержит
+ * вычисления функции внутри поиска шага, поэтому сумма фаз может быть
+ * больше totalSeconds.
+ */
+struct SolveStats {
+    bool enabled = false;                // false — замеры вырезаны при компиляции
+    PhaseStats phases[kPhaseCount];
+    long long lineSearchEvaluations = 0; // Вычисления функции внутри поиска шага
+    long long memoHits = 0;              // Значения и градиенты из SC::ValueMemo вместо вычисления
+    double totalSeconds = 0.0;
+
+    const PhaseStats &operator[](Phase phase) const { return phases[static_cast<int>(phase)]; }
+};
+
+/**
+ * События фаз в формате Chrome trace event (chrome://tracing, Perfetto).
+ * Каждый beginRun() открывает отдельную дорожку. Запись не синхронизирована:
+ * один Trace на поток. Событий не больше maxEvents, остальные считаются
+ * в dropped().
+ */
+class Trace {
+public:
+
+    explicit Trace(std::size_t maxEvents = 1 << 20)
+        : m_clock{}
+        , m_events{}
+        , m_runs{}
+        , m_maxEvents{ maxEvents }
+        , m_dropped{ 0 }
+    {
+    }
+
+    void beginRun(const std::string &name) { m_runs.push_back(name); }
+
+    void add(Phase phase, std::uint64_t start, std::uint64_t duration)
+    {
+        if (m_events.size() >= m_maxEvents) {
+            ++m_dropped;
+            return;
+        }
+        m_events.push_back({ phase, m_runs.empty() ? 0 : static_cast<int>(m_runs.size()) - 1, start, duration });
+    }
+
+    std::size_t size() const { return m_events.size(); }
+    std::size_t dropped() const { return m_dropped; }
+
+    // JSON: {"traceEvents":[...]}, время в микросекундах от создания Trace
+    void write(std::ostream &out) const
+    {
+        const double ticksPerUs = m_clock.ticksPerSecond() / 1e6;
+        const std::uint64_t origin = m_clock.startTicks();
+        out << "{\"traceEvents\":[";
+        bool first = true;
+        for (std::size_t i = 0; i < m_runs.size(); ++i) {
+            out << (first ? "" : ",") << "\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << i
+                << ",\"args\":{\"name\":\"";
+            writeEscaped(out, m_runs[i]);
+            out << "\"}}";
+            first = false;
+        }
+        for (const Event &event : m_events) {
+            const double ts = (event.start >= origin)
+                ? static_cast<double>(event.start - origin) / ticksPerUs : 0.0;
+            out << (first ? "" : ",") << "\n{\"name\":\"" << phaseToString(event.phase)
+                << "\",\"cat\":\"solver\",\"ph\":\"X\",\"pid\":1,\"tid\":" << event.run
+                << ",\"ts\":" << ts << ",\"dur\":" << static_cast<double>(event.duration) / ticksPerUs << "}";
+            first = false;
+        }
+        out << "\n],\"otherData\":{\"droppedEvents\":" << m_dropped << "}}\n";
+    }
+
+private:
+
+    struct Event {
+        Phase phase;
+        int run;
+        std::uint64_t start;
+        std::uint64_t duration;
+    };
+
+    static void writeEscaped(std::ostream &out, const std::string &text)
+    {
+        for (char c : text) {
+            if (c == '"' || c == '\\') {
+                out << '\\' << c;
+            } else if (static_cast<unsigned char>(c) >= 0x20) {
+                out << c;
+            }
+        }
+    }
+
+    TickClock m_clock;
+    std::vector<Event> m_events;
+    std::vector<std::string> m_runs;
+    std::size_t m_maxEvents;
+    std::size_t m_dropped;
+};
+
+/**
+ * Замеры фаз внутри метода. Enabled = false — пустые методы и пустой Scope,
+ * которые компилятор убирает целиком.
+ *
+ * Фаза отмечается объектом на стеке:
+ *   const auto phase = m_instrument.scope(SC::Phase::Function);
+ * Включённый замер — два чтения счётчика тактов и несколько сложений;
+ * событие в Trace пишется, только если он задан.
+ */
+template <bool Enabled>
+class Instrument;
+
+template <>
+class Instrument<false> {
+public:
+
+    struct Scope {
+    };
+
+    Scope scope(Phase, int = 1) { return {}; }
+    void setTrace(Trace *) {}
+    void begin() {}
+    void end() {}
+    void memoHit() {}
+    const SolveStats &stats() const { return m_stats; }
+
+private:
+
+    SolveStats m_stats;
+};
+
+template <>
+class Instrument<true> {
+public:
+
+    class Scope {
+    public:
+
+        Scope(Instrument *owner, Phase phase, int count)
+            : m_owner{ owner }
+            , m_phase{ phase }
+            , m_count{ count }
+            , m_start{ ticks() }
+        {
+            if (phase == Phase::LineSearch) {
+                ++m_owner->m_lineSearchDepth;
+            }
+        }
+        ~Scope() { m_owner->close(m_phase, m_count, m_start); }
+
+        Scope(const Scope &) = delete;
+        Scope &operator=(const Scope &) = delete;
+
+    private:
+
+        Instrument *m_owner;
+        Phase m_phase;
+        int m_count;
+        std::uint64_t m_start;
+    };
+
+    Scope scope(Phase phase, int count = 1) { return Scope(this, phase, count); }
+
+    // События фаз (nullptr — не записывать)
+    void setTrace(Trace *trace) { m_trace = trace; }
+
+    // Вызывать в начале solve()
+    void begin()
+    {
+        for (int i = 0; i < kPhaseCount; ++i) {
+            m_counts[i] = 0;
+            m_ticks[i] = 0;
+        }
+        m_lineSearchEvaluations = 0;
+        m_lineSearchDepth = 0;
+        m_memoHits = 0;
+        m_clock.restart();
+    }
+
+    // Вызывать в конце solve(): переводит такты в секунды
+    void end()
+    {
+        const double ticksPerSecond = m_clock.ticksPerSecond();
+        m_stats.enabled = true;
+        for (int i = 0; i < kPhaseCount; ++i) {
+            m_stats.phases[i].count = m_counts[i];
+            m_stats.phases[i].seconds = static_cast<double>(m_ticks[i]) / ticksPerSecond;
+        }
+        m_stats.lineSearchEvaluations = m_lineSearchEvaluations;
+        m_stats.memoHits = m_memoHits;
+        m_stats.totalSeconds = static_cast<double>(ticks() - m_clock.startTicks()) / ticksPerSecond;
+    }
+
+    const SolveStats &stats() const { return m_stats; }
+
+    // Значение функции взято из SC::ValueMemo
+    void memoHit() { ++m_memoHits; }
+
+private:
+
+    void close(Phase phase, int count, std::uint64_t start)
+    {
+        const std::uint64_t duration = ticks() - start;
+        const int index = static_cast<int>(phase);
+        m_counts[index] += count;
+        m_ticks[index] += duration;
+        if (phase == Phase::LineSearch) {
+            --m_lineSearchDepth;
+        } else if (phase == Phase::Function && m_lineSearchDepth > 0) {
+            m_lineSearchEvaluations += count;
+        }
+        if (m_trace) {
+            m_trace->add(phase, start, duration);
+        }
+    }
+
+    long long m_counts[kPhaseCount] = {};
+    std::uint64_t m_ticks[kPhaseCount] = {};
+    long long m_lineSearchEvaluations = 0;
+    int m_lineSearchDepth = 0;
+    long long m_memoHits = 0;
+    TickClock m_clock;
+    Trace *m_trace = nullptr;
+    SolveStats m_stats;
+};
+
+} // namespace SC
+
+#endif // SOLVERCORE_INSTRUMENT_HPP_
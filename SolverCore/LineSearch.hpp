@@ -0,0 +1,580 @@
+#ifndef SOLVERCORE_LINESEARCH_HPP_
+#define SOLVERCORE_LINESEARCH_HPP_
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+namespace SC {
+
+// Размер пакета точек для пакетного вычисления функции
+constexpr int kBatchSize = 16;
+
+// Скалярное произведение. Сумма начинается с первого слагаемого, а не с нуля:
+// для n == 2 результат побитово равен a[0] * b[0] + a[1] * b[1]
+inline double dot(const double *a, const double *b, size_t n)
+{
+    double sum = a[0] * b[0];
+    for (size_t i = 1; i < n; ++i) {
+        sum += a[i] * b[i];
+    }
+    return sum;
+}
+
+/**
+ * Пакетный одномерный поиск шага, начиная с отрезка [a, b].
+ *
+ * 1. Грубый поиск: сетка из kBatchSize точек на [a, b] (вместе с концами)
+ *    вычисляется одним вызовом evaluate(steps, values, n). Если лучшая точка —
+ *    правый конец, минимум может лежать дальше: сетка переносится за него с
+ *    вдвое большим шагом (не больше kMaxExpansions раз).
+ * 2. Уточнение: в вершину параболы через лучшую точку и соседние и по обе
+ *    стороны от неё ставятся kRefinePoints точки — тоже одним вызовом. Поиск
+ *    заканчивается, когда лучшее значение перестаёт улучшаться, когда отрезок
+ *    вокруг лучшей точки сузился до absTolerance + sqrt(eps) * |t| (методы
+ *    передают точность вычислений — точнее шаги не различаются) или после
+ *    maxRounds раундов.
+ *
+ * На гладкой функции парабола попадает в минимум за 2–3 раунда, т.е. поиск
+ * стоит одну сетку и несколько маленьких пакетов. Возвращается лучший из
+ * вычисленных шагов, чтобы значение в принятой точке уже было известно
+ * методу (SC::ValueMemo). Для максимума (minimize == false) ищется минимум -f;
+ * NaN хуже любого числа.
+ *
+ * evaluate: void(const double *steps, double *values, int n)
+ */
+template <typename BatchEvaluate>
+double gridLineSearch(BatchEvaluate &&evaluate, double a, double b, bool minimize,
+                      double absTolerance, int maxRounds = 8)
+{
+    constexpr int kMaxExpansions = 4;
+    constexpr int kRefinePoints = 3;
+    constexpr int kMaxRounds = 16;
+    constexpr int kCapacity = kBatchSize * (1 + kMaxExpansions) + kRefinePoints * kMaxRounds;
+    maxRounds = std::min(maxRounds, kMaxRounds);
+    const double relTolerance = std::sqrt(std::numeric_limits<double>::epsilon());
+    auto objective = [minimize](double value) {
+        if (std::isnan(value)) {
+            return std::numeric_limits<double>::infinity();
+        }
+        return minimize ? value : -value;
+    };
+
+    // Все вычисленные шаги по возрастанию и значения -f или f (минимизируются)
+    double ts[kCapacity];
+    double fs[kCapacity];
+    int count = 0;
+    auto add = [&](const double *steps, const double *values, int n) {
+        for (int i = 0; i < n && count < kCapacity; ++i) {
+            int pos = count;
+            while (pos > 0 && ts[pos - 1] > steps[i]) {
+                --pos;
+            }
+            if (pos > 0 && ts[pos - 1] == steps[i]) {
+                continue;
+            }
+            std::move_backward(ts + pos, ts + count, ts + count + 1);
+            std::move_backward(fs + pos, fs + count, fs + count + 1);
+            ts[pos] = steps[i];
+            fs[pos] = objective(values[i]);
+            ++count;
+        }
+    };
+    auto bestIndex = [&]() {
+        return static_cast<int>(std::min_element(fs, fs + count) - fs);
+    };
+
+    double steps[kBatchSize];
+    double values[kBatchSize];
+
+    double h = (b - a) / (kBatchSize - 1);
+    for (int i = 0; i < kBatchSize; ++i) {
+        steps[i] = a + h * i;
+    }
+    steps[kBatchSize - 1] = b;
+    evaluate(steps, values, kBatchSize);
+    add(steps, values, kBatchSize);
+    for (int e = 0; e < kMaxExpansions && bestIndex() == count - 1; ++e) {
+        const double from = ts[count - 1];
+        h *= 2.0;
+        for (int i = 0; i < kBatchSize; ++i) {
+            steps[i] = from + h * (i + 1);
+        }
+        evaluate(steps, values, kBatchSize);
+        add(steps, values, kBatchSize);
+    }
+
+    int best = bestIndex();
+    for (int round = 0; round < maxRounds; ++round) {
+        const double t = ts[best];
+        const double left = ts[std::max(best - 1, 0)];
+        const double right = ts[std::min(best + 1, count - 1)];
+        const double tolerance = relTolerance * std::fabs(t) + absTolerance;
+        if (right - left <= 2.0 * tolerance) {
+            break;
+        }
+
+        // Вершина параболы через лучшую точку и две ближайшие (у конца — обе с
+        // одной стороны); без неё — середина большей половины
+        double u = std::numeric_limits<double>::quiet_NaN();
+        if (count >= 3) {
+            const int i = std::min(std::max(best - 1, 0), count - 3);
+            const double x0 = ts[i], x1 = ts[i + 1], x2 = ts[i + 2];
+            const double f0 = fs[i], f1 = fs[i + 1], f2 = fs[i + 2];
+            const double p = (x1 - x0) * (x1 - x0) * (f1 - f2) - (x1 - x2) * (x1 - x2) * (f1 - f0);
+            const double q = (x1 - x0) * (f1 - f2) - (x1 - x2) * (f1 - f0);
+            if (q != 0.0 && std::isfinite(p / q)) {
+                u = x1 - 0.5 * p / q;
+            }
+        }
+        if (!(u > left && u < right)) {
+            u = (t - left > right - t) ? 0.5 * (left + t) : 0.5 * (t + right);
+        }
+        const double delta = std::max(tolerance, (right - left) / 16.0);
+        const double candidates[kRefinePoints] = { u, u - delta, u + delta };
+        int n = 0;
+        for (double c : candidates) {
+            if (c > left && c < right) {
+                steps[n++] = c;
+            }
+        }
+        evaluate(steps, values, n);
+        const double previous = fs[best];
+        add(steps, values, n);
+        best = bestIndex();
+        if (!(fs[best] < previous)) {
+            break; // Лучшее значение не улучшилось
+        }
+    }
+    return ts[best];
+}
+
+/**
+ * Пакетный поиск с дроблением шага (backtracking): кандидаты step, step*beta,
+ * step*beta^2, ... вычисляются пачками и возвращается первый, для которого
+ * accept(step, value) == true — тот же шаг, что и у последовательного цикла.
+ * Обычно подходит уже первый шаг, поэтому пачки растут 1, 2, 4, ... до chunk
+ * (не больше kBatchSize) точек. Если подходящего шага нет, возвращается fallback.
+ *
+ * evaluate: void(const double *steps, double *values, int n)
+ * accept:   bool(double step, double value)
+ */
+template <typename BatchEvaluate, typename Accept>
+double batchedBacktracking(BatchEvaluate &&evaluate, Accept &&accept, double step,
+                           double beta, double minStep, double fallback, int chunk)
+{
+    chunk = std::clamp(chunk, 1, kBatchSize);
+    double steps[kBatchSize];
+    double values[kBatchSize];
+
+    int size = 1;
+    while (step >= minStep) {
+        int n = 0;
+        for (; n < size && step >= minStep; ++n) {
+            steps[n] = step;
+            step *= beta;
+        }
+        evaluate(steps, values, n);
+        for (int i = 0; i < n; ++i) {
+            if (accept(steps[i], values[i])) {
+                return steps[i];
+            }
+        }
+        size = std::min(2 * size, chunk);
+    }
+    return fallback;
+}
+
+/**
+ * Последовательный поиск шага методом золотого сечения на отрезке [a, b]:
+ * одна новая точка на итерацию, отрезок сжимается в 1.618 раза. Оставлен
+ * для сравнения с brentLineSearch (LineSearchType::GOLDEN), поэтому точность
+ * та же: поиск заканчивается, когда отрезок сузился до
+ * 2 * (absTolerance + sqrt(eps) * |t|), а maxIterations — только
+ * страховка. Возвращается лучший из вычисленных шагов (SC::ValueMemo).
+ *
+ * evaluate: double(double step)
+ */
+template <typename Evaluate>
+double goldenSectionSearch(Evaluate &&evaluate, double a, double b, bool minimize,
+                           double absTolerance, int maxIterations = 100)
+{
+    const double golden_ratio = 0.618033988749895;
+    const double relTolerance = std::sqrt(std::numeric_limits<double>::epsilon());
+    auto better = [minimize](double f1, double f2) { return minimize ? (f1 < f2) : (f1 > f2); };
+
+    double h1 = b - (b - a) * golden_ratio;
+    double h2 = a + (b - a) * golden_ratio;
+    double f1 = evaluate(h1);
+    double f2 = evaluate(h2);
+
+    for (int i = 0; i < maxIterations; ++i) {
+        const double tol = relTolerance * std::fabs(0.5 * (a + b)) + absTolerance;
+        if (b - a <= 2.0 * tol) {
+            break;
+        }
+        if (better(f1, f2)) {
+            b = h2; h2 = h1; f2 = f1;
+            h1 = b - (b - a) * golden_ratio;
+            f1 = evaluate(h1);
+        } else {
+            a = h1; h1 = h2; f1 = f2;
+            h2 = a + (b - a) * golden_ratio;
+            f2 = evaluate(h2);
+        }
+    }
+    return better(f1, f2) ? h1 : h2;
+}
+
+/**
+ * Одномерная минимизация методом Брента на отрезке [a, b] с известной
+ * внутренней точкой x и значением fx = evaluate(x).
+ *
+ * Каждая итерация ставит новую точку в вершину параболы через три лучшие
+ * точки; шаг параболы принимается, только если он лежит внутри отрезка и
+ * короче половины позапрошлого шага, иначе делается шаг золотого сечения
+ * в большую часть отрезка. Поэтому на гладких функциях хватает нескольких
+ * вычислений, а в худшем случае сходимость не медленнее золотого сечения.
+ *
+ * Точки ставятся не ближе absTolerance + sqrt(eps) * |x| друг к другу: ближе
+ * методы всё равно не различают шаги, т.к. округляют их до точности вычислений.
+ * Для максимума (minimize == false) минимизируется -f; NaN хуже любого числа.
+ * Возвращается лучшая из вычисленных точек (SC::ValueMemo).
+ *
+ * evaluate: double(double step)
+ */
+template <typename Evaluate>
+double brentMinimize(Evaluate &&evaluate, double a, double x, double fx, double b,
+                     bool minimize, double absTolerance, int maxIterations = 100)
+{
+    const double c = 0.381966011250105; // (3 - sqrt(5)) / 2
+    const double relTolerance = std::sqrt(std::numeric_limits<double>::epsilon());
+    auto objective = [minimize](double value) {
+        if (std::isnan(value)) {
+            return std::numeric_limits<double>::infinity();
+        }
+        return minimize ? value : -value;
+    };
+
+    fx = objective(fx);
+    double w = x, fw = fx; // Вторая по качеству точка
+    double v = x, fv = fx; // Предыдущее значение w
+    double d = 0.0;        // Последний шаг
+    double e = 0.0;        // Позапрошлый шаг
+
+    for (int i = 0; i < maxIterations; ++i) {
+        const double xm = 0.5 * (a + b);
+        const double tol1 = relTolerance * std::fabs(x) + absTolerance;
+        const double tol2 = 2.0 * tol1;
+        if (std::fabs(x - xm) <= tol2 - 0.5 * (b - a)) {
+            break;
+        }
+
+        bool golden = true;
+        if (std::fabs(e) > tol1) {
+            // Парабола через x, w, v: вершина в x + p / q
+            const double r = (x - w) * (fx - fv);
+            double q = (x - v) * (fx - fw);
+            double p = (x - v) * q - (x - w) * r;
+            q = 2.0 * (q - r);
+            if (q > 0.0) {
+                p = -p;
+            } else {
+                q = -q;
+            }
+            const double previous = e;
+            e = d;
+            // Сравнения с NaN ложны — вырожденная парабола даёт шаг золотого сечения
+            if (std::fabs(p) < std::fabs(0.5 * q * previous) && p > q * (a - x) && p < q * (b - x)) {
+                d = p / q;
+                const double u = x + d;
+                if (u - a < tol2 || b - u < tol2) {
+                    d = (xm >= x) ? tol1 : -tol1;
+                }
+                golden = false;
+            }
+        }
+        if (golden) {
+            e = (x >= xm) ? a - x : b - x;
+            d = c * e;
+        }
+
+        const double u = (std::fabs(d) >= tol1) ? x + d : x + (d > 0.0 ? tol1 : -tol1);
+        const double fu = objective(evaluate(u));
+
+        // Соседняя точка с тем же значением: функция не различает шаги
+        // точнее, дальнейшее сжатие отрезка только тратит вычисления
+        const bool flat = (fu == fx) && std::fabs(u - x) <= tol2;
+        if (fu <= fx) {
+            if (u >= x) a = x; else b = x;
+            v = w; fv = fw;
+            w = x; fw = fx;
+            x = u; fx = fu;
+        } else {
+            if (u < x) a = u; else b = u;
+            if (fu <= fw || w == x) {
+                v = w; fv = fw;
+                w = u; fw = fu;
+            } else if (fu <= fv || v == x || v == w) {
+                v = u; fv = fu;
+            }
+        }
+        if (flat) {
+            break;
+        }
+    }
+    return x;
+}
+
+/**
+ * Поиск шага методом Брента, начиная с отрезка [a, b] (см. brentMinimize).
+ *
+ * Сначала минимум заключается в вилку: первая точка — точка золотого сечения
+ * отрезка; если она лучше a, а b ещё лучше, минимум может лежать правее b, и
+ * отрезок расширяется в 1.618 раза, пока функция улучшается (не больше
+ * kMaxExpansions раз). Без этого поиск сходился бы к концу отрезка со
+ * скоростью золотого сечения.
+ *
+ * evaluate: double(double step)
+ */
+template <typename Evaluate>
+double brentLineSearch(Evaluate &&evaluate, double a, double b, bool minimize,
+                       double absTolerance, int maxIterations = 100)
+{
+    constexpr int kMaxExpansions = 20;
+    auto better = [minimize](double f1, double f2) { return minimize ? (f1 < f2) : (f1 > f2); };
+
+    double x = a + 0.381966011250105 * (b - a);
+    double fx = evaluate(x);
+    if (better(fx, evaluate(a))) {
+        double fb = evaluate(b);
+        for (int i = 0; i < kMaxExpansions && better(fb, fx); ++i) {
+            const double next = b + 1.618033988749895 * (b - x);
+            a = x;
+            x = b;
+            fx = fb;
+            b = next;
+            fb = evaluate(b);
+        }
+    }
+    return brentMinimize(evaluate, a, x, fx, b, minimize, absTolerance, maxIterations);
+}
+
+/**
+ * Прошлый принятый шаг поиска по условиям Вольфе и производная f'(0) перед
+ * ним. Начальный шаг следующего поиска даёт то же ожидаемое изменение
+ * функции (step * f'(0)), но не длиннее kMaxGrowth прошлых шагов: у оптимума
+ * f'(0) мала, и одно отношение давало бы огромный шаг.
+ */
+struct WolfeHistory {
+    static constexpr double kMaxGrowth = 10.0;
+
+    double step = 0.0;
+    double slope = 0.0;
+
+    // fallback — шаг первой итерации
+    double initialStep(double currentSlope, double fallback) const
+    {
+        if (step <= 0.0 || currentSlope == 0.0) {
+            return fallback;
+        }
+        const double guess = step * slope / currentSlope;
+        return (guess > 0.0) ? std::min(guess, kMaxGrowth * step) : fallback;
+    }
+};
+
+/**
+ * Результат strongWolfeLineSearch: принятый шаг и пробная точка в нём.
+ * found == false — не найден даже шаг с достаточным убыванием.
+ */
+template <typename Sample>
+struct WolfeStep {
+    double step;
+    Sample sample;
+    bool found;
+};
+
+/**
+ * Поиск шага по сильным условиям Вольфе (в духе Море–Туенте):
+ *
+ *   f(t) <= f(0) + c1 * t * f'(0)   — достаточное убывание,
+ *   |f'(t)| <= c2 * |f'(0)|          — производная по направлению мала.
+ *
+ * В каждой пробной точке нужны значение и производная по направлению,
+ * поэтому evaluate(step) возвращает Sample с полями value и slope — методы
+ * берут их из одного вычисления значения с градиентом, а принятый Sample
+ * (с градиентом в новой точке) возвращается вызывающему.
+ *
+ * Шаг увеличивается от step (не дальше maxStep — границы области), пока
+ * не найден интервал с точкой минимума, затем интервал сужается кубической
+ * интерполяцией по значениям и производным на концах (с откатом к делению
+ * пополам у краёв). c2 = 0.01 даёт почти точный поиск: он нужен методу
+ * сопряжённых градиентов, а наискорейшему спуску не даёт застрять в овраге;
+ * на квадратичной функции кубика попадает в минимум за одно вычисление.
+ * Для максимума (minimize == false) условия проверяются для -f.
+ *
+ * evaluate: Sample(double step), start — Sample в шаге 0 (f'(0) должна
+ * указывать на улучшение, иначе found == false). Если за maxIterations
+ * условия не выполнены, возвращается лучший шаг с достаточным убыванием.
+ */
+template <typename Evaluate, typename Sample>
+WolfeStep<Sample> strongWolfeLineSearch(Evaluate &&evaluate, const Sample &start, double step,
+                                        bool minimize, double tolerance,
+                                        double maxStep, double c2 = 0.01, int maxIterations = 30)
+{
+    const double c1 = 1e-4;
+    const double sign = minimize ? 1.0 : -1.0;
+    const double f0 = sign * start.value;
+    const double g0 = sign * start.slope;
+    step = std::min(step, maxStep);
+    if (!(g0 < 0.0) || !(step > 0.0)) {
+        return { 0.0, start, false };
+    }
+
+    // Минимум кубики через (a, fa, ga) и (b, fb, gb); NaN, если его нет
+    auto cubicMinimum = [](double a, double fa, double ga, double b, double fb, double gb) {
+        const double d1 = ga + gb - 3.0 * (fa - fb) / (a - b);
+        const double discriminant = d1 * d1 - ga * gb;
+        if (!(discriminant >= 0.0)) {
+            return std::numeric_limits<double>::quiet_NaN();
+        }
+        const double d2 = std::copysign(std::sqrt(discriminant), b - a);
+        return b - (b - a) * (gb + d2 - d1) / (gb - ga + 2.0 * d2);
+    };
+    auto sufficient = [&](double t, double f) { return f <= f0 + c1 * t * g0; };
+    auto curvature = [&](double g) { return std::fabs(g) <= -c2 * g0; };
+
+    // lo — лучшая точка с достаточным убыванием, hi — другой конец интервала,
+    // prev — предыдущая lo (для экстраполяции, пока интервал не найден)
+    double lo = 0.0, f_lo = f0, g_lo = g0;
+    Sample lo_sample = start;
+    double hi = 0.0, f_hi = 0.0, g_hi = 0.0;
+    double prev = 0.0, f_prev = f0, g_prev = g0;
+    bool bracketed = false;
+
+    for (int i = 0; i < maxIterations; ++i) {
+        const Sample sample = evaluate(step);
+        const double f = sign * sample.value;
+        const double g = sign * sample.slope;
+        if (std::isnan(f) || std::isnan(g) || !sufficient(step, f) || f >= f_lo) {
+            // Шаг слишком длинный (или вне области определения)
+            hi = step;
+            f_hi = std::isnan(f) ? std::numeric_limits<double>::infinity() : f;
+            g_hi = std::isnan(g) ? 0.0 : g;
+            bracketed = true;
+        } else {
+            if (curvature(g)) {
+                return { step, sample, true };
+            }
+            if (g * (bracketed ? (hi - lo) : 1.0) >= 0.0) {
+                // Минимум между прежней lo и step
+                hi = lo; f_hi = f_lo; g_hi = g_lo;
+                bracketed = true;
+            }
+            prev = lo; f_prev = f_lo; g_prev = g_lo;
+            lo = step; f_lo = f; g_lo = g;
+            lo_sample = sample;
+        }
+
+        if (bracketed) {
+            if (std::fabs(hi - lo) <= tolerance * std::max(1.0, std::fabs(lo))) {
+                break;
+            }
+            // Кубика, прижатая внутрь интервала не ближе 10% его длины к концам;
+            // без кубики — деление пополам
+            const double left = std::min(lo, hi), right = std::max(lo, hi);
+            const double margin = 0.1 * (right - left);
+            const double next = std::isfinite(f_hi) ? cubicMinimum(lo, f_lo, g_lo, hi, f_hi, g_hi)
+                                                    : std::numeric_limits<double>::quiet_NaN();
+            step = std::isnan(next) ? 0.5 * (lo + hi) : std::clamp(next, left + margin, right - margin);
+        } else {
+            if (lo >= maxStep) {
+                // Функция убывает до самой границы допустимых шагов
+                return { lo, lo_sample, true };
+            }
+            // Функция ещё убывает: кубика за lo, шаг растёт в 1.1–4 раза от последнего
+            const double lower = lo + 1.1 * (lo - prev), upper = lo + 4.0 * (lo - prev);
+            double next = cubicMinimum(prev, f_prev, g_prev, lo, f_lo, g_lo);
+            if (!(next >= lower && next <= upper)) {
+                next = upper;
+            }
+            step = std::min(next, maxStep);
+        }
+    }
+    // Условия не выполнены: лучшая точка с достаточным убыванием, если она есть
+    return { lo, lo_sample, lo > 0.0 };
+}
+
+/**
+ * Пробная точка findWolfeStep: координаты, значение с градиентом в них и
+ * производная вдоль направления (поля value и slope — для strongWolfeLineSearch).
+ */
+struct WolfePoint {
+    std::vector<double> point;
+    std::vector<double> gradient;
+    double value;
+    double slope;
+};
+
+/**
+ * Шаг вдоль dir из x по сильным условиям Вольфе внутри [lower, upper].
+ *
+ * evaluate: double(const double *point, double *gradient) — значение и
+ * градиент одним вычислением, поэтому в accepted приходит и градиент в новой
+ * точке; value и gradient — они же в x. round: double(double) — округление до
+ * точности вычислений: пробные шаги и точки округляются так же, как при
+ * переходе по найденному шагу.
+ *
+ * Шаг не выводит за границы: за границей точка прижимается к ней, и
+ * производная по направлению перестаёт соответствовать значениям. Начальный
+ * шаг берётся из history (на первой итерации — не длиннее 0.5 / |dir|),
+ * после успеха history обновляется. false — шаг не найден (направление не
+ * ведёт к улучшению); методы тогда ищут шаг одномерным поиском.
+ */
+template <typename Evaluate, typename Round>
+bool findWolfeStep(Evaluate &&evaluate, Round &&round, const std::vector<double> &x,
+                   const std::vector<double> &dir, double value, const std::vector<double> &gradient,
+                   const std::vector<double> &lower, const std::vector<double> &upper,
+                   bool minimize, double tolerance, WolfeHistory &history, double &step,
+                   WolfePoint &accepted)
+{
+    const size_t n = x.size();
+    auto sample = [&](double t) {
+        t = round(t);
+        WolfePoint point{ std::vector<double>(n), std::vector<double>(n), 0.0, 0.0 };
+        for (size_t i = 0; i < n; ++i) {
+            point.point[i] = round(std::max(lower[i], std::min(upper[i], x[i] + t * dir[i])));
+        }
+        point.value = evaluate(point.point.data(), point.gradient.data());
+        point.slope = dot(point.gradient.data(), dir.data(), n);
+        return point;
+    };
+    const WolfePoint origin{ x, gradient, value, dot(gradient.data(), dir.data(), n) };
+    if (origin.slope == 0.0) {
+        return false;
+    }
+
+    double maxStep = std::numeric_limits<double>::infinity();
+    for (size_t i = 0; i < n; ++i) {
+        if (dir[i] > 0.0) maxStep = std::min(maxStep, (upper[i] - x[i]) / dir[i]);
+        if (dir[i] < 0.0) maxStep = std::min(maxStep, (lower[i] - x[i]) / dir[i]);
+    }
+
+    const double norm = std::sqrt(dot(dir.data(), dir.data(), n));
+    const double initial = history.initialStep(origin.slope, (norm > 1e-10) ? std::min(1.0, 0.5 / norm) : 1.0);
+
+    const auto result = strongWolfeLineSearch(sample, origin, initial, minimize, tolerance, maxStep);
+    if (!result.found) {
+        return false;
+    }
+    step = round(result.step);
+    accepted = result.sample;
+    history = { step, origin.slope };
+    return true;
+}
+
+} // namespace SC
+
+#endif // SOLVERCORE_LINESEARCH_HPP_
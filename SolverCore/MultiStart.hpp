@@ -0,0 +1,171 @@
+#ifndef SOLVERCORE_MULTISTART_HPP_
+#define SOLVERCORE_MULTISTART_HPP_
+
+#include <SolverCore/Reporter.hpp>
+#include <SolverCore/Sampling.hpp>
+#include <SolverCore/ThreadPool.hpp>
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace SC {
+
+/**
+ * Система отчётности для отдельных запусков мультистарта: запоминает только
+ * последний insertResult(). Отчётность выключена (см. SC::reporterEnabled),
+ * поэтому методы не тратят время на строки таблиц и сообщения.
+ */
+class ResultRecorder {
+public:
+
+    static constexpr bool enabled = false;
+
+    int begin()
+    {
+        m_hasResult = false;
+        return 0;
+    }
+    int end() { return 0; }
+
+    void insertResult(double x, double y, double funcValue)
+    {
+        m_point = { x, y };
+        m_value = funcValue;
+        m_hasResult = true;
+    }
+
+    bool hasResult() const { return m_hasResult; }
+    const Point &point() const { return m_point; }
+    double value() const { return m_value; }
+
+private:
+
+    bool m_hasResult = false;
+    Point m_point{ 0.0, 0.0 };
+    double m_value = 0.0;
+};
+
+// Итог одного запуска мультистарта
+template <typename Status>
+struct StartRun {
+    Point start{ 0.0, 0.0 };     // Начальное приближение
+    Status status{};             // Результат solve() (или setInputData())
+    bool found = false;          // Метод сообщил точку экстремума
+    Point optimum{ 0.0, 0.0 };   // Найденная точка
+    double value = 0.0;          // Значение функции в ней
+    int iterations = 0;
+    int functionCalls = 0;
+};
+
+// Различный локальный экстремум, найденный одним или несколькими запусками
+struct LocalOptimum {
+    Point point;
+    double value;
+    size_t hits; // Сколько запусков сошлось в эту точку
+};
+
+template <typename Status>
+struct MultiStartResult {
+    std::vector<StartRun<Status>> runs; // В порядке начальных точек
+    std::vector<LocalOptimum> optima;   // Лучший — первым
+
+    bool found() const { return !optima.empty(); }
+    const LocalOptimum &best() const { return optima.front(); }
+};
+
+/**
+ * Мультистарт: метод Method запускается из каждой точки starts параллельно
+ * на пуле потоков. У каждого потока пула свой экземпляр метода (а значит,
+ * свой парсер и свои вычислители) и своя копия входных данных, поэтому
+ * запуски не делят изменяемого состояния. Границы, тип экстремума и прочие
+ * настройки берутся из data, меняется только начальное приближение.
+ *
+ * Точки, найденные успешными запусками, объединяются в локальные экстремумы:
+ * точки ближе mergeRadius друг к другу считаются одним экстремумом.
+ *
+ * Method — шаблон метода с параметром Reporter (GD::GradientDescent и т.п.).
+ */
+template <template <typename> class Method, typename InputData>
+auto multiStart(const InputData &data, const std::vector<Point> &starts, double mergeRadius,
+                ThreadPool &pool)
+{
+    using Solver = Method<ResultRecorder>;
+    using Status = decltype(std::declval<Solver &>().solve());
+
+    struct Worker {
+        InputData data;
+        ResultRecorder reporter;
+        std::unique_ptr<Solver> solver;
+        bool ready = false; // setInputData() прошёл для data
+    };
+    std::vector<Worker> workers(pool.size());
+
+    const Box box{ data.x_left_bound, data.x_right_bound, data.y_left_bound, data.y_right_bound };
+    MultiStartResult<Status> result;
+    result.runs.resize(starts.size());
+
+    pool.parallelFor(starts.size(), [&](size_t i, unsigned index) {
+        Worker &worker = workers[index];
+        StartRun<Status> &run = result.runs[i];
+        run.start = starts[i];
+
+        if (!worker.solver) {
+            worker.data = data;
+            worker.solver = std::make_unique<Solver>(&worker.reporter);
+        }
+        worker.data.initial_x = run.start.x;
+        worker.data.initial_y = run.start.y;
+        if (!worker.ready) {
+            run.status = worker.solver->setInputData(&worker.data);
+            if (run.status != Status::Success) {
+                return;
+            }
+            worker.ready = true;
+        } else if (run.start.x < box.xLeft || run.start.x > box.xRight) {
+            run.status = Status::InvalidInitialX;
+            return;
+        } else if (run.start.y < box.yLeft || run.start.y > box.yRight) {
+            run.status = Status::InvalidInitialY;
+            return;
+        }
+
+        run.status = worker.solver->solve();
+        run.iterations = worker.solver->getIterations();
+        run.functionCalls = worker.solver->getFunctionCalls();
+        run.found = worker.reporter.hasResult();
+        if (run.found) {
+            run.optimum = worker.reporter.point();
+            run.value = worker.reporter.value();
+        }
+    });
+
+    // Объединение результатов в порядке от лучшего значения к худшему
+    const bool minimize = (data.extremum_type == decltype(data.extremum_type)::MINIMUM);
+    std::vector<const StartRun<Status> *> successful;
+    for (const auto &run : result.runs) {
+        if (run.found && run.status == Status::Success && !std::isnan(run.value)) {
+            successful.push_back(&run);
+        }
+    }
+    std::sort(successful.begin(), successful.end(), [minimize](const auto *a, const auto *b) {
+        return minimize ? (a->value < b->value) : (a->value > b->value);
+    });
+    for (const auto *run : successful) {
+        auto same = std::find_if(result.optima.begin(), result.optima.end(), [&](const LocalOptimum &optimum) {
+            return std::hypot(optimum.point.x - run->optimum.x, optimum.point.y - run->optimum.y) <= mergeRadius;
+        });
+        if (same != result.optima.end()) {
+            ++same->hits;
+        } else {
+            result.optima.push_back({ run->optimum, run->value, 1 });
+        }
+    }
+    return result;
+}
+
+} // namespace SC
+
+#endif // SOLVERCORE_MULTISTART_HPP_
@@ -0,0 +1,393 @@
+#ifndef SOLVERCORE_NATIVEFUNCTION_HPP_
+#define SOLVERCORE_NATIVEFUNCTION_HPP_
+
+#include <SolverCore/Expression.hpp>
+#include <atomic>
+#include <cctype>
+#include <cerrno>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#if __has_include(<dlfcn.h>) && __has_include(<unistd.h>) && __has_include(<spawn.h>)
+#include <dlfcn.h>
+#include <fcntl.h>
+#include <spawn.h>
+#include <sys/wait.h>
+#include <unistd.h>
+extern char **environ;
+#define SOLVERCORE_HAS_DLOPEN 1
+#else
+#define SOLVERCORE_HAS_DLOPEN 0
+#endif
+
+namespace SC {
+
+/**
+ * Функция, скомпилированная в машинный код системным компилятором.
+ *
+ * Выражение переводится в исходник C++ (по одной константе на узел),
+ * собирается в разделяемую библиотеку командой из переменной окружения
+ * SOLVERCORE_CXX (по умолчанию "c++") и загружается через dlopen.
+ * Компилятор запускается через posix_spawnp без оболочки: SOLVERCORE_CXX
+ * делится на аргументы (кавычки и '\' как в sh, без подстановок), пути
+ * передаются отдельными аргументами.
+ *
+ * Сборка занимает доли секунды, поэтому библиотеки кешируются по тексту
+ * исходника; хранится не больше LIBRARY_CACHE_CAPACITY последних, вытесненная
+ * выгружается (dlclose), когда её отпустит последняя функция.
+ *
+ * На платформах без dlopen compile() всегда возвращает false.
+ */
+class NativeFunction {
+public:
+
+    using Function = double (*)(double, double);
+    using BatchFunction = void (*)(const double *, const double *, double *, unsigned long);
+
+    static constexpr size_t LIBRARY_CACHE_CAPACITY = 64;
+
+    bool compile(const Expression &expression)
+    {
+        m_function = nullptr;
+        m_batch = nullptr;
+        m_library.reset();
+        m_error.clear();
+
+        std::string source;
+        if (!emitSource(expression, source)) {
+            m_error = "Выражение не может быть переведено в C++";
+            return false;
+        }
+#if SOLVERCORE_HAS_DLOPEN
+        m_library = LibraryCache::shared().get(source, m_error);
+        if (!m_library) {
+            return false;
+        }
+        m_function = m_library->function;
+        m_batch = m_library->batch;
+        return true;
+#else
+        m_error = "Загрузка библиотек не поддерживается на этой платформе";
+        return false;
+#endif
+    }
+
+    bool isLoaded() const { return m_function != nullptr; }
+    const std::string &errorMessage() const { return m_error; }
+
+    double operator()(double x, double y) const { return m_function(x, y); }
+    void operator()(const double *xs, const double *ys, double *out, size_t n) const
+    {
+        m_batch(xs, ys, out, static_cast<unsigned long>(n));
+    }
+
+    // Текст на C++: extern "C" solvercore_eval(x, y) и пакетный solvercore_eval_batch(xs, ys, out, n)
+    static bool emitSource(const Expression &expression, std::string &out)
+    {
+        const std::vector<Node> &nodes = expression.nodes();
+        if (nodes.empty()) {
+            return false;
+        }
+        out = "#include <cmath>\n"
+              "static inline double sc_sign(double v) { return (v > 0.0) ? 1.0 : ((v < 0.0) ? -1.0 : 0.0); }\n"
+              "extern \"C\" double solvercore_eval(double x, double y)\n{\n";
+        for (size_t i = 0; i < nodes.size(); ++i) {
+            std::string rhs;
+            if (!emitNode(nodes[i], rhs)) {
+                return false;
+            }
+            out += "    const double t" + std::to_string(i) + " = " + rhs + ";\n";
+        }
+        out += "    return t" + std::to_string(nodes.size() - 1) + ";\n}\n"
+               "extern \"C\" void solvercore_eval_batch(const double *xs, const double *ys, double *out, unsigned long n)\n{\n"
+               "    for (unsigned long i = 0; i < n; ++i) out[i] = solvercore_eval(xs[i], ys[i]);\n}\n";
+        return true;
+    }
+
+    // Аргументы командной строки: пробелы разделяют, кавычки и '\\' — как в sh;
+    // переменные, шаблоны и прочие подстановки оболочки не выполняются
+    static bool splitCommand(const std::string &command, std::vector<std::string> &out)
+    {
+        out.clear();
+        std::string word;
+        bool inWord = false;
+        char quote = 0;
+        for (size_t i = 0; i < command.size(); ++i) {
+            const char c = command[i];
+            if (quote == '\'') {
+                if (c == '\'') {
+                    quote = 0;
+                } else {
+                    word += c;
+                }
+            } else if (c == '\\' && quote == 0) {
+                if (++i == command.size()) {
+                    return false;
+                }
+                word += command[i];
+                inWord = true;
+            } else if (quote == '"') {
+                if (c == '"') {
+                    quote = 0;
+                } else if (c == '\\' && i + 1 < command.size() &&
+                           (command[i + 1] == '"' || command[i + 1] == '\\')) {
+                    word += command[++i];
+                } else {
+                    word += c;
+                }
+            } else if (c == '\'' || c == '"') {
+                quote = c;
+                inWord = true;
+            } else if (std::isspace(static_cast<unsigned char>(c))) {
+                if (inWord) {
+                    out.push_back(word);
+                    word.clear();
+                    inWord = false;
+                }
+            } else {
+                word += c;
+                inWord = true;
+            }
+        }
+        if (quote != 0) {
+            return false;
+        }
+        if (inWord) {
+            out.push_back(word);
+        }
+        return !out.empty();
+    }
+
+private:
+
+#if SOLVERCORE_HAS_DLOPEN
+    // Загруженная библиотека; файлы удаляются вместе с ней
+    struct Library {
+        void *handle = nullptr;
+        Function function = nullptr;
+        BatchFunction batch = nullptr;
+        std::filesystem::path directory;
+
+        ~Library()
+        {
+            if (handle) {
+                dlclose(handle);
+            }
+            std::error_code ec;
+            std::filesystem::remove_all(directory, ec);
+        }
+
+        static std::shared_ptr<Library> build(const std::string &source, std::string &error)
+        {
+            static std::atomic<int> counter{ 0 };
+            std::error_code ec;
+            auto library = std::make_shared<Library>();
+            library->directory = std::filesystem::temp_directory_path(ec) /
+                ("solvercore-" + std::to_string(getpid()) + "-" + std::to_string(counter++));
+            if (ec || !std::filesystem::create_directories(library->directory, ec)) {
+                error = "Не удалось создать временный каталог";
+                return nullptr;
+            }
+            const auto src = library->directory / "function.cpp";
+            const auto lib = library->directory / "function.so";
+            const auto log = library->directory / "build.log";
+            {
+                std::ofstream file(src);
+                file << source;
+                if (!file) {
+                    error = "Не удалось записать исходник";
+                    return nullptr;
+                }
+            }
+
+            const char *cxx = std::getenv("SOLVERCORE_CXX");
+            std::vector<std::string> args;
+            if (!splitCommand(cxx && *cxx ? cxx : "c++", args)) {
+                error = "Некорректная команда компилятора в SOLVERCORE_CXX";
+                return nullptr;
+            }
+            // -ffp-contract=off: те же результаты, что у muParser и ленты (без FMA)
+            for (const char *flag : { "-O2", "-fPIC", "-shared", "-ffp-contract=off", "-o" }) {
+                args.push_back(flag);
+            }
+            args.push_back(lib.string());
+            args.push_back(src.string());
+            if (!run(args, log)) {
+                error = "Ошибка компиляции функции (" + log.string() + ")";
+                return nullptr;
+            }
+
+            library->handle = dlopen(lib.c_str(), RTLD_NOW | RTLD_LOCAL);
+            if (!library->handle) {
+                const char *msg = dlerror();
+                error = msg ? msg : "dlopen";
+                return nullptr;
+            }
+            library->function = reinterpret_cast<Function>(dlsym(library->handle, "solvercore_eval"));
+            library->batch = reinterpret_cast<BatchFunction>(dlsym(library->handle, "solvercore_eval_batch"));
+            if (!library->function || !library->batch) {
+                error = "Символ solvercore_eval не найден";
+                return nullptr;
+            }
+            return library;
+        }
+
+        // Запуск без оболочки, stdout и stderr — в log; true при нулевом коде выхода
+        static bool run(const std::vector<std::string> &args, const std::filesystem::path &log)
+        {
+            std::vector<char *> argv;
+            for (const std::string &arg : args) {
+                argv.push_back(const_cast<char *>(arg.c_str()));
+            }
+            argv.push_back(nullptr);
+
+            posix_spawn_file_actions_t actions;
+            if (posix_spawn_file_actions_init(&actions) != 0) {
+                return false;
+            }
+            posix_spawn_file_actions_addopen(&actions, STDOUT_FILENO, log.c_str(),
+                                             O_WRONLY | O_CREAT | O_TRUNC, 0644);
+            posix_spawn_file_actions_adddup2(&actions, STDOUT_FILENO, STDERR_FILENO);
+
+            pid_t pid = 0;
+            const int spawned = posix_spawnp(&pid, argv[0], &actions, nullptr, argv.data(), environ);
+            posix_spawn_file_actions_destroy(&actions);
+            if (spawned != 0) {
+                std::ofstream(log) << args[0] << ": " << std::strerror(spawned) << "\n";
+                return false;
+            }
+            int status = 0;
+            while (waitpid(pid, &status, 0) < 0) {
+                if (errno != EINTR) {
+                    return false;
+                }
+            }
+            return WIFEXITED(status) && WEXITSTATUS(status) == 0;
+        }
+    };
+
+    // Последние LIBRARY_CACHE_CAPACITY библиотек по тексту исходника
+    class LibraryCache {
+    public:
+
+        static LibraryCache &shared()
+        {
+            static LibraryCache cache;
+            return cache;
+        }
+
+        // Сборка под блокировкой: один исходник не компилируется дважды
+        std::shared_ptr<Library> get(const std::string &source, std::string &error)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            auto it = m_entries.find(source);
+            if (it != m_entries.end()) {
+                m_order.splice(m_order.begin(), m_order, it->second.position);
+                return it->second.library;
+            }
+            auto library = Library::build(source, error);
+            if (!library) {
+                return nullptr;
+            }
+            m_order.push_front(source);
+            m_entries.emplace(source, Entry{ library, m_order.begin() });
+            while (m_entries.size() > LIBRARY_CACHE_CAPACITY) {
+                m_entries.erase(m_order.back());
+                m_order.pop_back();
+            }
+            return library;
+        }
+
+    private:
+
+        struct Entry {
+            std::shared_ptr<Library> library;
+            std::list<std::string>::iterator position; // Место в m_order
+        };
+
+        std::mutex m_mutex;
+        std::unordered_map<std::string, Entry> m_entries;
+        std::list<std::string> m_order; // От недавно использованных к давним
+    };
+
+    std::shared_ptr<Library> m_library;
+#else
+    struct Library {};
+    std::shared_ptr<Library> m_library;
+#endif
+
+    Function m_function = nullptr;
+    BatchFunction m_batch = nullptr;
+    std::string m_error;
+
+    static std::string ref(int index) { return "t" + std::to_string(index); }
+
+    static bool emitNode(const Node &node, std::string &rhs)
+    {
+        const std::string a = ref(node.a);
+        const std::string b = ref(node.b);
+        switch (node.op) {
+        case Op::Const: {
+            if (!std::isfinite(node.value)) {
+                return false;
+            }
+            char buffer[64];
+            std::snprintf(buffer, sizeof(buffer), "%a", node.value); // Точное представление
+            rhs = std::signbit(node.value) ? "(" + std::string(buffer) + ")" : std::string(buffer);
+            return true;
+        }
+        case Op::VarX:  rhs = "x"; return true;
+        case Op::VarY:  rhs = "y"; return true;
+        case Op::Neg:   rhs = "-" + a; return true;
+        case Op::Add:   rhs = a + " + " + b; return true;
+        case Op::Sub:   rhs = a + " - " + b; return true;
+        case Op::Mul:   rhs = a + " * " + b; return true;
+        case Op::Div:   rhs = a + " / " + b; return true;
+        case Op::Pow:   rhs = "std::pow(" + a + ", " + b + ")"; return true;
+        case Op::Min:   rhs = "(" + b + " < " + a + ") ? " + b + " : " + a; return true;
+        case Op::Max:   rhs = "(" + a + " < " + b + ") ? " + b + " : " + a; return true;
+        case Op::Atan2: rhs = "std::atan2(" + a + ", " + b + ")"; return true;
+        case Op::Sign:  rhs = "sc_sign(" + a + ")"; return true;
+        case Op::Rint:  rhs = "std::floor(" + a + " + 0.5)"; return true;
+        case Op::Ln:    rhs = "std::log(" + a + ")"; return true;
+        case Op::Abs:   rhs = "std::fabs(" + a + ")"; return true;
+        default:        break;
+        }
+        const char *name = nullptr;
+        switch (node.op) {
+        case Op::Sin:   name = "sin"; break;
+        case Op::Cos:   name = "cos"; break;
+        case Op::Tan:   name = "tan"; break;
+        case Op::Asin:  name = "asin"; break;
+        case Op::Acos:  name = "acos"; break;
+        case Op::Atan:  name = "atan"; break;
+        case Op::Sinh:  name = "sinh"; break;
+        case Op::Cosh:  name = "cosh"; break;
+        case Op::Tanh:  name = "tanh"; break;
+        case Op::Asinh: name = "asinh"; break;
+        case Op::Acosh: name = "acosh"; break;
+        case Op::Atanh: name = "atanh"; break;
+        case Op::Log2:  name = "log2"; break;
+        case Op::Log10: name = "log10"; break;
+        case Op::Exp:   name = "exp"; break;
+        case Op::Sqrt:  name = "sqrt"; break;
+        default:        return false;
+        }
+        rhs = std::string("std::") + name + "(" + a + ")";
+        return true;
+    }
+};
+
+} // namespace SC
+
+#endif // SOLVERCORE_NATIVEFUNCTION_HPP_
@@ -0,0 +1,414 @@
+#ifndef SOLVERCORE_OBJECTIVE_HPP_
+#define SOLVERCORE_OBJECTIVE_HPP_
+
+#include <muParser.h>
+#include <SolverCore/AutoDiff.hpp>
+#include <SolverCore/CompiledExpressionCache.hpp>
+#include <SolverCore/Evaluator.hpp>
+#include <SolverCore/Instrument.hpp>
+#include <SolverCore/LineSearch.hpp>
+#include <SolverCore/ValueMemo.hpp>
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace SC {
+
+/**
+ * Целевая функция метода: всё, что нужно для её вычисления в точках одного
+ * решения. Владеет парсерами muParser (обычным и пакетным), разобранной
+ * функцией из общего кеша, AutoDiff, Evaluator и ValueMemo и считает вызовы
+ * функции. Методы (GD, CD, CG) вызывают только её.
+ *
+ * Порядок работы: validate() при проверке входных данных, load() в начале
+ * каждого solve(), затем value()/valueBatch()/dx()/dy()/withGradient().
+ * Заголовок подключают только методы, поэтому muParser здесь — их зависимость.
+ */
+template <bool Instrumented>
+class Objective {
+public:
+
+    Objective()
+        : m_parser{}
+        , m_bulkParser{}
+        , m_bulkX{}
+        , m_bulkY{}
+        , m_compiled{}
+        , m_autoDiff{}
+        , m_evaluator{}
+        , m_memo{}
+        , m_instrument{ nullptr }
+        , m_x{ 0.0 }
+        , m_y{ 0.0 }
+        , m_calls{ 0 }
+        , m_precision{ 0.0 }
+    {
+    }
+
+    // Проверка синтаксиса: функцию, которую уже проверил любой метод,
+    // повторно не проверяем. После неё доступны compiled() и parserValue()
+    bool validate(const std::string &function)
+    {
+        m_compiled = CompiledExpressionCache::shared().get(function);
+        if (m_compiled->syntaxChecked()) {
+            if (!m_compiled->syntaxValid()) {
+                return false;
+            }
+            prepareParser(m_compiled->text());
+            return true;
+        }
+        try {
+            prepareParser(m_compiled->text());
+            m_x = 0.0;
+            m_y = 0.0;
+
+            // Пробуем вычислить в тестовой точке
+            m_parser.Eval();
+
+            m_compiled->setSyntaxValid(true);
+            return true;
+        }
+        catch (const mu::Parser::exception_type &) {
+            m_compiled->setSyntaxValid(false);
+            return false;
+        }
+        catch (...) {
+            return false;
+        }
+    }
+
+    const CompiledExpression &compiled() const { return *m_compiled; }
+
+    /**
+     * Подготовка к решению: разбор (один раз на функцию), AD, способ
+     * вычисления и пакетный парсер (batched). digits — точность вычислений:
+     * шаг численных производных 10^-digits.
+     * Счётчик вызовов и m_memo сбрасываются. Возвращает фактический способ
+     * вычисления: при недоступности запрошенного — откат (см. Evaluator).
+     */
+    Backend load(const std::string &function, Backend requested, bool batched, int digits,
+                 Instrument<Instrumented> *methodInstrument)
+    {
+        // Привязка к замерам метода — при каждом решении (после копирования метода — к своим)
+        m_instrument = methodInstrument;
+        const auto phase = instrument().scope(Phase::Setup);
+        m_compiled = CompiledExpressionCache::shared().get(function); // Разбор — один раз на функцию
+        prepareParser(m_compiled->text());
+        m_autoDiff.init(*m_compiled); // Если AD не поддерживает выражение — остаётся Diff
+        m_evaluator.init(*m_compiled, requested);
+        if (batched) {
+            prepareBulkParser(m_compiled->text());
+        }
+        m_precision = std::pow(10, -digits);
+        reset();
+        return m_evaluator.active();
+    }
+
+    // Почему запрошенный способ вычисления недоступен
+    const std::string &errorMessage() const { return m_evaluator.errorMessage(); }
+
+    void reset()
+    {
+        m_calls = 0;
+        m_memo.clear();
+    }
+
+    // Вызовы функции с начала решения (значения из m_memo не считаются)
+    int calls() const { return m_calls; }
+
+    // Значение в точке (x, y); повторные точки решения берутся из m_memo
+    double value(double x, double y)
+    {
+        m_x = x;
+        m_y = y;
+        double result = 0.0;
+        if (m_memoEnabled && m_memo.find(x, y, result)) {
+            instrument().memoHit();
+            return result;
+        }
+        const auto phase = instrument().scope(Phase::Function);
+        m_calls++;
+        if (m_evaluator.enabled()) {
+            result = m_evaluator(x, y);
+        }
+        else {
+            try {
+                result = m_parser.Eval();
+            }
+            catch (...) {
+                throw std::runtime_error("Ошибка вычисления функции в точке");
+            }
+        }
+        if (m_memoEnabled) {
+            m_memo.insert(x, y, result);
+        }
+        return result;
+    }
+
+    // Пакетное вычисление в n точках (n <= kBatchSize). Точки, уже вычисленные
+    // в этом решении, берутся из m_memo; остальные вычисляются одним вызовом,
+    // и каждая из них — один вызов функции
+    void valueBatch(const double *xs, const double *ys, double *values, int n)
+    {
+        double miss_x[kBatchSize], miss_y[kBatchSize], miss_values[kBatchSize];
+        int miss_index[kBatchSize];
+        int misses = 0;
+        for (int i = 0; i < n; ++i) {
+            if (m_memoEnabled && m_memo.find(xs[i], ys[i], values[i])) {
+                instrument().memoHit();
+                continue;
+            }
+            miss_x[misses] = xs[i];
+            miss_y[misses] = ys[i];
+            miss_index[misses++] = i;
+        }
+        if (misses == 0) {
+            return;
+        }
+
+        const auto phase = instrument().scope(Phase::Function, misses);
+        m_calls += misses;
+        if (m_evaluator.enabled()) {
+            m_evaluator.evaluate(miss_x, miss_y, miss_values, misses);
+        }
+        else {
+            try {
+                std::copy(miss_x, miss_x + misses, m_bulkX.begin());
+                std::copy(miss_y, miss_y + misses, m_bulkY.begin());
+                m_bulkParser.Eval(miss_values, misses);
+            }
+            catch (...) {
+                throw std::runtime_error("Ошибка вычисления функции в точке");
+            }
+        }
+        for (int k = 0; k < misses; ++k) {
+            values[miss_index[k]] = miss_values[k];
+            if (m_memoEnabled) {
+                m_memo.insert(miss_x[k], miss_y[k], miss_values[k]);
+            }
+        }
+    }
+
+    // Частные производные: градиент, уже вычисленный в точке (m_memo), иначе
+    // AD, если выражение поддерживается, иначе Diff muParser
+    double dx(double x, double y)
+    {
+        Dual memo{ 0.0, 0.0, 0.0 };
+        if (findGradient(x, y, memo)) {
+            return memo.dx;
+        }
+        const auto phase = instrument().scope(Phase::Derivative);
+        if (m_autoDiff.enabled()) {
+            return m_autoDiff.dx(x, y);
+        }
+        return parserDx(x, y, m_precision);
+    }
+
+    double dy(double x, double y)
+    {
+        Dual memo{ 0.0, 0.0, 0.0 };
+        if (findGradient(x, y, memo)) {
+            return memo.dy;
+        }
+        const auto phase = instrument().scope(Phase::Derivative);
+        if (m_autoDiff.enabled()) {
+            return m_autoDiff.dy(x, y);
+        }
+        return parserDy(x, y, m_precision);
+    }
+
+    // Значение и градиент в одной точке. С AD — один проход по выражению,
+    // в котором общие подвыражения (exp(x*y) в f и в обеих производных)
+    // объединены при разборе; иначе — muParser и численные производные.
+    // Градиент запоминается в m_memo вместе со значением: повторная точка
+    // (принятая точка поиска шага, проверка осцилляций) не пересчитывается
+    Dual withGradient(double x, double y)
+    {
+        Dual result{ 0.0, 0.0, 0.0 };
+        if (findGradient(x, y, result)) {
+            return result;
+        }
+        if (!m_autoDiff.enabled()) {
+            const double v = value(x, y);
+            result = { v, dx(x, y), dy(x, y) };
+        }
+        else {
+            const auto phase = instrument().scope(Phase::Derivative);
+            m_x = x;
+            m_y = y;
+            result = m_autoDiff.at(x, y);
+            double v = 0.0;
+            if (m_memoEnabled && m_memo.find(x, y, v)) {
+                instrument().memoHit();
+                result.v = v; // То же значение, что видел поиск шага
+            }
+            else {
+                m_calls++;
+            }
+        }
+        if (m_memoEnabled) {
+            m_memo.insertGradient(x, y, result.v, result.dx, result.dy);
+        }
+        return result;
+    }
+
+    // false — каждая точка вычисляется заново (проверка, что m_memo не меняет результат)
+    void setMemo(bool enabled)
+    {
+        m_memoEnabled = enabled;
+        m_memo.clear();
+    }
+
+    // Только muParser, без m_memo и счётчика: проверки функции до решения
+    double parserValue(double x, double y)
+    {
+        m_x = x;
+        m_y = y;
+        return m_parser.Eval();
+    }
+
+    double parserDx(double x, double y, double h)
+    {
+        double x_old = m_x, y_old = m_y;
+        m_y = y; // Фиксируем y
+        double derivative = m_parser.Diff(&m_x, x, h);
+        m_x = x_old;
+        m_y = y_old;
+        return derivative;
+    }
+
+    double parserDy(double x, double y, double h)
+    {
+        double x_old = m_x, y_old = m_y;
+        m_x = x; // Фиксируем x
+        double derivative = m_parser.Diff(&m_y, y, h);
+        m_x = x_old;
+        m_y = y_old;
+        return derivative;
+    }
+
+private:
+
+    mu::Parser m_parser; // Вычисление через переменные m_x/m_y
+    mu::Parser m_bulkParser; // Пакетный режим muParser: x и y привязаны к массивам
+    std::vector<double> m_bulkX, m_bulkY;
+    std::shared_ptr<const CompiledExpression> m_compiled; // Разобранная функция из общего кеша
+    AutoDiff m_autoDiff; // Точные производные (прямой режим AD)
+    Evaluator m_evaluator; // Альтернативное вычисление функции (лента / машинный код)
+    ValueMemo m_memo; // Значения функции (и градиенты) в точках текущего решения
+    bool m_memoEnabled = true;
+    Instrument<Instrumented> *m_instrument; // Замеры метода, задаются в load()
+    std::string m_parserFunction; // Функция, загруженная в m_parser
+    std::string m_bulkFunction; // Функция, загруженная в m_bulkParser
+    const double *m_parserBound = nullptr; // К какому m_x привязан m_parser (после копирования — к чужому)
+    const double *m_bulkBound = nullptr; // То же для m_bulkParser и m_bulkX
+    double m_x, m_y; // Переменные m_parser
+    int m_calls; // Счётчик вызовов функции
+    double m_precision; // Шаг численных производных, 10^-digits
+
+    bool findGradient(double x, double y, Dual &out)
+    {
+        if (!m_memoEnabled || !m_memo.findGradient(x, y, out.v, out.dx, out.dy)) {
+            return false;
+        }
+        instrument().memoHit();
+        return true;
+    }
+
+    // До первого load() замеры не нужны: пустые, свои у каждого потока
+    Instrument<Instrumented> &instrument()
+    {
+        static thread_local Instrument<Instrumented> unbound;
+        return m_instrument ? *m_instrument : unbound;
+    }
+
+    // Загрузка функции в m_parser. Переменные привязываются один раз, SetExpr —
+    // только при смене функции: оба вызова сбрасывают байткод muParser, и
+    // следующий Eval() снова разбирал бы строку
+    void prepareParser(const std::string &function)
+    {
+        if (m_parserBound != &m_x) {
+            m_parser.DefineVar("x", &m_x);
+            m_parser.DefineVar("y", &m_y);
+            m_parserBound = &m_x;
+        }
+        if (m_parserFunction != function) {
+            m_parserFunction.clear(); // Если SetExpr бросит исключение, парсер не считается загруженным
+            m_parser.SetExpr(function);
+            m_parserFunction = function;
+        }
+    }
+
+    // То же для пакетного парсера: массивы выделяются при первом пакетном поиске
+    void prepareBulkParser(const std::string &function)
+    {
+        if (m_bulkX.empty()) {
+            m_bulkX.assign(kBatchSize, 0.0);
+            m_bulkY.assign(kBatchSize, 0.0);
+        }
+        if (m_bulkBound != m_bulkX.data()) {
+            m_bulkParser.DefineVar("x", m_bulkX.data());
+            m_bulkParser.DefineVar("y", m_bulkY.data());
+            m_bulkBound = m_bulkX.data();
+        }
+        if (m_bulkFunction != function) {
+            m_bulkFunction.clear();
+            m_bulkParser.SetExpr(function);
+            m_bulkFunction = function;
+        }
+    }
+};
+
+/**
+ * Objective в виде функции точки для SC::Descent: точка — массив (x, y).
+ * Вычисления, память значений и счётчик вызовов остаются у Objective.
+ */
+template <bool Instrumented>
+class PlaneFunction {
+public:
+
+    explicit PlaneFunction(Objective<Instrumented> &objective)
+        : m_objective{ objective }
+    {
+    }
+
+    size_t size() const { return 2; }
+    int calls() const { return m_objective.calls(); }
+
+    double value(const double *point) { return m_objective.value(point[0], point[1]); }
+
+    double gradient(const double *point, double *gradient)
+    {
+        const Dual result = m_objective.withGradient(point[0], point[1]);
+        gradient[0] = result.dx;
+        gradient[1] = result.dy;
+        return result.v;
+    }
+
+    double derivative(const double *point, size_t index)
+    {
+        return (index == 0) ? m_objective.dx(point[0], point[1]) : m_objective.dy(point[0], point[1]);
+    }
+
+    // points — n точек подряд (n <= kBatchSize)
+    void valueBatch(const double *points, double *values, int n)
+    {
+        double xs[kBatchSize], ys[kBatchSize];
+        for (int i = 0; i < n; ++i) {
+            xs[i] = points[2 * i];
+            ys[i] = points[2 * i + 1];
+        }
+        m_objective.valueBatch(xs, ys, values, n);
+    }
+
+private:
+
+    Objective<Instrumented> &m_objective;
+};
+
+} // namespace SC
+
+#endif // SOLVERCORE_OBJECTIVE_HPP_
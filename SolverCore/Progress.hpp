@@ -0,0 +1,63 @@
+#ifndef SOLVERCORE_PROGRESS_HPP_
+#define SOLVERCORE_PROGRESS_HPP_
+
+#include <atomic>
+
+namespace SC {
+
+/**
+ * Ход решения и флаг отмены, общие для потока метода и потока интерфейса.
+ *
+ * Метод вызывает update() раз в итерацию: это несколько атомарных записей
+ * без блокировок. Интерфейс сам решает, как часто читать snapshot(),
+ * поэтому частота итераций на него не влияет. Отмена кооперативная:
+ * метод видит флаг в update() и завершает цикл итераций.
+ */
+class Progress {
+public:
+
+    struct Snapshot {
+        int iteration;
+        double bestValue;
+        int functionCalls;
+    };
+
+    // Возвращает true, если запрошена отмена
+    bool update(int iteration, double bestValue, int functionCalls)
+    {
+        m_iteration.store(iteration, std::memory_order_relaxed);
+        m_bestValue.store(bestValue, std::memory_order_relaxed);
+        m_functionCalls.store(functionCalls, std::memory_order_relaxed);
+        return m_cancel.load(std::memory_order_relaxed);
+    }
+
+    Snapshot snapshot() const
+    {
+        return { m_iteration.load(std::memory_order_relaxed),
+                 m_bestValue.load(std::memory_order_relaxed),
+                 m_functionCalls.load(std::memory_order_relaxed) };
+    }
+
+    void cancel() { m_cancel.store(true, std::memory_order_relaxed); }
+    bool cancelled() const { return m_cancel.load(std::memory_order_relaxed); }
+
+    // Вызывать до запуска метода
+    void reset()
+    {
+        m_iteration.store(0, std::memory_order_relaxed);
+        m_bestValue.store(0.0, std::memory_order_relaxed);
+        m_functionCalls.store(0, std::memory_order_relaxed);
+        m_cancel.store(false, std::memory_order_relaxed);
+    }
+
+private:
+
+    std::atomic<int> m_iteration{ 0 };
+    std::atomic<double> m_bestValue{ 0.0 };
+    std::atomic<int> m_functionCalls{ 0 };
+    std::atomic<bool> m_cancel{ false };
+};
+
+} // namespace SC
+
+#endif // SOLVERCORE_PROGRESS_HPP_
@@ -0,0 +1,74 @@
+#ifndef SOLVERCORE_REPORTER_HPP_
+#define SOLVERCORE_REPORTER_HPP_
+
+#include <type_traits>
+
+namespace SC {
+
+/**
+ * Требования методов к системе отчётности (параметр шаблона Reporter).
+ *
+ * Всегда:
+ *   int begin(); int end();
+ * Если нужен найденный экстремум (reporterWantsResult<Reporter>):
+ *   void insertResult(double x, double y, double funcValue); // один раз за solve(), до end()
+ * Только если отчётность включена (reporterEnabled<Reporter>):
+ *   void insertValue(const std::string &name, double value);
+ *   void insertMessage(const std::string &text);
+ *   int beginTable(const std::string &title, const std::vector<std::string> &columns);
+ *   int insertRow(int tableId, const std::vector<Cell> &row);
+ *   void endTable(int tableId);
+ *   void insertStats(const SC::SolveStats &stats); // замеры фаз, см. Instrument.hpp
+ *
+ * Включённость задаёт константа Reporter::enabled; без неё отчётность
+ * включена (как у ReportWriter). Методы проверяют её через if constexpr,
+ * поэтому с выключенной отчётностью строки таблиц, тексты сообщений
+ * и std::to_string не вычисляются вовсе — код вырезается при компиляции.
+ *
+ * Результат нужен и системам с выключенной отчётностью (SC::ResultRecorder),
+ * поэтому он задаётся отдельно константой Reporter::wantsResult (без неё —
+ * нужен).
+ */
+template <typename Reporter, typename = void>
+struct ReporterTraits {
+    static constexpr bool enabled = true;
+};
+
+template <typename Reporter>
+struct ReporterTraits<Reporter, std::void_t<decltype(Reporter::enabled)>> {
+    static constexpr bool enabled = Reporter::enabled;
+};
+
+template <typename Reporter>
+inline constexpr bool reporterEnabled = ReporterTraits<Reporter>::enabled;
+
+template <typename Reporter, typename = void>
+struct ReporterResultTraits {
+    static constexpr bool wantsResult = true;
+};
+
+template <typename Reporter>
+struct ReporterResultTraits<Reporter, std::void_t<decltype(Reporter::wantsResult)>> {
+    static constexpr bool wantsResult = Reporter::wantsResult;
+};
+
+template <typename Reporter>
+inline constexpr bool reporterWantsResult = ReporterResultTraits<Reporter>::wantsResult;
+
+/**
+ * Отчётность, которая ничего не записывает: для замеров и запусков,
+ * где нужен только результат метода.
+ */
+class NullReporter {
+public:
+
+    static constexpr bool enabled = false;
+    static constexpr bool wantsResult = false;
+
+    int begin() { return 0; }
+    int end() { return 0; }
+};
+
+} // namespace SC
+
+#endif // SOLVERCORE_REPORTER_HPP_
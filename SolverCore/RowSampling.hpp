@@ -0,0 +1,165 @@
+#ifndef SOLVERCORE_ROWSAMPLING_HPP_
+#define SOLVERCORE_ROWSAMPLING_HPP_
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+namespace SC {
+
+// Какие строки таблицы итераций попадают в отчёт
+enum class RowPolicy {
+    All = 0,        // Все строки
+    EveryNth = 1,   // Каждая N-я строка
+    LogSpaced = 2,  // Логарифмическая шкала: N строк на каждую декаду номеров
+    Improving = 3,  // Только строки, где f лучше всех предыдущих
+    FirstLast = 4   // Первые и последние N строк
+};
+
+inline const char *rowPolicyToString(RowPolicy policy)
+{
+    switch (policy) {
+    case RowPolicy::All:       return "all";
+    case RowPolicy::EveryNth:  return "everyNth";
+    case RowPolicy::LogSpaced: return "logSpaced";
+    case RowPolicy::Improving: return "improving";
+    case RowPolicy::FirstLast: return "firstLast";
+    }
+    return "all";
+}
+
+struct RowSampling {
+    RowPolicy policy = RowPolicy::All;
+    long long parameter = 10; // N для EveryNth, LogSpaced и FirstLast
+    bool minimize = true;     // Направление улучшения для Improving
+
+    bool sampled() const { return policy != RowPolicy::All; }
+};
+
+/**
+ * Прореживание строк одной таблицы. Решение принимается по номеру строки
+ * и значению функции в ней, поэтому политика применяется в одном месте —
+ * в системе отчётности, — а не в цикле каждого метода.
+ *
+ * Первая и последняя строки записываются всегда: последняя строка держится
+ * до finish(), пока не станет ясно, что она последняя. Для FirstLast так же
+ * держатся последние N строк.
+ *
+ *   add(row, f, emit)  — очередная строка; emit(row) вызывается для строк,
+ *                        которые нужно записать (возможно, более ранних)
+ *   finish(emit)       — конец таблицы, записывает отложенные строки
+ */
+template <typename Row>
+class RowSampler {
+public:
+
+    explicit RowSampler(const RowSampling &sampling = {})
+        : m_sampling(sampling)
+    {
+        if (m_sampling.parameter < 1) {
+            m_sampling.parameter = 1;
+        }
+        if (m_sampling.policy == RowPolicy::LogSpaced) {
+            m_ratio = std::pow(10.0, 1.0 / static_cast<double>(m_sampling.parameter));
+        }
+    }
+
+    template <typename Emit>
+    void add(const Row &row, double value, Emit &&emit)
+    {
+        const long long index = m_total++;
+        if (m_sampling.policy == RowPolicy::FirstLast) {
+            addFirstLast(index, row, emit);
+            return;
+        }
+        if (accept(index, value)) {
+            emit(row);
+            m_hasPending = false;
+        } else {
+            m_pending = row; // Ёмкость строки переиспользуется
+            m_hasPending = true;
+        }
+    }
+
+    template <typename Emit>
+    void finish(Emit &&emit)
+    {
+        if (m_sampling.policy == RowPolicy::FirstLast) {
+            // Кольцо последних строк — в порядке поступления
+            const size_t count = m_tail.size();
+            for (size_t i = 0; i < count; ++i) {
+                emit(m_tail[(m_tailStart + i) % count]);
+            }
+            m_tail.clear();
+        } else if (m_hasPending) {
+            emit(m_pending);
+        }
+        m_hasPending = false;
+    }
+
+    long long total() const { return m_total; }
+    const RowSampling &sampling() const { return m_sampling; }
+
+private:
+
+    bool accept(long long index, double value)
+    {
+        switch (m_sampling.policy) {
+        case RowPolicy::All:
+            return true;
+        case RowPolicy::EveryNth:
+            return index % m_sampling.parameter == 0;
+        case RowPolicy::LogSpaced:
+            if (index < m_next) {
+                return false;
+            }
+            // Следующий номер — не меньше чем в ratio раз больше текущего
+            m_next = std::max(index + 1, static_cast<long long>(std::ceil(static_cast<double>(index) * m_ratio)));
+            return true;
+        case RowPolicy::Improving: {
+            const bool better = !std::isnan(value)
+                && (!m_hasBest || (m_sampling.minimize ? value < m_best : value > m_best));
+            if (better) {
+                m_best = value;
+                m_hasBest = true;
+            }
+            return better || index == 0;
+        }
+        case RowPolicy::FirstLast:
+            break;
+        }
+        return true;
+    }
+
+    template <typename Emit>
+    void addFirstLast(long long index, const Row &row, Emit &emit)
+    {
+        const size_t keep = static_cast<size_t>(m_sampling.parameter);
+        if (index < m_sampling.parameter) {
+            emit(row);
+            return;
+        }
+        if (m_tail.size() < keep) {
+            m_tail.push_back(row);
+            return;
+        }
+        m_tail[m_tailStart] = row;
+        m_tailStart = (m_tailStart + 1) % keep;
+    }
+
+    RowSampling m_sampling;
+    long long m_total = 0;
+    double m_ratio = 1.0;
+    long long m_next = 0;       // LogSpaced: номер следующей записываемой строки
+    double m_best = 0.0;        // Improving: лучшее записанное значение
+    bool m_hasBest = false;
+    Row m_pending{};            // Последняя отброшенная строка
+    bool m_hasPending = false;
+    std::vector<Row> m_tail;    // FirstLast: кольцо последних строк
+    size_t m_tailStart = 0;
+};
+
+} // namespace SC
+
+#endif // SOLVERCORE_ROWSAMPLING_HPP_
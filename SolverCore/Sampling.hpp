@@ -0,0 +1,102 @@
+#ifndef SOLVERCORE_SAMPLING_HPP_
+#define SOLVERCORE_SAMPLING_HPP_
+
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <random>
+#include <vector>
+
+namespace SC {
+
+// Точка на плоскости (x, y)
+struct Point {
+    double x;
+    double y;
+};
+
+// Прямоугольная область поиска [xLeft, xRight] x [yLeft, yRight]
+struct Box {
+    double xLeft;
+    double xRight;
+    double yLeft;
+    double yRight;
+};
+
+/**
+ * Латинский гиперкуб: каждая ось делится на n равных полос, и в каждой
+ * полосе каждой оси оказывается ровно одна точка. Положение внутри полосы
+ * и сопоставление полос x и y случайны, seed делает выборку воспроизводимой.
+ */
+inline std::vector<Point> latinHypercube(size_t n, const Box &box, uint64_t seed)
+{
+    std::vector<Point> points(n);
+    if (n == 0) {
+        return points;
+    }
+    std::mt19937_64 rng(seed);
+    std::uniform_real_distribution<double> offset(0.0, 1.0);
+
+    std::vector<size_t> strataX(n), strataY(n);
+    std::iota(strataX.begin(), strataX.end(), size_t{ 0 });
+    std::iota(strataY.begin(), strataY.end(), size_t{ 0 });
+    std::shuffle(strataX.begin(), strataX.end(), rng);
+    std::shuffle(strataY.begin(), strataY.end(), rng);
+
+    const double cell = 1.0 / static_cast<double>(n);
+    for (size_t i = 0; i < n; ++i) {
+        const double u = (strataX[i] + offset(rng)) * cell;
+        const double v = (strataY[i] + offset(rng)) * cell;
+        points[i].x = box.xLeft + u * (box.xRight - box.xLeft);
+        points[i].y = box.yLeft + v * (box.yRight - box.yLeft);
+    }
+    return points;
+}
+
+/**
+ * Первые n точек двумерной последовательности Соболя (без точки (0, 0)).
+ * Первая координата — последовательность ван дер Корпута по основанию 2,
+ * вторая — направляющие числа для многочлена x + 1. Точки строятся
+ * в порядке кода Грея: каждая следующая отличается от предыдущей одним XOR.
+ */
+inline std::vector<Point> sobol(size_t n, const Box &box)
+{
+    constexpr int kBits = 32;
+    uint32_t directionX[kBits], directionY[kBits];
+    for (int i = 0; i < kBits; ++i) {
+        directionX[i] = uint32_t{ 1 } << (kBits - 1 - i);
+        directionY[i] = (i == 0) ? (uint32_t{ 1 } << (kBits - 1))
+                                 : (directionY[i - 1] ^ (directionY[i - 1] >> 1));
+    }
+
+    std::vector<Point> points(n);
+    uint32_t ix = 0, iy = 0;
+    const double scale = 1.0 / 4294967296.0; // 2^-32
+    for (size_t k = 0; k < n; ++k) {
+        // Номер младшего нулевого бита k
+        int c = 0;
+        for (size_t value = k; value & 1; value >>= 1) {
+            ++c;
+        }
+        ix ^= directionX[c];
+        iy ^= directionY[c];
+        points[k].x = box.xLeft + ix * scale * (box.xRight - box.xLeft);
+        points[k].y = box.yLeft + iy * scale * (box.yRight - box.yLeft);
+    }
+    return points;
+}
+
+// Способ расстановки начальных точек мультистарта по области поиска
+enum class StartSampling {
+    LatinHypercube,
+    Sobol
+};
+
+inline std::vector<Point> samplePoints(StartSampling sampling, size_t n, const Box &box, uint64_t seed = 0)
+{
+    return (sampling == StartSampling::Sobol) ? sobol(n, box) : latinHypercube(n, box, seed);
+}
+
+} // namespace SC
+
+#endif // SOLVERCORE_SAMPLING_HPP_
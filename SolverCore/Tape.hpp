@@ -0,0 +1,195 @@
+#ifndef SOLVERCORE_TAPE_HPP_
+#define SOLVERCORE_TAPE_HPP_
+
+#include <SolverCore/Expression.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace SC {
+
+/**
+ * Разобранное выражение, опущенное в плоскую регистровую ленту инструкций.
+ *
+ * Регистры 0 и 1 — это x и y, за ними идут константы (загружаются один раз
+ * при компиляции), затем временные значения. Временные регистры
+ * переиспользуются после последнего чтения, поэтому рабочий набор даже у
+ * длинных выражений остаётся маленьким. Вычисление — один цикл по ленте
+ * без обращения к внешним переменным.
+ */
+class Tape {
+public:
+
+    struct Instruction {
+        Op op;
+        std::uint16_t dst;
+        std::uint16_t a;
+        std::uint16_t b;
+    };
+
+    bool compile(const Expression &expression)
+    {
+        m_code.clear();
+        m_constants.clear();
+        m_registers.assign(2, 0.0);
+        m_lanes.clear();
+        m_result = 0;
+        m_valid = false;
+
+        const std::vector<Node> &nodes = expression.nodes();
+        if (nodes.empty()) {
+            return false;
+        }
+
+        // Последнее использование каждого узла — после него регистр свободен
+        std::vector<int> lastUse(nodes.size(), -1);
+        for (size_t i = 0; i < nodes.size(); ++i) {
+            if (nodes[i].a >= 0) lastUse[nodes[i].a] = static_cast<int>(i);
+            if (nodes[i].b >= 0) lastUse[nodes[i].b] = static_cast<int>(i);
+        }
+
+        std::vector<std::uint16_t> reg(nodes.size(), 0);
+        std::vector<bool> temporary(nodes.size(), false);
+        std::vector<std::uint16_t> freeRegs;
+
+        auto release = [&](int node, int at) {
+            if (node >= 0 && temporary[node] && lastUse[node] == at) {
+                temporary[node] = false; // Не освобождать дважды (x*x)
+                freeRegs.push_back(reg[node]);
+            }
+        };
+
+        for (size_t i = 0; i < nodes.size(); ++i) {
+            const Node &node = nodes[i];
+            if (node.op == Op::VarX) { reg[i] = 0; continue; }
+            if (node.op == Op::VarY) { reg[i] = 1; continue; }
+            if (node.op == Op::Var) { return false; } // Функции многих переменных — только Expression
+            if (node.op == Op::Const) {
+                if (m_registers.size() >= UINT16_MAX) return false;
+                reg[i] = constantRegister(node.value);
+                continue;
+            }
+
+            release(node.a, static_cast<int>(i));
+            release(node.b, static_cast<int>(i));
+
+            std::uint16_t dst;
+            if (!freeRegs.empty()) {
+                dst = freeRegs.back();
+                freeRegs.pop_back();
+            } else {
+                if (m_registers.size() >= UINT16_MAX) {
+                    return false;
+                }
+                dst = static_cast<std::uint16_t>(m_registers.size());
+                m_registers.push_back(0.0);
+            }
+            reg[i] = dst;
+            temporary[i] = true;
+
+            // x^2 -> x*x: результат тот же (оба округляются корректно), но без вызова pow
+            if (node.op == Op::Pow && nodes[node.b].op == Op::Const && nodes[node.b].value == 2.0) {
+                m_code.push_back({ Op::Mul, dst, reg[node.a], reg[node.a] });
+                continue;
+            }
+            m_code.push_back({ node.op, dst,
+                               node.a >= 0 ? reg[node.a] : std::uint16_t(0),
+                               node.b >= 0 ? reg[node.b] : std::uint16_t(0) });
+        }
+        m_result = reg[nodes.size() - 1];
+        m_valid = true;
+        return true;
+    }
+
+    bool isValid() const { return m_valid; }
+    size_t instructionCount() const { return m_code.size(); }
+    size_t registerCount() const { return m_registers.size(); }
+
+    double operator()(double x, double y) const
+    {
+        double *r = m_registers.data();
+        r[0] = x;
+        r[1] = y;
+        for (const Instruction &in : m_code) {
+            switch (in.op) {
+            case Op::Neg:   r[in.dst] = -r[in.a]; break;
+            case Op::Add:   r[in.dst] = r[in.a] + r[in.b]; break;
+            case Op::Sub:   r[in.dst] = r[in.a] - r[in.b]; break;
+            case Op::Mul:   r[in.dst] = r[in.a] * r[in.b]; break;
+            case Op::Div:   r[in.dst] = r[in.a] / r[in.b]; break;
+            case Op::Pow:   r[in.dst] = std::pow(r[in.a], r[in.b]); break;
+            case Op::Min:   r[in.dst] = (r[in.b] < r[in.a]) ? r[in.b] : r[in.a]; break;
+            case Op::Max:   r[in.dst] = (r[in.a] < r[in.b]) ? r[in.b] : r[in.a]; break;
+            case Op::Atan2: r[in.dst] = std::atan2(r[in.a], r[in.b]); break;
+            default:        r[in.dst] = applyUnary(in.op, r[in.a]); break;
+            }
+        }
+        return r[m_result];
+    }
+
+    // Вычисление в n точках: каждая инструкция выполняется сразу для kLanes точек,
+    // так что разбор ленты делится на весь пакет, а внутренние циклы векторизуются
+    void operator()(const double *xs, const double *ys, double *out, size_t n) const
+    {
+        if (m_lanes.size() != m_registers.size() * kLanes) {
+            m_lanes.resize(m_registers.size() * kLanes);
+            for (std::uint16_t c : m_constants) {
+                std::fill_n(&m_lanes[c * kLanes], kLanes, m_registers[c]);
+            }
+        }
+        double *r = m_lanes.data();
+        for (size_t offset = 0; offset < n; offset += kLanes) {
+            const size_t m = std::min(kLanes, n - offset);
+            std::copy_n(xs + offset, m, r);
+            std::copy_n(ys + offset, m, r + kLanes);
+            for (const Instruction &in : m_code) {
+                double *d = r + in.dst * kLanes;
+                const double *a = r + in.a * kLanes;
+                const double *b = r + in.b * kLanes;
+                switch (in.op) {
+                case Op::Neg: for (size_t k = 0; k < kLanes; ++k) d[k] = -a[k]; break;
+                case Op::Add: for (size_t k = 0; k < kLanes; ++k) d[k] = a[k] + b[k]; break;
+                case Op::Sub: for (size_t k = 0; k < kLanes; ++k) d[k] = a[k] - b[k]; break;
+                case Op::Mul: for (size_t k = 0; k < kLanes; ++k) d[k] = a[k] * b[k]; break;
+                case Op::Div: for (size_t k = 0; k < kLanes; ++k) d[k] = a[k] / b[k]; break;
+                case Op::Pow: for (size_t k = 0; k < kLanes; ++k) d[k] = std::pow(a[k], b[k]); break;
+                case Op::Min: for (size_t k = 0; k < kLanes; ++k) d[k] = (b[k] < a[k]) ? b[k] : a[k]; break;
+                case Op::Max: for (size_t k = 0; k < kLanes; ++k) d[k] = (a[k] < b[k]) ? b[k] : a[k]; break;
+                case Op::Atan2: for (size_t k = 0; k < kLanes; ++k) d[k] = std::atan2(a[k], b[k]); break;
+                default:      for (size_t k = 0; k < kLanes; ++k) d[k] = applyUnary(in.op, a[k]); break;
+                }
+            }
+            std::copy_n(r + m_result * kLanes, m, out + offset);
+        }
+    }
+
+private:
+
+    static constexpr size_t kLanes = 16; // Точек на один проход по ленте
+
+    std::vector<Instruction> m_code;
+    mutable std::vector<double> m_registers; // x, y, константы, временные значения
+    mutable std::vector<double> m_lanes;     // Те же регистры по kLanes значений для пакета
+    std::vector<std::uint16_t> m_constants; // Регистры, занятые константами
+    std::uint16_t m_result = 0;
+    bool m_valid = false;
+
+    // Одинаковые константы делят один регистр
+    std::uint16_t constantRegister(double value)
+    {
+        for (std::uint16_t i : m_constants) {
+            if (std::memcmp(&m_registers[i], &value, sizeof(double)) == 0) {
+                return i;
+            }
+        }
+        m_registers.push_back(value);
+        m_constants.push_back(static_cast<std::uint16_t>(m_registers.size() - 1));
+        return m_constants.back();
+    }
+};
+
+} // namespace SC
+
+#endif // SOLVERCORE_TAPE_HPP_
@@ -0,0 +1,186 @@
+#ifndef SOLVERCORE_THREADPOOL_HPP_
+#define SOLVERCORE_THREADPOOL_HPP_
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace SC {
+
+/**
+ * Пул потоков с перехватом задач (work stealing).
+ *
+ * У каждого потока своя очередь: свои задачи он берёт с конца (LIFO),
+ * а освободившись — забирает задачи из начала чужих очередей. Задачи
+ * получают номер потока, что позволяет держать по одному тяжёлому объекту
+ * (например, экземпляру метода со своим парсером) на поток.
+ */
+class ThreadPool {
+public:
+
+    using Task = std::function<void(unsigned worker)>;
+
+    explicit ThreadPool(unsigned threads = 0)
+    {
+        if (threads == 0) {
+            threads = std::max(1u, std::thread::hardware_concurrency());
+        }
+        for (unsigned i = 0; i < threads; ++i) {
+            m_queues.emplace_back(std::make_unique<Queue>());
+        }
+        for (unsigned i = 0; i < threads; ++i) {
+            m_workers.emplace_back([this, i] { workerLoop(i); });
+        }
+    }
+
+    ~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_sleepMutex);
+            m_stop = true;
+        }
+        m_wake.notify_all();
+        for (auto &worker : m_workers) {
+            worker.join();
+        }
+    }
+
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    unsigned size() const { return static_cast<unsigned>(m_workers.size()); }
+
+    // Ставит задачу в очередь потока worker (по модулю числа потоков)
+    void submit(unsigned worker, Task task)
+    {
+        Queue &queue = *m_queues[worker % m_queues.size()];
+        // Счётчик растёт раньше, чем задача видна в очереди, чтобы
+        // забравший её поток не увёл m_pending ниже нуля
+        {
+            std::lock_guard<std::mutex> lock(m_sleepMutex);
+            ++m_pending;
+        }
+        {
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            queue.tasks.push_back(std::move(task));
+        }
+        m_wake.notify_one();
+    }
+
+    /**
+     * Выполняет task(index, worker) для index из [0, count) и ждёт завершения.
+     * Первое выброшенное задачей исключение пробрасывается вызывающему.
+     * Нельзя вызывать из задачи этого же пула.
+     */
+    template <typename F>
+    void parallelFor(size_t count, F &&task)
+    {
+        if (count == 0) {
+            return;
+        }
+        size_t remaining = count; // Под doneMutex
+        std::mutex doneMutex;
+        std::condition_variable done;
+        std::exception_ptr error;
+
+        for (size_t i = 0; i < count; ++i) {
+            submit(static_cast<unsigned>(i % size()), [&, i](unsigned worker) {
+                std::exception_ptr taskError;
+                try {
+                    task(i, worker);
+                } catch (...) {
+                    taskError = std::current_exception();
+                }
+                // Счётчик уменьшается под мьютексом: иначе ожидающий поток
+                // может выйти и уничтожить doneMutex раньше, чем его отпустят
+                std::lock_guard<std::mutex> lock(doneMutex);
+                if (taskError && !error) {
+                    error = taskError;
+                }
+                if (--remaining == 0) {
+                    done.notify_all();
+                }
+            });
+        }
+
+        std::unique_lock<std::mutex> lock(doneMutex);
+        done.wait(lock, [&] { return remaining == 0; });
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+
+private:
+
+    struct Queue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    std::vector<std::unique_ptr<Queue>> m_queues;
+    std::vector<std::thread> m_workers;
+    std::mutex m_sleepMutex;
+    std::condition_variable m_wake;
+    size_t m_pending = 0; // Задач в очередях (под m_sleepMutex)
+    bool m_stop = false;
+
+    bool popLocal(unsigned index, Task &task)
+    {
+        Queue &queue = *m_queues[index];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.tasks.empty()) {
+            return false;
+        }
+        task = std::move(queue.tasks.back());
+        queue.tasks.pop_back();
+        return true;
+    }
+
+    bool steal(unsigned index, Task &task)
+    {
+        const size_t n = m_queues.size();
+        for (size_t k = 1; k < n; ++k) {
+            Queue &queue = *m_queues[(index + k) % n];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            if (!queue.tasks.empty()) {
+                task = std::move(queue.tasks.front());
+                queue.tasks.pop_front();
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void workerLoop(unsigned index)
+    {
+        while (true) {
+            Task task;
+            if (popLocal(index, task) || steal(index, task)) {
+                {
+                    std::lock_guard<std::mutex> lock(m_sleepMutex);
+                    --m_pending;
+                }
+                task(index);
+                continue;
+            }
+            std::unique_lock<std::mutex> lock(m_sleepMutex);
+            if (m_stop && m_pending == 0) {
+                return;
+            }
+            m_wake.wait(lock, [this] { return m_stop || m_pending > 0; });
+            if (m_stop && m_pending == 0) {
+                return;
+            }
+        }
+    }
+};
+
+} // namespace SC
+
+#endif // SOLVERCORE_THREADPOOL_HPP_
@@ -0,0 +1,192 @@
+#ifndef SOLVERCORE_VALUEMEMO_HPP_
+#define SOLVERCORE_VALUEMEMO_HPP_
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace SC {
+
+/**
+ * Значения функции (и градиенты, если их уже вычислили) в точках одного
+ * решения: хеш-таблица с открытой адресацией (линейное пробирование), ключ —
+ * пара (x, y), сравниваемая побитово. Методы округляют точки до точности
+ * вычислений, поэтому точка, принятая после поиска шага, совпадает с пробной
+ * точкой поиска, а проверки осцилляций и лучшей точки попадают в таблицу.
+ *
+ * Таблица растёт до kMaxSlots ячеек; заполненная до предела очищается,
+ * т.е. хранит недавние точки. Сброс — clear() в начале каждого solve().
+ */
+class ValueMemo {
+
+    static constexpr size_t kInitialSlots = 256;            // Степень двойки
+    static constexpr size_t kMaxSlots = size_t(1) << 16;    // Степень двойки
+
+public:
+
+    ValueMemo()
+        : m_slots{}
+        , m_size{ 0 }
+    {
+        m_slots.resize(kInitialSlots);
+    }
+
+    size_t size() const { return m_size; }
+
+    void clear()
+    {
+        if (m_slots.size() != kInitialSlots) {
+            m_slots.assign(kInitialSlots, Slot{});
+        } else {
+            std::fill(m_slots.begin(), m_slots.end(), Slot{});
+        }
+        m_size = 0;
+    }
+
+    bool find(double x, double y, double &value) const
+    {
+        const Slot *slot = lookup(x, y);
+        if (!slot) {
+            return false;
+        }
+        value = slot->value;
+        return true;
+    }
+
+    // Значение и градиент; false, если градиент в точке ещё не вычисляли
+    bool findGradient(double x, double y, double &value, double &dx, double &dy) const
+    {
+        const Slot *slot = lookup(x, y);
+        if (!slot || !slot->hasGradient) {
+            return false;
+        }
+        value = slot->value;
+        dx = slot->dx;
+        dy = slot->dy;
+        return true;
+    }
+
+    // Градиент, уже запомненный в точке, не теряется
+    void insert(double x, double y, double value)
+    {
+        if (Slot *slot = place(x, y)) {
+            slot->value = value;
+        }
+    }
+
+    void insertGradient(double x, double y, double value, double dx, double dy)
+    {
+        if (Slot *slot = place(x, y)) {
+            slot->value = value;
+            slot->dx = dx;
+            slot->dy = dy;
+            slot->hasGradient = true;
+        }
+    }
+
+private:
+
+    struct Slot {
+        double x = 0.0;
+        double y = 0.0;
+        double value = 0.0;
+        double dx = 0.0;
+        double dy = 0.0;
+        bool used = false;
+        bool hasGradient = false;
+    };
+
+    std::vector<Slot> m_slots;
+    size_t m_size;
+
+    // -0.0 и 0.0 — одна точка
+    static double normalize(double v) { return (v == 0.0) ? 0.0 : v; }
+
+    static std::uint64_t bits(double v)
+    {
+        v = normalize(v);
+        std::uint64_t out;
+        std::memcpy(&out, &v, sizeof(out));
+        return out;
+    }
+
+    // splitmix64 от координат
+    static size_t hash(double x, double y)
+    {
+        std::uint64_t z = bits(x) * 0x9E3779B97F4A7C15ull ^ bits(y);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return static_cast<size_t>(z ^ (z >> 31));
+    }
+
+    static bool equal(const Slot &slot, double x, double y)
+    {
+        return bits(slot.x) == bits(x) && bits(slot.y) == bits(y);
+    }
+
+    const Slot *lookup(double x, double y) const
+    {
+        const size_t mask = m_slots.size() - 1;
+        for (size_t i = hash(x, y) & mask; m_slots[i].used; i = (i + 1) & mask) {
+            if (equal(m_slots[i], x, y)) {
+                return &m_slots[i];
+            }
+        }
+        return nullptr;
+    }
+
+    // Ячейка точки (новая — пустая); nullptr для точек с NaN: побитовое
+    // равенство для них бессмысленно
+    Slot *place(double x, double y)
+    {
+        if (std::isnan(x) || std::isnan(y)) {
+            return nullptr;
+        }
+        if (2 * (m_size + 1) > m_slots.size()) {
+            grow();
+        }
+        const size_t mask = m_slots.size() - 1;
+        size_t i = hash(x, y) & mask;
+        for (; m_slots[i].used; i = (i + 1) & mask) {
+            if (equal(m_slots[i], x, y)) {
+                return &m_slots[i];
+            }
+        }
+        m_slots[i] = Slot{};
+        m_slots[i].x = normalize(x);
+        m_slots[i].y = normalize(y);
+        m_slots[i].used = true;
+        ++m_size;
+        return &m_slots[i];
+    }
+
+    void grow()
+    {
+        if (m_slots.size() >= kMaxSlots) {
+            std::fill(m_slots.begin(), m_slots.end(), Slot{});
+            m_size = 0;
+            return;
+        }
+        std::vector<Slot> old(m_slots.size() * 2);
+        old.swap(m_slots);
+        m_size = 0;
+        const size_t mask = m_slots.size() - 1;
+        for (const Slot &slot : old) {
+            if (!slot.used) {
+                continue;
+            }
+            size_t i = hash(slot.x, slot.y) & mask;
+            while (m_slots[i].used) {
+                i = (i + 1) & mask;
+            }
+            m_slots[i] = slot;
+            ++m_size;
+        }
+    }
+};
+
+} // namespace SC
+
+#endif // SOLVERCORE_VALUEMEMO_HPP_
@@ -0,0 +1,180 @@
+#ifndef SOLVERCORE_VECTORFUNCTION_HPP_
+#define SOLVERCORE_VECTORFUNCTION_HPP_
+
+#include <SolverCore/Expression.hpp>
+#include <SolverCore/Instrument.hpp>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace SC {
+
+/**
+ * Функция многих переменных для SC::Descent: Expression::parseVector(),
+ * градиент — один обратный проход. Как и Objective для двух переменных,
+ * считает вызовы функции и запоминает значения (и градиенты) в точках
+ * текущего решения: ключ — точка, сравниваемая побитово (-0.0 == 0.0).
+ * Таблица очищается, дойдя до kMaxPoints точек, и в начале каждого решения.
+ */
+template <bool Instrumented>
+class VectorFunction {
+
+    static constexpr size_t kMaxPoints = size_t(1) << 16;
+
+public:
+
+    VectorFunction()
+        : m_expression{}
+        , m_memo{}
+        , m_key{}
+        , m_gradient{}
+        , m_instrument{ nullptr }
+        , m_calls{ 0 }
+    {
+    }
+
+    bool parse(const std::string &function)
+    {
+        if (!m_expression.parseVector(function)) {
+            return false;
+        }
+        m_gradient.assign(size(), 0.0);
+        return true;
+    }
+
+    const std::string &errorMessage() const { return m_expression.errorMessage(); }
+    const std::vector<std::string> &variables() const { return m_expression.variables(); }
+
+    // Начало решения: замеры метода, счётчик и память значений
+    void reset(Instrument<Instrumented> *instrument)
+    {
+        m_instrument = instrument;
+        m_calls = 0;
+        m_memo.clear();
+    }
+
+    size_t size() const { return m_expression.variables().size(); }
+    int calls() const { return m_calls; }
+
+    double value(const double *point)
+    {
+        Entry *entry = find(point);
+        if (entry) {
+            m_instrument->memoHit();
+            return entry->value;
+        }
+        const auto phase = m_instrument->scope(Phase::Function);
+        m_calls++;
+        const double result = m_expression.value(point);
+        if (Entry *slot = place(point)) {
+            slot->value = result;
+        }
+        return result;
+    }
+
+    double gradient(const double *point, double *gradient)
+    {
+        const size_t n = size();
+        Entry *entry = find(point);
+        if (entry && !entry->gradient.empty()) {
+            m_instrument->memoHit();
+            std::memcpy(gradient, entry->gradient.data(), n * sizeof(double));
+            return entry->value;
+        }
+        const auto phase = m_instrument->scope(Phase::Derivative);
+        double result = m_expression.gradient(point, gradient);
+        if (entry) {
+            m_instrument->memoHit();
+            result = entry->value; // То же значение, что видел поиск шага
+        }
+        else {
+            m_calls++;
+        }
+        if (Entry *slot = place(point)) {
+            slot->value = result;
+            slot->gradient.assign(gradient, gradient + n);
+        }
+        return result;
+    }
+
+    double derivative(const double *point, size_t index)
+    {
+        gradient(point, m_gradient.data());
+        return m_gradient[index];
+    }
+
+    // points — n точек подряд по size() координат
+    void valueBatch(const double *points, double *values, int n)
+    {
+        for (int i = 0; i < n; ++i) {
+            values[i] = value(points + static_cast<size_t>(i) * size());
+        }
+    }
+
+private:
+
+    struct Entry {
+        double value = 0.0;
+        std::vector<double> gradient; // Пусто — градиент в точке не вычисляли
+    };
+
+    struct Hash {
+        size_t operator()(const std::vector<std::uint64_t> &key) const
+        {
+            std::uint64_t z = 0;
+            for (std::uint64_t bits : key) {
+                z = (z ^ bits) * 0x9E3779B97F4A7C15ull;
+                z ^= z >> 31;
+            }
+            return static_cast<size_t>(z);
+        }
+    };
+
+    Expression m_expression;
+    std::unordered_map<std::vector<std::uint64_t>, Entry, Hash> m_memo;
+    std::vector<std::uint64_t> m_key; // Буфер ключа поиска
+    std::vector<double> m_gradient;   // Буфер derivative()
+    Instrument<Instrumented> *m_instrument; // Замеры метода, задаются в reset()
+    int m_calls; // Счётчик вызовов функции
+
+    // false для точек с NaN: побитовое равенство для них бессмысленно
+    bool makeKey(const double *point)
+    {
+        m_key.resize(size());
+        for (size_t i = 0; i < m_key.size(); ++i) {
+            if (std::isnan(point[i])) {
+                return false;
+            }
+            const double v = (point[i] == 0.0) ? 0.0 : point[i];
+            std::memcpy(&m_key[i], &v, sizeof(v));
+        }
+        return true;
+    }
+
+    Entry *find(const double *point)
+    {
+        if (!makeKey(point)) {
+            return nullptr;
+        }
+        const auto it = m_memo.find(m_key);
+        return (it != m_memo.end()) ? &it->second : nullptr;
+    }
+
+    Entry *place(const double *point)
+    {
+        if (!makeKey(point)) {
+            return nullptr;
+        }
+        if (m_memo.size() >= kMaxPoints && m_memo.find(m_key) == m_memo.end()) {
+            m_memo.clear();
+        }
+        return &m_memo[m_key];
+    }
+};
+
+} // namespace SC
+
+#endif // SOLVERCORE_VECTORFUNCTION_HPP_
@@ -0,0 +1,316 @@
+#ifndef SOLVERCORE_VECTORSOLVER_HPP_
+#define SOLVERCORE_VECTORSOLVER_HPP_
+
+#include <SolverCore/Descent.hpp>
+#include <SolverCore/Instrument.hpp>
+#include <SolverCore/Progress.hpp>
+#include <SolverCore/VectorFunction.hpp>
+#include <algorithm>
+#include <cmath>
+#include <exception>
+#include <string>
+#include <vector>
+
+namespace SC {
+
+// Алгоритм; значения совпадают с FullAlgoType (Sources/AppEnums.hpp, Batch)
+enum class VectorMethod : int {
+    CoordinateBasic = 1,    // CDB: покоординатный спуск, координаты по очереди
+    CoordinateSteepest = 2, // CDS: координата с наибольшей частной производной
+    GradientBasic = 3,      // GDB: градиентный спуск с заданным шагом
+    GradientSteepest = 4,   // GDS: наискорейший спуск
+    GradientRavine = 5,     // GDR: овражный метод
+    ConjugateGradient = 6   // CGB: сопряжённые градиенты (Флетчер — Ривс)
+};
+
+// Результат; коды совпадают с Result методов
+enum class VectorResult : int {
+    Success = 0,
+    Fail = -1,
+    InvalidInput = -2,
+    OutOfBounds = -4,
+    MaxIterations = -5,
+    MaxFunctionsCalls = -6,
+    ParseError = -7,
+    ComputeError = -8,
+    EmptyFunction = -10,
+    InvalidAlgorithmType = -11,
+    InvalidStepType = -13,
+    InvalidBound = -14,
+    InvalidInitial = -16,
+    InvalidResultPrecision = -18,
+    InvalidComputationPrecision = -19,
+    InvalidLogicPrecision = -20,
+    InvalidStepSize = -21,
+    OscillationDetected = -29,
+    Cancelled = -31
+};
+
+inline std::string resultToString(VectorResult result)
+{
+    switch (result) {
+    case VectorResult::Success:                     return "Успешно";
+    case VectorResult::Fail:                        return "Что-то пошло не так";
+    case VectorResult::InvalidInput:                return "Некорректные входные данные";
+    case VectorResult::OutOfBounds:                 return "Выход за границы";
+    case VectorResult::MaxIterations:               return "Достигнут максимум итераций";
+    case VectorResult::MaxFunctionsCalls:           return "Достигнут максимум вызовов функции";
+    case VectorResult::ParseError:                  return "Ошибка обработки функции";
+    case VectorResult::ComputeError:                return "Вычислительная ошибка";
+    case VectorResult::EmptyFunction:               return "Функция пустая";
+    case VectorResult::InvalidAlgorithmType:        return "Неверный ввод типа алгоритма";
+    case VectorResult::InvalidStepType:             return "Неверный ввод типа шага";
+    case VectorResult::InvalidBound:                return "Неверный ввод границ";
+    case VectorResult::InvalidInitial:              return "Неверный ввод начального приближения";
+    case VectorResult::InvalidResultPrecision:      return "Неверный ввод точности результата";
+    case VectorResult::InvalidComputationPrecision: return "Неверный ввод точности вычислений";
+    case VectorResult::InvalidLogicPrecision:       return "Неверный ввод точностей";
+    case VectorResult::InvalidStepSize:             return "Неверный ввод шага";
+    case VectorResult::OscillationDetected:         return "Обнаружены осцилляции";
+    case VectorResult::Cancelled:                   return "Решение отменено";
+    default:                                        return "Неизвестная ошибка";
+    }
+}
+
+// Границы одной переменной
+struct Bounds {
+    double lower = -1000.0;
+    double upper = 1000.0;
+};
+
+// Входные данные. Векторы — по переменным в порядке VectorSolver::variables()
+struct VectorInputData {
+    std::string function;
+    VectorMethod method = VectorMethod::GradientSteepest;
+    bool maximize = false;
+    StepRule step_type = StepRule::Constant;
+    double step_size = 0.1;           // Постоянный шаг или коэффициент шага (у всех переменных)
+    LineSearchMethod line_search = LineSearchMethod::Sequential;
+    std::vector<double> initial;      // Пусто — ноль (спроецированный на границы) по всем переменным
+    std::vector<Bounds> bounds;       // Пусто — default_bounds для всех переменных
+    Bounds default_bounds;
+    int result_precision = 8;         // Знаков после запятой
+    int computation_precision = 15;
+    int max_iterations = 1000;
+    int max_function_calls = 10000;
+};
+
+/**
+ * Методы оптимизации функции любого числа переменных. Переменные находятся
+ * в выражении сами (Expression::parseVector), решает SC::Descent — тот же,
+ * что у двумерных методов (CD, GD, CG), но без таблиц отчёта: результат —
+ * точка, значение и счётчики.
+ */
+class VectorSolver {
+
+    static constexpr bool INSTRUMENTED{ SOLVERCORE_INSTRUMENT != 0 }; // Замеры по фазам решения
+
+public:
+
+    VectorSolver()
+        : m_inputData{ nullptr }
+        , m_function{}
+        , m_settings{}
+        , m_best{}
+        , m_bestValue{ 0.0 }
+        , m_iterations{ 0 }
+    {
+    }
+
+    VectorResult setInputData(const VectorInputData *data)
+    {
+        if (!data) {
+            return VectorResult::InvalidInput;
+        }
+        if (data->function.empty()) {
+            return VectorResult::EmptyFunction;
+        }
+        if (!m_function.parse(data->function)) {
+            return VectorResult::ParseError;
+        }
+        if (static_cast<int>(data->method) < static_cast<int>(VectorMethod::CoordinateBasic) ||
+            static_cast<int>(data->method) > static_cast<int>(VectorMethod::ConjugateGradient)) {
+            return VectorResult::InvalidAlgorithmType;
+        }
+        if (static_cast<int>(data->step_type) < static_cast<int>(StepRule::Constant) ||
+            static_cast<int>(data->step_type) > static_cast<int>(StepRule::Adaptive)) {
+            return VectorResult::InvalidStepType;
+        }
+        if (!(data->step_size > 0.0)) {
+            return VectorResult::InvalidStepSize;
+        }
+
+        const size_t n = dimension();
+        if (!data->bounds.empty() && data->bounds.size() != n) {
+            return VectorResult::InvalidBound;
+        }
+        const std::vector<Bounds> bounds = data->bounds.empty() ? std::vector<Bounds>(n, data->default_bounds)
+                                                                : data->bounds;
+        for (const Bounds &bound : bounds) {
+            if (!(bound.lower < bound.upper)) {
+                return VectorResult::InvalidBound;
+            }
+        }
+        if (!data->initial.empty()) {
+            if (data->initial.size() != n) {
+                return VectorResult::InvalidInitial;
+            }
+            for (size_t i = 0; i < n; ++i) {
+                if (data->initial[i] < bounds[i].lower || data->initial[i] > bounds[i].upper) {
+                    return VectorResult::InvalidInitial;
+                }
+            }
+        }
+
+        if (data->result_precision < 1 || data->result_precision > 15) {
+            return VectorResult::InvalidResultPrecision;
+        }
+        if (data->computation_precision < 1 || data->computation_precision > 15) {
+            return VectorResult::InvalidComputationPrecision;
+        }
+        if (data->computation_precision < data->result_precision) {
+            return VectorResult::InvalidLogicPrecision;
+        }
+
+        m_settings = DescentSettings{};
+        for (const Bounds &bound : bounds) {
+            m_settings.lower.push_back(bound.lower);
+            m_settings.upper.push_back(bound.upper);
+            // Без начальной точки — ноль, спроецированный на границы
+            m_settings.initial.push_back(std::max(bound.lower, std::min(bound.upper, 0.0)));
+        }
+        if (!data->initial.empty()) {
+            m_settings.initial = data->initial;
+        }
+        m_settings.minimize = !data->maximize;
+        m_settings.lineSearch = data->line_search;
+        m_settings.step = { data->step_type, data->step_size, data->step_size };
+        m_settings.coordinateSteps.assign(n, m_settings.step);
+        m_settings.maxIterations = data->max_iterations;
+        m_settings.maxFunctionCalls = data->max_function_calls;
+        m_settings.computationDigits = data->computation_precision;
+        m_settings.resultDigits = data->result_precision;
+        // Пороги осцилляций — как у двумерных методов
+        const bool coordinate = (data->method == VectorMethod::CoordinateBasic ||
+                                 data->method == VectorMethod::CoordinateSteepest);
+        m_settings.oscillationLimit = coordinate ? 5 : 3;
+
+        m_inputData = data;
+        return VectorResult::Success;
+    }
+
+    VectorResult solve()
+    {
+        if (!m_inputData) {
+            return VectorResult::Fail;
+        }
+        m_instrument.begin();
+        m_function.reset(&m_instrument);
+        m_best.clear();
+        m_bestValue = 0.0;
+        m_iterations = 0;
+
+        VectorResult result = VectorResult::Fail;
+        try {
+            Host host{ this };
+            Descent<VectorFunction<INSTRUMENTED>, Host> descent{ m_function, host, m_settings };
+            Stop stop = Stop::Limits;
+            switch (m_inputData->method) {
+            case VectorMethod::CoordinateBasic:    stop = descent.basicCoordinate(); break;
+            case VectorMethod::CoordinateSteepest: stop = descent.steepestCoordinate(); break;
+            case VectorMethod::GradientBasic:      stop = descent.gradientDescent(); break;
+            case VectorMethod::GradientSteepest:   stop = descent.steepestDescent(); break;
+            case VectorMethod::GradientRavine:     stop = descent.ravine(); break;
+            case VectorMethod::ConjugateGradient:  stop = descent.conjugateGradient(); break;
+            }
+            m_iterations = descent.iterations();
+            m_best = descent.best();
+            m_bestValue = descent.bestValue();
+            result = toResult(stop);
+        }
+        catch (const std::exception &) {
+            result = VectorResult::ComputeError;
+        }
+        for (double &v : m_best) {
+            v = roundTo(v, m_inputData->result_precision);
+        }
+        m_bestValue = roundTo(m_bestValue, m_inputData->result_precision);
+
+        m_instrument.end();
+        return result;
+    }
+
+    size_t dimension() const { return m_function.size(); }
+    const std::vector<std::string> &variables() const { return m_function.variables(); } // После setInputData()
+    const std::vector<double> &getPoint() const { return m_best; }   // Точка экстремума
+    double getOptimumValue() const { return m_bestValue; }           // Значение в ней
+    int getIterations() const { return m_iterations; }
+    int getFunctionCalls() const { return m_function.calls(); }
+
+    // Ход решения и флаг отмены (nullptr — не отслеживать)
+    void setProgress(Progress *progress) { m_progress = progress; }
+
+    // Замеры по фазам последнего solve() (enabled == false, если вырезаны)
+    const SolveStats &getStats() const { return m_instrument.stats(); }
+    // События фаз для Chrome trace (nullptr — не записывать)
+    void setTrace(Trace *trace) { m_instrument.setTrace(trace); }
+
+private:
+
+    // Ход решения для SC::Descent: отчёта нет, только прогресс и отмена
+    struct Host {
+        VectorSolver *solver;
+
+        Instrument<INSTRUMENTED> &instrument() { return solver->m_instrument; }
+
+        template <typename Write>
+        void report(Write &&) {}
+
+        void begin(const std::vector<double> &, double) {}
+        void row(const Iterate &) {}
+
+        bool cancelled(int iterations, double bestValue)
+        {
+            return solver->m_progress && solver->m_progress->update(iterations, bestValue, solver->m_function.calls());
+        }
+    };
+
+    const VectorInputData *m_inputData;
+    Progress *m_progress = nullptr;
+    Instrument<INSTRUMENTED> m_instrument;
+    VectorFunction<INSTRUMENTED> m_function;
+    DescentSettings m_settings;
+    std::vector<double> m_best; // Найденная точка
+    double m_bestValue;
+    int m_iterations;
+
+    VectorResult toResult(Stop stop) const
+    {
+        switch (stop) {
+        case Stop::Converged:     return VectorResult::Success;
+        case Stop::SmallGradient: return VectorResult::Success;
+        case Stop::Oscillation:   return VectorResult::OscillationDetected;
+        case Stop::OutOfBounds:   return VectorResult::OutOfBounds;
+        case Stop::Cancelled:     return VectorResult::Cancelled;
+        default:
+            break;
+        }
+        if (m_iterations >= m_inputData->max_iterations) {
+            return VectorResult::MaxIterations;
+        }
+        if (m_function.calls() >= m_inputData->max_function_calls) {
+            return VectorResult::MaxFunctionsCalls;
+        }
+        return VectorResult::Success;
+    }
+
+    static double roundTo(double v, int digits)
+    {
+        const double factor = std::pow(10.0, digits);
+        return std::round(v * factor) / factor;
+    }
+};
+
+} // namespace SC
+
+#endif // SOLVERCORE_VECTORSOLVER_HPP_
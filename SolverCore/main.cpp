@@ -0,0 +1,83 @@
+//
+// Бенчмарк способов вычисления целевой функции:
+// muParser (Eval через m_x/m_y), SC::Tape и SC::NativeFunction.
+// Печатает число вычислений в секунду для каждого выражения.
+//
+#include <SolverCore/Expression.hpp>
+#include <SolverCore/NativeFunction.hpp>
+#include <SolverCore/Tape.hpp>
+#include <muParser.h>
+#include <chrono>
+#include <cstdio>
+#include <string>
+
+namespace {
+
+constexpr int kPoints = 1 << 20; // Вычислений на один замер
+
+template <typename F>
+double measure(F &&f, double &checksum)
+{
+    const auto start = std::chrono::steady_clock::now();
+    double sum = 0.0;
+    for (int i = 0; i < kPoints; ++i) {
+        const double x = -2.0 + 4.0 * (i & 1023) / 1024.0;
+        const double y = -2.0 + 4.0 * (i >> 10) / 1024.0;
+        sum += f(x, y);
+    }
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    checksum = sum;
+    return kPoints / elapsed.count();
+}
+
+} // namespace
+
+int main()
+{
+    const char *functions[] = {
+        "x^2 + y^2",
+        "(1-x)^2 + 100*(y-x^2)^2",
+        "(x^2+y-11)^2 + (x+y^2-7)^2",
+        "20 + x^2 - 10*cos(2*_pi*x) + y^2 - 10*cos(2*_pi*y)",
+        "-20*exp(-0.2*sqrt(0.5*(x^2+y^2))) - exp(0.5*(cos(2*_pi*x)+cos(2*_pi*y))) + _e + 20",
+        "sin(x)*cos(y) + log(1 + x^2*y^2) + sqrt(abs(x*y) + 1) + atan(x - y) + tanh(x*y)"
+    };
+
+    std::printf("%-12s %14s %14s %14s  %s\n", "", "muParser", "tape", "native", "expression");
+    for (const char *function : functions) {
+        double x = 0.0, y = 0.0;
+        mu::Parser parser;
+        parser.SetExpr(function);
+        parser.DefineVar("x", &x);
+        parser.DefineVar("y", &y);
+
+        SC::Expression expression;
+        if (!expression.parse(function)) {
+            std::printf("parse error: %s\n", expression.errorMessage().c_str());
+            continue;
+        }
+        SC::Tape tape;
+        tape.compile(expression);
+        SC::NativeFunction native;
+        const bool hasNative = native.compile(expression);
+
+        double sumParser = 0.0, sumTape = 0.0, sumNative = 0.0;
+        const double rateParser = measure([&](double px, double py) {
+            x = px;
+            y = py;
+            return parser.Eval();
+        }, sumParser);
+        const double rateTape = measure(tape, sumTape);
+        const double rateNative = hasNative ? measure(native, sumNative) : 0.0;
+
+        std::printf("%-12s %14.0f %14.0f %14.0f  %s\n", "eval/s", rateParser, rateTape, rateNative, function);
+        std::printf("%-12s %14s %14.2f %14.2f\n", "speedup", "1.00", rateTape / rateParser, rateNative / rateParser);
+        if (!hasNative) {
+            std::printf("  native: %s\n", native.errorMessage().c_str());
+        }
+        if (sumParser != sumTape || (hasNative && sumParser != sumNative)) {
+            std::printf("  warning: checksums differ (%.17g / %.17g / %.17g)\n", sumParser, sumTape, sumNative);
+        }
+    }
+    return 0;
+}
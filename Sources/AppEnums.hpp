@@ -41,6 +41,33 @@ public:
     explicit Result(QObject *parent = nullptr) : QObject(parent) {}
 };
 
+class ReportFormat : public QObject {
+    Q_OBJECT
+public:
+    enum Type {
+        JSON = 0, // text, *.json
+        CBOR = 1  // binary, *.cbor, tables as packed double columns
+    };
+    Q_ENUM(Type)
+
+    explicit ReportFormat(QObject *parent = nullptr) : QObject(parent) {}
+};
+
+class RowPolicy : public QObject {
+    Q_OBJECT
+public:
+    enum Type { // same values as SC::RowPolicy
+        ALL        = 0,
+        EVERY_NTH  = 1,
+        LOG_SPACED = 2,
+        IMPROVING  = 3,
+        FIRST_LAST = 4
+    };
+    Q_ENUM(Type)
+
+    explicit RowPolicy(QObject *parent = nullptr) : QObject(parent) {}
+};
+
 class StepType : public QObject {
     Q_OBJECT
 public:
@@ -0,0 +1,116 @@
+//
+// Created on 17 Oct, 2026
+//  by alecproj
+//
+
+#include "CborTable.hpp"
+
+#include <QCborStreamReader>
+#include <QCborValue>
+#include <QDebug>
+#include <QtEndian>
+
+#include <algorithm>
+#include <cmath>
+
+CborTable::CborTable(std::shared_ptr<const MappedFile> file, int rowCount, std::vector<Column> columns)
+    : m_file{std::move(file)}
+    , m_rowCount{rowCount}
+    , m_columns{std::move(columns)}
+    , m_blockOffsets(m_columns.size())
+    , m_cellCounts(m_columns.size(), -1)
+    , m_blocks(m_columns.size() * CACHED_BLOCKS)
+    , m_useCounter{0}
+{
+    for (Column &column : m_columns) {
+        if (!column.copy.isEmpty()) {
+            column.packed = column.copy;
+        }
+        // A short packed column would be read past its end
+        if (!column.packed.isEmpty() && column.packed.size() < qsizetype(m_rowCount) * qsizetype(sizeof(double))) {
+            qWarning() << "CborTable: packed column is shorter than the table";
+            column.packed = {};
+        }
+    }
+}
+
+QVariant CborTable::cell(int row, int column) const
+{
+    if (row < 0 || row >= m_rowCount || column < 0 || column >= columnCount()) {
+        return {};
+    }
+    const Column &col = m_columns[column];
+    if (!col.packed.isEmpty()) {
+        const double v = qFromLittleEndian<double>(col.packed.data() + row * sizeof(double));
+        return std::isnan(v) ? QVariant() : QVariant(v);
+    }
+    if (m_cellCounts[column] < 0) {
+        buildIndex(column);
+    }
+    if (row >= m_cellCounts[column]) {
+        return {};
+    }
+    const Block &b = block(column, row / BLOCK_ROWS);
+    const int i = row % BLOCK_ROWS;
+    return (i < int(b.cells.size())) ? b.cells[i] : QVariant();
+}
+
+void CborTable::buildIndex(int column) const
+{
+    const QByteArrayView encoded = m_columns[column].encoded;
+    auto &offsets = m_blockOffsets[column];
+    int count = 0;
+    QCborStreamReader reader(encoded.data(), encoded.size());
+    if (!reader.isArray() || !reader.enterContainer()) {
+        m_cellCounts[column] = 0;
+        return;
+    }
+    while (count < m_rowCount && reader.hasNext()) {
+        if (count % BLOCK_ROWS == 0) {
+            offsets.push_back(reader.currentOffset());
+        }
+        if (!reader.next()) break;
+        ++count;
+    }
+    if (reader.lastError() != QCborError::NoError) {
+        qWarning() << "CborTable: malformed column after cell" << count;
+    }
+    m_cellCounts[column] = count;
+}
+
+const CborTable::Block &CborTable::block(int column, int index) const
+{
+    Block *const slots = &m_blocks[std::size_t(column) * CACHED_BLOCKS];
+    Block *slot = slots;
+    for (Block *b = slots; b != slots + CACHED_BLOCKS; ++b) {
+        if (b->index == index) {
+            b->lastUse = ++m_useCounter;
+            return *b;
+        }
+        if (b->lastUse < slot->lastUse) {
+            slot = b;
+        }
+    }
+
+    // Decode the block into the least recently used slot
+    slot->index = index;
+    slot->lastUse = ++m_useCounter;
+    slot->cells.clear();
+    const int cells = std::min(BLOCK_ROWS, m_cellCounts[column] - index * BLOCK_ROWS);
+    const QByteArrayView encoded = m_columns[column].encoded.sliced(m_blockOffsets[column][index]);
+    // The cells of the block follow each other as complete items
+    QCborStreamReader reader(encoded.data(), encoded.size());
+    for (int i = 0; i < cells && reader.lastError() == QCborError::NoError; ++i) {
+        const QCborValue value = QCborValue::fromCbor(reader);
+        if (value.isBool()) {
+            slot->cells.push_back(value.toBool());
+        } else if (value.isInteger() || value.isDouble()) {
+            slot->cells.push_back(value.toDouble());
+        } else if (value.isString()) {
+            slot->cells.push_back(value.toString());
+        } else {
+            slot->cells.push_back(QVariant());
+        }
+    }
+    return *slot;
+}
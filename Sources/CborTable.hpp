@@ -0,0 +1,71 @@
+//
+// Created on 17 Oct, 2026
+//  by alecproj
+//
+
+#ifndef SOURCES_CBORTABLE_HPP_
+#define SOURCES_CBORTABLE_HPP_
+
+#include "MappedFile.hpp"
+
+#include <QByteArray>
+#include <QByteArrayView>
+#include <QVariant>
+
+#include <memory>
+#include <vector>
+
+/**
+ * Cells of a table of a CBOR report (see ReportCbor) left in the mapped
+ * report file. A column of numbers is a view of its packed float64
+ * values, which are read in place; any other column keeps the range of
+ * its encoded array. The first cell() of such a column walks the array
+ * once and keeps the offset of every BLOCK_ROWS-th cell; cells are then
+ * decoded a block at a time and only the last few blocks of each column
+ * are kept, as in DeferredRows.
+ *
+ * Not thread-safe: meant to be used from the thread of the view.
+ */
+class CborTable {
+
+public:
+    struct Column {
+        QByteArrayView packed;  // rowCount float64 little-endian values or empty
+        QByteArrayView encoded; // CBOR array of a column that is not packed
+        QByteArray copy;        // packed values of a chunked byte string
+    };
+
+    CborTable(std::shared_ptr<const MappedFile> file, int rowCount, std::vector<Column> columns);
+
+    int rowCount() const { return m_rowCount; }
+    int columnCount() const { return static_cast<int>(m_columns.size()); }
+    const Column &column(int index) const { return m_columns[index]; }
+    /**
+     * @return the cell as double, QString or bool; invalid for null and
+     * for cells past the end of a short column
+     */
+    QVariant cell(int row, int column) const;
+
+private:
+    static constexpr int BLOCK_ROWS = 256;
+    static constexpr int CACHED_BLOCKS = 4;
+
+    struct Block {
+        int index = -1;
+        quint64 lastUse = 0;
+        std::vector<QVariant> cells;
+    };
+
+    std::shared_ptr<const MappedFile> m_file; // keeps the views valid
+    int m_rowCount;
+    std::vector<Column> m_columns;
+    mutable std::vector<std::vector<qint64>> m_blockOffsets; // column -> offset of each block, empty until indexed
+    mutable std::vector<int> m_cellCounts;                   // column -> cells in the array, -1 until indexed
+    mutable std::vector<Block> m_blocks;                     // CACHED_BLOCKS slots per column
+    mutable quint64 m_useCounter;
+
+    void buildIndex(int column) const;
+    const Block &block(int column, int index) const;
+};
+
+#endif // SOURCES_CBORTABLE_HPP_
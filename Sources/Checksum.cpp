@@ -0,0 +1,276 @@
+//
+// Created on 17 Oct, 2026
+//  by alecproj
+//
+
+#include "Checksum.hpp"
+
+#include <array>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#  define CHECKSUM_X86 1
+#  include <immintrin.h>
+#  if defined(_MSC_VER)
+#    include <intrin.h>
+#  endif
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#  define CHECKSUM_ARM64 1
+#  if defined(__linux__)
+#    include <sys/auxv.h>
+#    include <asm/hwcap.h>
+#  endif
+#  include <arm_acle.h>
+#endif
+
+namespace {
+
+using Kernel = uint32_t (*)(uint32_t state, const unsigned char *data, std::size_t size);
+
+// ---------------------------- slicing-by-8 ----------------------------
+
+using Tables = std::array<std::array<uint32_t, 256>, 8>;
+
+constexpr Tables makeTables()
+{
+    Tables t{};
+    for (uint32_t i = 0; i < 256; ++i) {
+        uint32_t c = i;
+        for (int j = 0; j < 8; ++j)
+            c = (c & 1) ? (0xEDB88320u ^ (c >> 1)) : (c >> 1);
+        t[0][i] = c;
+    }
+    for (uint32_t i = 0; i < 256; ++i) {
+        for (int k = 1; k < 8; ++k)
+            t[k][i] = (t[k - 1][i] >> 8) ^ t[0][t[k - 1][i] & 0xFFu];
+    }
+    return t;
+}
+
+// Built at compile time, so there is nothing to initialize at runtime
+constexpr Tables TABLES = makeTables();
+
+uint32_t crcBytes(uint32_t state, const unsigned char *data, std::size_t size)
+{
+    for (std::size_t i = 0; i < size; ++i)
+        state = TABLES[0][(state ^ data[i]) & 0xFFu] ^ (state >> 8);
+    return state;
+}
+
+uint32_t crcSlicing8(uint32_t state, const unsigned char *data, std::size_t size)
+{
+    while (size >= 8) {
+        uint32_t lo;
+        uint32_t hi;
+        std::memcpy(&lo, data, 4);
+        std::memcpy(&hi, data + 4, 4);
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+        lo = __builtin_bswap32(lo);
+        hi = __builtin_bswap32(hi);
+#endif
+        lo ^= state;
+        state = TABLES[7][lo & 0xFFu] ^ TABLES[6][(lo >> 8) & 0xFFu]
+              ^ TABLES[5][(lo >> 16) & 0xFFu] ^ TABLES[4][lo >> 24]
+              ^ TABLES[3][hi & 0xFFu] ^ TABLES[2][(hi >> 8) & 0xFFu]
+              ^ TABLES[1][(hi >> 16) & 0xFFu] ^ TABLES[0][hi >> 24];
+        data += 8;
+        size -= 8;
+    }
+    return crcBytes(state, data, size);
+}
+
+// ------------------------ x86: PCLMULQDQ folding ----------------------
+//
+// Folding of 4x128 bit lanes and Barrett reduction as in Intel's
+// "Fast CRC Computation for Generic Polynomials Using PCLMULQDQ",
+// with the bit-reflected constants for the IEEE polynomial.
+
+#if defined(CHECKSUM_X86)
+
+#if defined(__GNUC__) || defined(__clang__)
+#  define CHECKSUM_TARGET_CLMUL __attribute__((target("pclmul,sse4.1")))
+#else
+#  define CHECKSUM_TARGET_CLMUL
+#endif
+
+// size >= 64 and a multiple of 16
+CHECKSUM_TARGET_CLMUL
+uint32_t crcClmulBlocks(uint32_t state, const unsigned char *data, std::size_t size)
+{
+    alignas(16) static const uint64_t k1k2[] = { 0x0154442bd4, 0x01c6e41596 };
+    alignas(16) static const uint64_t k3k4[] = { 0x01751997d0, 0x00ccaa009e };
+    alignas(16) static const uint64_t k5k0[] = { 0x0163cd6124, 0x0000000000 };
+    alignas(16) static const uint64_t poly[] = { 0x01db710641, 0x01f7011641 };
+
+    __m128i x0, x1, x2, x3, x4, x5, x6, x7, x8, y5, y6, y7, y8;
+
+    x1 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + 0x00));
+    x2 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + 0x10));
+    x3 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + 0x20));
+    x4 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + 0x30));
+    x1 = _mm_xor_si128(x1, _mm_cvtsi32_si128(static_cast<int>(state)));
+    x0 = _mm_load_si128(reinterpret_cast<const __m128i *>(k1k2));
+    data += 64;
+    size -= 64;
+
+    // Four lanes in parallel
+    while (size >= 64) {
+        x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+        x6 = _mm_clmulepi64_si128(x2, x0, 0x00);
+        x7 = _mm_clmulepi64_si128(x3, x0, 0x00);
+        x8 = _mm_clmulepi64_si128(x4, x0, 0x00);
+        x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+        x2 = _mm_clmulepi64_si128(x2, x0, 0x11);
+        x3 = _mm_clmulepi64_si128(x3, x0, 0x11);
+        x4 = _mm_clmulepi64_si128(x4, x0, 0x11);
+        y5 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + 0x00));
+        y6 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + 0x10));
+        y7 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + 0x20));
+        y8 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + 0x30));
+        x1 = _mm_xor_si128(_mm_xor_si128(x1, x5), y5);
+        x2 = _mm_xor_si128(_mm_xor_si128(x2, x6), y6);
+        x3 = _mm_xor_si128(_mm_xor_si128(x3, x7), y7);
+        x4 = _mm_xor_si128(_mm_xor_si128(x4, x8), y8);
+        data += 64;
+        size -= 64;
+    }
+
+    // Fold the four lanes into one
+    x0 = _mm_load_si128(reinterpret_cast<const __m128i *>(k3k4));
+    for (__m128i next : {x2, x3, x4}) {
+        x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+        x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+        x1 = _mm_xor_si128(_mm_xor_si128(x1, next), x5);
+    }
+
+    // Remaining 16 byte blocks
+    while (size >= 16) {
+        x2 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data));
+        x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+        x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+        x1 = _mm_xor_si128(_mm_xor_si128(x1, x2), x5);
+        data += 16;
+        size -= 16;
+    }
+
+    // 128 -> 64 bits
+    x2 = _mm_clmulepi64_si128(x1, x0, 0x10);
+    x3 = _mm_setr_epi32(~0, 0, ~0, 0);
+    x1 = _mm_srli_si128(x1, 8);
+    x1 = _mm_xor_si128(x1, x2);
+    x0 = _mm_loadl_epi64(reinterpret_cast<const __m128i *>(k5k0));
+    x2 = _mm_srli_si128(x1, 4);
+    x1 = _mm_and_si128(x1, x3);
+    x1 = _mm_clmulepi64_si128(x1, x0, 0x00);
+    x1 = _mm_xor_si128(x1, x2);
+
+    // Barrett reduction to 32 bits
+    x0 = _mm_load_si128(reinterpret_cast<const __m128i *>(poly));
+    x2 = _mm_and_si128(x1, x3);
+    x2 = _mm_clmulepi64_si128(x2, x0, 0x10);
+    x2 = _mm_and_si128(x2, x3);
+    x2 = _mm_clmulepi64_si128(x2, x0, 0x00);
+    x1 = _mm_xor_si128(x1, x2);
+    return static_cast<uint32_t>(_mm_extract_epi32(x1, 1));
+}
+
+uint32_t crcClmul(uint32_t state, const unsigned char *data, std::size_t size)
+{
+    if (size >= 64) {
+        const std::size_t blocks = size & ~std::size_t(15);
+        state = crcClmulBlocks(state, data, blocks);
+        data += blocks;
+        size -= blocks;
+    }
+    return crcSlicing8(state, data, size);
+}
+
+bool hasClmul()
+{
+#if defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 1);
+    return (info[2] & (1 << 1)) && (info[2] & (1 << 19)); // PCLMULQDQ, SSE4.1
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("pclmul") && __builtin_cpu_supports("sse4.1");
+#endif
+}
+
+#endif // CHECKSUM_X86
+
+// ------------------------- ARMv8: CRC32 instructions ---------------------
+
+#if defined(CHECKSUM_ARM64)
+
+#if defined(__clang__)
+#  define CHECKSUM_TARGET_CRC __attribute__((target("crc")))
+#elif defined(__GNUC__)
+#  define CHECKSUM_TARGET_CRC __attribute__((target("+crc")))
+#else
+#  define CHECKSUM_TARGET_CRC
+#endif
+
+CHECKSUM_TARGET_CRC
+uint32_t crcArm(uint32_t state, const unsigned char *data, std::size_t size)
+{
+    while (size >= 8) {
+        uint64_t word;
+        std::memcpy(&word, data, 8);
+        state = __crc32d(state, word);
+        data += 8;
+        size -= 8;
+    }
+    while (size--) {
+        state = __crc32b(state, *data++);
+    }
+    return state;
+}
+
+bool hasArmCrc()
+{
+#if defined(__APPLE__) || defined(_MSC_VER)
+    return true; // every Apple silicon and Windows on ARM CPU has it
+#elif defined(__linux__) && defined(HWCAP_CRC32)
+    return (getauxval(AT_HWCAP) & HWCAP_CRC32) != 0;
+#else
+    return false;
+#endif
+}
+
+#endif // CHECKSUM_ARM64
+
+struct Dispatch {
+    Kernel kernel;
+    const char *name;
+};
+
+Dispatch selectKernel()
+{
+#if defined(CHECKSUM_X86)
+    if (hasClmul()) return {crcClmul, "pclmul"};
+#elif defined(CHECKSUM_ARM64)
+    if (hasArmCrc()) return {crcArm, "armv8-crc32"};
+#endif
+    return {crcSlicing8, "slicing-by-8"};
+}
+
+// Thread-safe one-time selection (function-local static)
+const Dispatch &dispatch()
+{
+    static const Dispatch d = selectKernel();
+    return d;
+}
+
+} // namespace
+
+void Crc32::update(const void *data, std::size_t size)
+{
+    if (size == 0) return;
+    m_state = dispatch().kernel(m_state, static_cast<const unsigned char *>(data), size);
+}
+
+const char *Crc32::kernelName()
+{
+    return dispatch().name;
+}
@@ -0,0 +1,44 @@
+//
+// Created on 17 Oct, 2026
+//  by alecproj
+//
+
+#ifndef SOURCES_CHECKSUM_HPP_
+#define SOURCES_CHECKSUM_HPP_
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * Streaming CRC-32 (IEEE 802.3, the zlib one). Data can be fed in any
+ * number of pieces; the result is the same as for one contiguous buffer.
+ *
+ * The kernel is chosen once at runtime: carry-less multiplication folding
+ * on x86 with PCLMULQDQ, the CRC32 instructions on ARMv8, slicing-by-8
+ * tables everywhere else. All kernels give identical results.
+ */
+class Crc32 {
+
+public:
+    Crc32() : m_state{0xFFFFFFFFu} {}
+
+    void update(const void *data, std::size_t size);
+    uint32_t value() const { return m_state ^ 0xFFFFFFFFu; }
+    void reset() { m_state = 0xFFFFFFFFu; }
+
+    static uint32_t compute(const void *data, std::size_t size)
+    {
+        Crc32 crc;
+        crc.update(data, size);
+        return crc.value();
+    }
+    /**
+     * @return name of the kernel in use, for diagnostics
+     */
+    static const char *kernelName();
+
+private:
+    uint32_t m_state; // inverted CRC
+};
+
+#endif // SOURCES_CHECKSUM_HPP_
@@ -0,0 +1,92 @@
+//
+// Created on 17 Oct, 2026
+//  by alecproj
+//
+
+#include "DeferredRows.hpp"
+#include "JsonCursor.hpp"
+
+#include <QDebug>
+
+#include <algorithm>
+
+DeferredRows::DeferredRows(std::shared_ptr<const MappedFile> file, QByteArrayView rows)
+    : m_file{std::move(file)}
+    , m_rows{rows}
+    , m_indexed{false}
+    , m_rowCount{0}
+    , m_blockOffsets{}
+    , m_blocks{}
+    , m_useCounter{0}
+{
+}
+
+int DeferredRows::rowCount() const
+{
+    if (!m_indexed) {
+        buildIndex();
+    }
+    return m_rowCount;
+}
+
+QVariant DeferredRows::cell(int row, int column) const
+{
+    if (row < 0 || row >= rowCount() || column < 0) {
+        return {};
+    }
+    const Block &b = block(row / BLOCK_ROWS);
+    const auto &cells = b.rows[row % BLOCK_ROWS];
+    return (column < int(cells.size())) ? cells[column] : QVariant();
+}
+
+void DeferredRows::buildIndex() const
+{
+    m_indexed = true;
+    JsonCursor cursor(m_rows);
+    if (!cursor.enterArray()) {
+        qWarning() << "DeferredRows: rows are not an array";
+        return;
+    }
+    int count = 0;
+    while (cursor.nextElement()) {
+        if (count % BLOCK_ROWS == 0) {
+            m_blockOffsets.push_back(cursor.pos());
+        }
+        if (!cursor.skipValue()) break;
+        ++count;
+    }
+    if (cursor.failed()) {
+        qWarning() << "DeferredRows: malformed rows after row" << count;
+    }
+    m_rowCount = count;
+}
+
+const DeferredRows::Block &DeferredRows::block(int index) const
+{
+    Block *slot = &m_blocks[0];
+    for (Block &b : m_blocks) {
+        if (b.index == index) {
+            b.lastUse = ++m_useCounter;
+            return b;
+        }
+        if (b.lastUse < slot->lastUse) {
+            slot = &b;
+        }
+    }
+
+    // Decode the block into the least recently used slot
+    slot->index = index;
+    slot->lastUse = ++m_useCounter;
+    const int rows = std::min(BLOCK_ROWS, m_rowCount - index * BLOCK_ROWS);
+    slot->rows.assign(rows, {});
+    JsonCursor cursor(m_rows, m_blockOffsets[index]);
+    for (int r = 0; r < rows; ++r) {
+        if ((r > 0 && !cursor.nextElement()) || !cursor.enterArray()) break;
+        auto &cells = slot->rows[r];
+        QVariant value;
+        while (cursor.nextElement() && cursor.readValue(&value)) {
+            cells.push_back(value);
+        }
+    }
+    return *slot;
+}
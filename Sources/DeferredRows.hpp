@@ -0,0 +1,74 @@
+//
+// Created on 17 Oct, 2026
+//  by alecproj
+//
+
+#ifndef SOURCES_DEFERREDROWS_HPP_
+#define SOURCES_DEFERREDROWS_HPP_
+
+#include "CborTable.hpp"
+#include "MappedFile.hpp"
+
+#include <QByteArrayView>
+#include <QJsonArray>
+#include <QList>
+#include <QVariant>
+
+#include <memory>
+#include <vector>
+
+/**
+ * Rows of a report table that stay in the mapped report file until a view
+ * asks for them. The first rowCount() call walks the rows once and keeps
+ * the offset of every BLOCK_ROWS-th row; cells are then decoded a block at
+ * a time, and only the last few blocks are kept. Memory use depends on
+ * the part of the table being looked at, not on its size.
+ *
+ * Not thread-safe: meant to be used from the thread of the view.
+ */
+class DeferredRows {
+
+public:
+    DeferredRows(std::shared_ptr<const MappedFile> file, QByteArrayView rows);
+
+    int rowCount() const;
+    /**
+     * @return the cell as double, QString or bool; invalid for null and
+     * for cells past the end of a short row
+     */
+    QVariant cell(int row, int column) const;
+
+private:
+    static constexpr int BLOCK_ROWS = 256;
+    static constexpr int CACHED_BLOCKS = 4;
+
+    struct Block {
+        int index = -1;
+        quint64 lastUse = 0;
+        std::vector<std::vector<QVariant>> rows;
+    };
+
+    std::shared_ptr<const MappedFile> m_file; // keeps m_rows valid
+    QByteArrayView m_rows;                    // text of the "rows" array
+    mutable bool m_indexed;
+    mutable int m_rowCount;
+    mutable std::vector<qsizetype> m_blockOffsets; // offset of the first row of each block
+    mutable Block m_blocks[CACHED_BLOCKS];
+    mutable quint64 m_useCounter;
+
+    void buildIndex() const;
+    const Block &block(int index) const;
+};
+
+/**
+ * Solution part of a report as given by ReportReader: the items, where a
+ * table either has its "rows" inline or has its cells left in the mapped
+ * report file (rows of a JSON report, columns of a CBOR report).
+ */
+struct ReportSolution {
+    QJsonArray items;
+    QList<std::shared_ptr<DeferredRows>> deferredRows; // item index -> rows or nullptr
+    QList<std::shared_ptr<const CborTable>> cborTables; // item index -> cells or nullptr
+};
+
+#endif // SOURCES_DEFERREDROWS_HPP_
@@ -4,6 +4,7 @@
 //
 
 #include "FileManager.hpp"
+#include "Checksum.hpp"
 
 #include <QStandardPaths>
 #include <QSaveFile>
@@ -33,11 +34,24 @@ QStringList FileManager::listFiles(QDir::SortFlags sortBy, const QString &filter
     }
     QDir dir(path);
     QStringList nameFilters;
-    if (filter.isEmpty()) nameFilters << QStringLiteral("*.json");
+    if (filter.isEmpty()) nameFilters << QStringLiteral("*.json") << QStringLiteral("*.cbor");
     else nameFilters << filter;
     return dir.entryList(nameFilters, QDir::Files | QDir::Readable, sortBy);
 }
 
+QFileInfoList FileManager::listFileInfos(QDir::SortFlags sortBy, const QString &filter)
+{
+    QString path{};
+    if (!ensureBaseDirExists(path)) {
+         return {};
+    }
+    QDir dir(path);
+    QStringList nameFilters;
+    if (filter.isEmpty()) nameFilters << QStringLiteral("*.json") << QStringLiteral("*.cbor");
+    else nameFilters << filter;
+    return dir.entryInfoList(nameFilters, QDir::Files | QDir::Readable, sortBy);
+}
+
 bool FileManager::fileExists(const QString &fileName)
 {
     QString path{};
@@ -48,10 +62,19 @@ bool FileManager::fileExists(const QString &fileName)
     return fi.exists() && fi.isFile();
 }
 
-bool FileManager::loadJsonFile(const QString &fileName, QJsonObject &outObj)
+QFileInfo FileManager::reportFileInfo(const QString &fileName)
+{
+    QString path{};
+    if (!ensureBaseDirExists(path)) {
+        return {};
+    }
+    return QFileInfo(QDir(path).filePath(fileName));
+}
+
+bool FileManager::loadFile(const QString &fileName, QByteArray &outBytes)
 {
     QString dir;
-    if (!ensureBaseDirExists(dir)) return {};
+    if (!ensureBaseDirExists(dir)) return false;
 
     QString fullPath = QDir(dir).filePath(fileName);
 
@@ -60,27 +83,64 @@ bool FileManager::loadJsonFile(const QString &fileName, QJsonObject &outObj)
         qWarning() << "FileManager: cannot open file for reading:" << fullPath;
         return false;
     }
-    QByteArray data = f.readAll();
+    outBytes = f.readAll();
+    return true;
+}
+
+std::shared_ptr<const MappedFile> FileManager::mapFile(const QString &fileName)
+{
+    QString dir;
+    if (!ensureBaseDirExists(dir)) return nullptr;
+
+    QString fullPath = QDir(dir).filePath(fileName);
+    auto file = MappedFile::open(fullPath);
+    if (!file) {
+        qWarning() << "FileManager: cannot open file for reading:" << fullPath;
+    }
+    return file;
+}
+
+bool FileManager::loadJsonFile(const QString &fileName, QJsonObject &outObj)
+{
+    QByteArray data;
+    if (!loadFile(fileName, data)) {
+        return false;
+    }
     QJsonParseError err;
     QJsonDocument doc = QJsonDocument::fromJson(data, &err);
     if (err.error != QJsonParseError::NoError) {
-        qWarning() << "FileManager: JSON parse error in:" << fullPath << ":" << err.errorString();
+        qWarning() << "FileManager: JSON parse error in:" << fileName << ":" << err.errorString();
         return false;
     }
     if (!doc.isObject()) {
-        qWarning() << "FileManager: JSON object expected in:" << fullPath;
+        qWarning() << "FileManager: JSON object expected in:" << fileName;
         return false;
     }
     outObj = doc.object();
     return true;
 }
 
-bool FileManager::saveJsonFile(const QString &fileName, const QJsonObject &obj)
+bool FileManager::saveJsonFile(const QString &fileName, const QJsonObject &obj,
+    QJsonDocument::JsonFormat format)
+{
+    return saveFile(fileName, [&](QIODevice &file) {
+        QJsonDocument doc(obj);
+        QByteArray data = doc.toJson(format);
+        return file.write(data) == data.size();
+    });
+}
+
+bool FileManager::saveFile(const QString &fileName, const std::function<bool(QIODevice &)> &write)
 {
     QString dir;
     if (!ensureBaseDirExists(dir)) return false;
 
     QString fullPath = QDir(dir).filePath(fileName);
+    // The file may live in a subdirectory of the report directory
+    if (!QDir().mkpath(QFileInfo(fullPath).absolutePath())) {
+        qWarning() << "FileManager: cannot create directory for:" << fullPath;
+        return false;
+    }
 
     QLockFile lock(fullPath + ".lock");
     lock.setStaleLockTime(30000); // 30 s
@@ -95,9 +155,7 @@ bool FileManager::saveJsonFile(const QString &fileName, const QJsonObject &obj)
         return false;
     }
 
-    QJsonDocument doc(obj);
-    QByteArray data = doc.toJson(QJsonDocument::Indented);
-    if (file.write(data) != data.size()) {
+    if (!write(file)) {
         qWarning() << "FileManager: incomplete write to" << fullPath;
         file.cancelWriting();
         return false;
@@ -109,6 +167,36 @@ bool FileManager::saveJsonFile(const QString &fileName, const QJsonObject &obj)
     return true;
 }
 
+bool FileManager::appendFile(const QString &fileName, const QByteArray &bytes)
+{
+    QString dir;
+    if (!ensureBaseDirExists(dir)) return false;
+
+    QString fullPath = QDir(dir).filePath(fileName);
+    if (!QDir().mkpath(QFileInfo(fullPath).absolutePath())) {
+        qWarning() << "FileManager: cannot create directory for:" << fullPath;
+        return false;
+    }
+
+    QLockFile lock(fullPath + ".lock");
+    lock.setStaleLockTime(30000);
+    if (!lock.tryLock(5000)) {
+        qWarning() << "FileManager: cannot lock file for writing:" << fullPath;
+        return false;
+    }
+
+    QFile file(fullPath);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Append)) {
+        qWarning() << "FileManager: cannot open file for appending:" << fullPath << file.errorString();
+        return false;
+    }
+    if (file.write(bytes) != bytes.size() || !file.flush()) {
+        qWarning() << "FileManager: incomplete append to" << fullPath;
+        return false;
+    }
+    return true;
+}
+
 bool FileManager::deleteFile(const QString &fileName) {
     QString path;
     if (!ensureBaseDirExists(path)) {
@@ -153,23 +241,7 @@ QVariantMap FileManager::fileInfo(const QString &fileName)
 
 uint32_t FileManager::crc32FromBytes(const QByteArray &bytes)
 {
-    static uint32_t table[256];
-    static bool inited = false;
-    if (!inited) {
-        for (uint32_t i = 0; i < 256; ++i) {
-            uint32_t c = i;
-            for (int j = 0; j < 8; ++j)
-                c = (c & 1) ? (0xEDB88320u ^ (c >> 1)) : (c >> 1);
-            table[i] = c;
-        }
-        inited = true;
-    }
-
-    uint32_t crc = 0xFFFFFFFFu;
-    for (unsigned char ch : bytes) {
-        crc = table[(crc ^ ch) & 0xFFu] ^ (crc >> 8);
-    }
-    return crc ^ 0xFFFFFFFFu;
+    return Crc32::compute(bytes.constData(), static_cast<std::size_t>(bytes.size()));
 }
 
 QString FileManager::baseDir()
@@ -6,9 +6,16 @@
 #ifndef SOURCES_FILEMANAGER_HPP_
 #define SOURCES_FILEMANAGER_HPP_
 
+#include "MappedFile.hpp"
+
 #include <QDir>
 #include <QString>
 #include <QJsonObject>
+#include <QJsonDocument>
+#include <QFileInfo>
+
+#include <functional>
+#include <memory>
 
 class FileManager {
 
@@ -19,9 +26,39 @@ public:
         QDir::SortFlags sortBy = (QDir::Time | QDir::Reversed),
         const QString &filter = QString()
     );
+    /**
+     * Same as listFiles but with the stat data (size, mtime) of each file,
+     * gathered in the same directory read.
+     */
+    static QFileInfoList listFileInfos(
+        QDir::SortFlags sortBy = (QDir::Time | QDir::Reversed),
+        const QString &filter = QString()
+    );
     static bool fileExists(const QString &fileName);
+    /**
+     * Stat data of a file in the report directory; exists() is false if it is gone
+     */
+    static QFileInfo reportFileInfo(const QString &fileName);
+    static bool loadFile(const QString &fileName, QByteArray &outBytes);
+    /**
+     * Maps the file for reading (see MappedFile)
+     * @return nullptr if the file cannot be opened
+     */
+    static std::shared_ptr<const MappedFile> mapFile(const QString &fileName);
     static bool loadJsonFile(const QString &fileName, QJsonObject &outObj);
-    static bool saveJsonFile(const QString &fileName, const QJsonObject &obj);
+    /**
+     * Writes a file atomically under the same lock as saveJsonFile.
+     * write streams the contents into the device and returns false on error.
+     */
+    static bool saveFile(const QString &fileName, const std::function<bool(QIODevice &)> &write);
+    /**
+     * Appends bytes to a file (creating it) under the same lock as saveFile
+     */
+    static bool appendFile(const QString &fileName, const QByteArray &bytes);
+    static bool saveJsonFile(
+        const QString &fileName, const QJsonObject &obj,
+        QJsonDocument::JsonFormat format = QJsonDocument::Indented
+    );
     static bool deleteFile(const QString &fileName);
     // { "size": qint64, "lastModified": QString (ISO), "isReadable": bool, "isWritable": bool }
     static QVariantMap fileInfo(const QString &fileName);
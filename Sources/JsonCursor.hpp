@@ -0,0 +1,241 @@
+//
+// Created on 17 Oct, 2026
+//  by alecproj
+//
+
+#ifndef SOURCES_JSONCURSOR_HPP_
+#define SOURCES_JSONCURSOR_HPP_
+
+#include <QByteArrayView>
+#include <QString>
+#include <QVariant>
+
+/**
+ * Pull parser over JSON text that is not copied (e.g. a mapped file).
+ * The caller walks the document with enterObject/nextKey and
+ * enterArray/nextElement, reads the scalars it needs and skips the rest.
+ * Skipped values are only bracket-matched, not validated or decoded.
+ * Any error puts the cursor into the failed state, in which every call
+ * returns false.
+ */
+class JsonCursor {
+
+public:
+    explicit JsonCursor(QByteArrayView text, qsizetype pos = 0)
+        : m_text{text}
+        , m_pos{pos}
+        , m_failed{false}
+    {}
+
+    qsizetype pos() const { return m_pos; }
+    bool failed() const { return m_failed; }
+
+    bool enterObject() { return expect('{'); }
+    bool enterArray() { return expect('['); }
+
+    /**
+     * Moves to the next member of the current object and reads its key.
+     * @return false at the end of the object (consumed) or on error
+     */
+    bool nextKey(QByteArrayView *key)
+    {
+        if (!nextItem('}')) return false;
+        if (peek() != '"') return fail();
+        const qsizetype start = ++m_pos;
+        while (m_pos < m_text.size() && m_text[m_pos] != '"') {
+            m_pos += (m_text[m_pos] == '\\') ? 2 : 1;
+        }
+        if (m_pos >= m_text.size()) return fail();
+        *key = m_text.sliced(start, m_pos - start);
+        ++m_pos;
+        return expect(':');
+    }
+
+    /**
+     * Moves to the next element of the current array.
+     * @return false at the end of the array (consumed) or on error
+     */
+    bool nextElement() { return nextItem(']'); }
+
+    /**
+     * Skips the value at the cursor and optionally returns its text
+     */
+    bool skipValue(QByteArrayView *range = nullptr)
+    {
+        const char c = peek();
+        const qsizetype start = m_pos;
+        if (c == '"') {
+            if (!skipString()) return false;
+        } else if (c == '{' || c == '[') {
+            int depth = 0;
+            while (m_pos < m_text.size()) {
+                const char ch = m_text[m_pos];
+                if (ch == '"') {
+                    if (!skipString()) return false;
+                    continue;
+                }
+                ++m_pos;
+                if (ch == '{' || ch == '[') {
+                    ++depth;
+                } else if ((ch == '}' || ch == ']') && --depth == 0) {
+                    break;
+                }
+            }
+            if (depth != 0) return fail();
+        } else {
+            while (m_pos < m_text.size() && !isDelimiter(m_text[m_pos])) ++m_pos;
+            if (m_pos == start) return fail();
+        }
+        if (range) *range = m_text.sliced(start, m_pos - start);
+        return true;
+    }
+
+    /**
+     * Reads a scalar: number -> double, string -> QString, true/false ->
+     * bool, null -> invalid QVariant. Objects and arrays are skipped and
+     * read as invalid QVariant.
+     */
+    bool readValue(QVariant *out)
+    {
+        const char c = peek();
+        if (c == '"') {
+            QString str;
+            if (!readString(&str)) return false;
+            *out = str;
+            return true;
+        }
+        QByteArrayView token;
+        if (!skipValue(&token)) return false;
+        if (c == '{' || c == '[' || token == "null") {
+            *out = QVariant();
+        } else if (token == "true" || token == "false") {
+            *out = (token == "true");
+        } else {
+            bool ok = false;
+            const double d = token.toDouble(&ok); // locale independent
+            if (!ok) return fail();
+            *out = d;
+        }
+        return true;
+    }
+
+    bool readString(QString *out)
+    {
+        QByteArrayView raw;
+        if (peek() != '"' || !skipValue(&raw)) return fail();
+        raw = raw.sliced(1, raw.size() - 2);
+        if (!raw.contains('\\')) {
+            *out = QString::fromUtf8(raw);
+            return true;
+        }
+        return unescape(raw, out) || fail();
+    }
+
+private:
+    QByteArrayView m_text;
+    qsizetype m_pos;
+    bool m_failed;
+
+    static bool isDelimiter(char c)
+    {
+        return c == ',' || c == '}' || c == ']' || c == ' ' || c == '\t' || c == '\r' || c == '\n';
+    }
+
+    bool fail()
+    {
+        m_failed = true;
+        return false;
+    }
+
+    char peek()
+    {
+        while (m_pos < m_text.size()) {
+            const char c = m_text[m_pos];
+            if (c != ' ' && c != '\t' && c != '\r' && c != '\n') return c;
+            ++m_pos;
+        }
+        return '\0';
+    }
+
+    bool expect(char c)
+    {
+        if (m_failed || peek() != c) return fail();
+        ++m_pos;
+        return true;
+    }
+
+    // Skips the separator before an item, stops at the closing bracket
+    bool nextItem(char close)
+    {
+        if (m_failed) return false;
+        char c = peek();
+        if (c == ',') {
+            ++m_pos;
+            c = peek();
+        }
+        if (c == close) {
+            ++m_pos;
+            return false;
+        }
+        return c != '\0' || fail();
+    }
+
+    bool skipString()
+    {
+        ++m_pos; // opening quote
+        while (m_pos < m_text.size()) {
+            const char c = m_text[m_pos];
+            if (c == '\\') {
+                m_pos += 2;
+            } else {
+                ++m_pos;
+                if (c == '"') return true;
+            }
+        }
+        return fail();
+    }
+
+    static bool unescape(QByteArrayView raw, QString *out)
+    {
+        QByteArray utf8;
+        utf8.reserve(raw.size());
+        QString result;
+        for (qsizetype i = 0; i < raw.size(); ++i) {
+            const char c = raw[i];
+            if (c != '\\') {
+                utf8 += c;
+                continue;
+            }
+            if (++i >= raw.size()) return false;
+            switch (raw[i]) {
+            case '"':  utf8 += '"'; break;
+            case '\\': utf8 += '\\'; break;
+            case '/':  utf8 += '/'; break;
+            case 'b':  utf8 += '\b'; break;
+            case 'f':  utf8 += '\f'; break;
+            case 'n':  utf8 += '\n'; break;
+            case 'r':  utf8 += '\r'; break;
+            case 't':  utf8 += '\t'; break;
+            case 'u': {
+                if (i + 4 >= raw.size()) return false;
+                bool ok = false;
+                const char16_t code = char16_t(raw.sliced(i + 1, 4).toUShort(&ok, 16));
+                if (!ok) return false;
+                // Surrogate pairs come as two escapes, so go through UTF-16
+                result += QString::fromUtf8(utf8);
+                utf8.clear();
+                result += QChar(code);
+                i += 4;
+                break;
+            }
+            default:
+                return false;
+            }
+        }
+        result += QString::fromUtf8(utf8);
+        *out = result;
+        return true;
+    }
+};
+
+#endif // SOURCES_JSONCURSOR_HPP_
@@ -1,11 +1,13 @@
 #include "MainController.hpp"
 #include "FileManager.hpp"
 #include "ReportReader.hpp"
+#include "ReportCbor.hpp"
 #include "SolutionModel.hpp"
 #include "ResultData.hpp"
 
 MainController::MainController(QObject *parent)
     : QObject{parent}
+    , m_saver{}
     , m_writer{}
     , m_currAlgorithm{AlgoType::ALL}
     , m_currExtension{ExtensionType::B}
@@ -16,15 +18,62 @@ MainController::MainController(QObject *parent)
     , m_cgAlgo{&m_writer}
     , m_cgData{}
     , m_quickInfoModel{this}
+    , m_reportIndex{}
+    , m_reportWatcher{}
+    , m_rescanTimer{}
+    , m_changedReports{}
+    , m_rescanAll{false}
     , m_openReports{}
     , m_filePendingDeletion{}
+    , m_reportToOpen{}
+    , m_lastSaved{}
     , m_enumHelper{this}
+    , m_progress{}
+    , m_solveThread{nullptr}
+    , m_solveResult{}
+    , m_progressTimer{}
+    , m_progressClock{}
+    , m_lastProgressMs{0}
+    , m_lastFunctionCalls{0}
 {
+    m_writer.setSaver(&m_saver);
+    m_writer.setSpillThreshold(ReportWriter::DEFAULT_SPILL_BYTES);
+    connect(&m_saver, &ReportSaver::reportSaved, this, &MainController::onReportSaved);
+    m_cdAlgo.setProgress(&m_progress);
+    m_gdAlgo.setProgress(&m_progress);
+    m_cgAlgo.setProgress(&m_progress);
+    m_progressTimer.setInterval(PROGRESS_INTERVAL_MS);
+    connect(&m_progressTimer, &QTimer::timeout, this, &MainController::publishProgress);
+
+    m_rescanTimer.setSingleShot(true);
+    m_rescanTimer.setInterval(RESCAN_DELAY_MS);
+    connect(&m_rescanTimer, &QTimer::timeout, this, &MainController::applyReportChanges);
+    connect(&m_reportWatcher, &ReportWatcher::reportsChanged, this, [this](const QStringList &fileNames) {
+        for (const auto &fileName : fileNames) {
+            m_changedReports.insert(fileName);
+        }
+        m_rescanTimer.start();
+    });
+    connect(&m_reportWatcher, &ReportWatcher::directoryChanged, this, [this]() {
+        m_rescanAll = true;
+        m_rescanTimer.start();
+    });
+    watchReportDir();
+}
+
+MainController::~MainController()
+{
+    if (m_solveThread) {
+        m_progress.cancel();
+        m_solveThread->disconnect(this);
+        m_solveThread->wait();
+        delete m_solveThread;
+    }
 }
 
 Status MainController::setInputData(const InputData *data)
 {
-    if (!data) {
+    if (!data || m_solveThread) {
         return Status::Fail;
     }
     m_writer.setInputData(data);
@@ -69,70 +118,171 @@ Status MainController::setInputData(const InputData *data)
 }
 
 Status MainController::solve()
+{
+    if (m_solveThread) {
+        return Status::Fail;
+    }
+    m_progress.reset();
+    m_solveResult = {};
+    m_lastProgressMs = 0;
+    m_lastFunctionCalls = 0;
+
+    m_solveThread = QThread::create([this] { m_solveResult = runSolver(); });
+    connect(m_solveThread, &QThread::finished, this, &MainController::onSolveFinished);
+    m_progressClock.start();
+    m_progressTimer.start();
+    m_solveThread->start();
+    emit solvingChanged();
+    return Status::Success;
+}
+
+MainController::SolveResult MainController::runSolver()
 {
     if (m_currAlgorithm == AlgoType::CD) {
         auto rv = m_cdAlgo.solve();
         qDebug() << "ALGO RESUULT: " << static_cast<int>(rv);
+        if (rv == CD::Result::Cancelled) {
+            return { true, {} };
+        }
         if (rv != CD::Result::Success) {
-            askConfirm(
-                "Ошибка при решении",
-                QString::fromStdString(CD::resultToString(rv))
-            );
-            return Status::Fail;
+            return { false, QString::fromStdString(CD::resultToString(rv)) };
         }
     } else if (m_currAlgorithm == AlgoType::GD) {
         auto rv = m_gdAlgo.solve();
+        if (rv == GD::Result::Cancelled) {
+            return { true, {} };
+        }
         if (rv != GD::Result::Success) {
-            askConfirm(
-                "Ошибка при решении",
-                QString::fromStdString(GD::resultToString(rv))
-            );
-            return Status::Fail;
+            return { false, QString::fromStdString(GD::resultToString(rv)) };
         }
     } else if (m_currAlgorithm == AlgoType::CG) {
         auto rv = m_cgAlgo.solve();
+        if (rv == CG::Result::Cancelled) {
+            return { true, {} };
+        }
         if (rv != CG::Result::Success) {
-            askConfirm(
-                "Ошибка при решении",
-                QString::fromStdString(CG::resultToString(rv))
-            );
-            return Status::Fail;
+            return { false, QString::fromStdString(CG::resultToString(rv)) };
         }
     } else {
-        askConfirm("Ошибка при решении", "Алгоритм не поддерживается");
-        return Status::Fail;
+        return { false, "Алгоритм не поддерживается" };
     }
-    openReport(m_writer.fileName());
-    return Status::Success;
+    return {};
+}
+
+void MainController::onSolveFinished()
+{
+    m_progressTimer.stop();
+    publishProgress();
+    m_solveThread->deleteLater();
+    m_solveThread = nullptr;
+    emit solvingChanged();
+
+    Status status = Status::Success;
+    if (m_solveResult.cancelled) {
+        askConfirm("Уведомление", "Решение отменено");
+        status = Status::Fail;
+    } else if (!m_solveResult.error.isEmpty()) {
+        askConfirm("Ошибка при решении", m_solveResult.error);
+        status = Status::Fail;
+    } else if (m_lastSaved == m_writer.fileName()) {
+        openReport(m_lastSaved);
+    } else {
+        // The report is still in the queue of m_saver
+        m_reportToOpen = m_writer.fileName();
+    }
+    emit pendingReportsChanged();
+    emit solveFinished(status);
+}
+
+void MainController::onReportSaved(const QString &fileName, bool ok)
+{
+    emit pendingReportsChanged();
+    emit reportSaved(fileName, ok);
+    if (ok) {
+        m_lastSaved = fileName;
+    }
+    const bool open = (fileName == m_reportToOpen);
+    if (open) {
+        m_reportToOpen.clear();
+    }
+    if (!ok) {
+        askConfirm("Ошибка сохранения отчета", "Не удалось записать файл " + fileName);
+    } else if (open) {
+        openReport(fileName);
+    }
+}
+
+void MainController::publishProgress()
+{
+    const auto progress = m_progress.snapshot();
+    const qint64 now = m_progressClock.elapsed();
+    const qint64 elapsed = now - m_lastProgressMs;
+    const double evalsPerSecond = (elapsed > 0)
+        ? (progress.functionCalls - m_lastFunctionCalls) * 1000.0 / elapsed
+        : 0.0;
+    m_lastProgressMs = now;
+    m_lastFunctionCalls = progress.functionCalls;
+    emit solveProgress(progress.iteration, progress.bestValue, evalsPerSecond);
 }
 
 void MainController::updateQuickInfoModel()
 {
-    bool updates = false;
-    QStringList files = FileManager::listFiles();
-    for (const auto file : files) {
-        if (!m_quickInfoModel.exists(file)) {
-            auto info = new QuickInfo(&m_quickInfoModel);
-            auto rv = ReportReader::quickInfo(file, info);
-            if (rv == ReportStatus::Ok) {
-                m_quickInfoModel.prepend(info);
-                updates = true;
-            } else {
-                delete info;
-            }
+    m_reportIndex.refresh();
+    const auto entries = m_reportIndex.listedEntries();
+    QuickInfoListModel::ObjectList infos;
+    infos.reserve(entries.count());
+    for (auto it = entries.crbegin(); it != entries.crend(); ++it) {
+        infos.append(makeQuickInfo(*it, &m_quickInfoModel));
+    }
+    m_quickInfoModel.setEntries(infos);
+    emit quickInfoModelChanged();
+}
+
+void MainController::applyReportChanges()
+{
+    watchReportDir();
+    const auto changes = m_rescanAll ? m_reportIndex.refresh()
+                                     : m_reportIndex.refresh(m_changedReports.values());
+    m_rescanAll = false;
+    m_changedReports.clear();
+    if (changes.isEmpty()) {
+        return;
+    }
+    for (const auto &fileName : changes.removed) {
+        m_quickInfoModel.deleteEntry(fileName);
+    }
+    for (const auto &entry : changes.upserted) {
+        if (!m_quickInfoModel.updateEntry(entry.fileName, entry.summary.info, entry.summary.status)) {
+            m_quickInfoModel.prepend(makeQuickInfo(entry, &m_quickInfoModel));
         }
     }
-    if (updates) {
-        emit quickInfoModelChanged();
+    emit quickInfoModelChanged();
+}
+
+void MainController::watchReportDir()
+{
+    // The watch is lost if the directory is removed, so it is renewed on every rescan
+    QString dir;
+    if (FileManager::ensureBaseDirExists(dir) && !m_reportWatcher.watch(dir)) {
+        qWarning() << "MainController: cannot watch report directory" << dir;
     }
 }
 
+QuickInfo *MainController::makeQuickInfo(const ReportIndex::Entry &entry, QObject *parent)
+{
+    auto info = new QuickInfo(parent);
+    info->setName(entry.fileName);
+    info->setInfo(entry.summary.info);
+    info->setStatus(entry.summary.status);
+    return info;
+}
+
 Status MainController::openReport(const QString &fileName)
 {
     auto input = new InputData();
     auto model = new SolutionModel();
     auto result = new ResultData();
-    QJsonArray solution;
+    ReportSolution solution;
     auto rv = ReportReader::reportData(fileName, input, solution, result);
     switch (rv) {
         case ReportStatus::NoResult:
@@ -168,8 +318,11 @@ void MainController::closeReport(const QString &fileName)
     const size_t reportsCnt = m_openReports.count();
     for (size_t i = 0; i < reportsCnt; ++i) {
         if (m_openReports[i]->fileName() == fileName) {
+            // The report keeps its file mapped until it is deleted
+            Report *report = m_openReports[i];
             m_openReports.remove(i, 1);
             emit openReportsUpdated();
+            report->deleteLater();
             return;
         }
     }
@@ -187,8 +340,80 @@ void MainController::deleteConfirmed()
 {
     closeReport(m_filePendingDeletion);
     m_quickInfoModel.deleteEntry(m_filePendingDeletion);
-    FileManager::deleteFile(m_filePendingDeletion);
-    askConfirm("Уведомление", "Файл " + m_filePendingDeletion + " успешно удалён");
+    // Queued after the deletion of the closed report, which unmaps the file
+    // (a mapped file cannot be deleted on Windows)
+    QMetaObject::invokeMethod(this, [this, fileName = m_filePendingDeletion]() {
+        FileManager::deleteFile(fileName);
+        m_reportIndex.remove(fileName);
+        m_reportIndex.save();
+        askConfirm("Уведомление", "Файл " + fileName + " успешно удалён");
+    }, Qt::QueuedConnection);
+}
+
+Status MainController::convertReport(const QString &fileName)
+{
+    const bool toCbor = fileName.endsWith(QLatin1String(".json"));
+    const QString target = fileName.left(fileName.lastIndexOf('.'))
+        + (toCbor ? QLatin1String(".cbor") : QLatin1String(".json"));
+    if (FileManager::fileExists(target)) {
+        askConfirm("Ошибка конвертации", "Файл " + target + " уже существует");
+        return Status::Fail;
+    }
+    QByteArray bytes;
+    if (!FileManager::loadFile(fileName, bytes)) {
+        askConfirm("Ошибка конвертации", "Не удалось прочитать файл " + fileName);
+        return Status::Fail;
+    }
+
+    bool saved = false;
+    if (toCbor) {
+        const QJsonObject report = QJsonDocument::fromJson(bytes).object();
+        const QByteArray cbor = ReportCbor::fromJson(report);
+        saved = !report.isEmpty() && FileManager::saveFile(target, [&](QIODevice &device) {
+            return device.write(cbor) == cbor.size();
+        });
+    } else {
+        QJsonObject report;
+        saved = ReportCbor::toJson(bytes, &report) && ReportWriter::saveJson(target, report);
+    }
+    if (!saved) {
+        askConfirm("Ошибка конвертации", "Не удалось записать файл " + target);
+        return Status::Fail;
+    }
+    return Status::Success;
+}
+
+void MainController::setReportFormat(int format)
+{
+    // The writer is in use by the solver thread
+    if (m_solveThread || format == m_writer.format()) {
+        return;
+    }
+    m_writer.setFormat(static_cast<ReportFormat::Type>(format));
+    emit reportFormatChanged();
+}
+
+void MainController::setRowPolicy(int policy)
+{
+    if (m_solveThread || policy == rowPolicy()
+        || policy < RowPolicy::ALL || policy > RowPolicy::FIRST_LAST) {
+        return;
+    }
+    auto sampling = m_writer.rowSampling();
+    sampling.policy = static_cast<SC::RowPolicy>(policy);
+    m_writer.setRowSampling(sampling);
+    emit rowSamplingChanged();
+}
+
+void MainController::setRowPolicyParameter(int parameter)
+{
+    if (m_solveThread || parameter < 1 || parameter == rowPolicyParameter()) {
+        return;
+    }
+    auto sampling = m_writer.rowSampling();
+    sampling.parameter = parameter;
+    m_writer.setRowSampling(sampling);
+    emit rowSamplingChanged();
 }
 
 Status MainController::inputDataFromFile(const QString &fileName, InputData *out)
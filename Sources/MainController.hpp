@@ -10,12 +10,20 @@
 #include "ReportWriter.hpp"
 #include "Report.hpp"
 #include "QuickInfoListModel.hpp"
+#include "ReportIndex.hpp"
+#include "ReportSaver.hpp"
+#include "ReportWatcher.hpp"
 
 #include <CoordinateDescent/CoordinateDescent.hpp>
 #include <GradientDescent/GradientDescent.hpp>
 #include <ConjugateGradient/ConjugateGradient.hpp>
+#include <SolverCore/Progress.hpp>
 
+#include <QElapsedTimer>
 #include <QObject>
+#include <QSet>
+#include <QThread>
+#include <QTimer>
 
 using Status = Result::Type;
 using CDAlgoType = CD::CoordinateDescent<ReportWriter>;
@@ -28,17 +36,55 @@ class MainController : public QObject {
     Q_PROPERTY(QuickInfoListModel *quickInfoModel READ quickInfoModel NOTIFY quickInfoModelChanged)
     Q_PROPERTY(QList<Report *> openReports READ openReports NOTIFY openReportsUpdated)
     Q_PROPERTY(int openReportsCount READ openReportsCount NOTIFY openReportsUpdated)
+    Q_PROPERTY(bool solving READ solving NOTIFY solvingChanged)
+    Q_PROPERTY(int reportFormat READ reportFormat WRITE setReportFormat NOTIFY reportFormatChanged)
+    Q_PROPERTY(int pendingReports READ pendingReports NOTIFY pendingReportsChanged)
+    Q_PROPERTY(int rowPolicy READ rowPolicy WRITE setRowPolicy NOTIFY rowSamplingChanged)
+    Q_PROPERTY(int rowPolicyParameter READ rowPolicyParameter WRITE setRowPolicyParameter NOTIFY rowSamplingChanged)
 public:
 
     explicit MainController(QObject *parent = nullptr);
+    ~MainController() override;
 
     Q_INVOKABLE Status setInputData(const InputData *data);
+    /**
+     * Starts the solver on a worker thread and returns immediately.
+     * Progress is reported with solveProgress, the end with solveFinished.
+     * @return Fail if a solve is already running
+     */
     Q_INVOKABLE Status solve();
+    /**
+     * Asks the running solver to stop after the current iteration
+     */
+    Q_INVOKABLE void cancelSolve() { m_progress.cancel(); }
+    bool solving() const { return m_solveThread != nullptr; }
+    /**
+     * Number of finished reports that are not on disk yet
+     */
+    int pendingReports() const { return m_saver.pending(); }
+    /**
+     * Rebuilds the report list from the report index. Later changes in the
+     * report directory are picked up by the watcher, see applyReportChanges.
+     */
     Q_INVOKABLE void updateQuickInfoModel();
     Q_INVOKABLE Status inputDataFromFile(const QString &fileName, InputData *out);
     Q_INVOKABLE Status openReport(const QString &fileName);
     Q_INVOKABLE void closeReport(const QString &fileName);
     Q_INVOKABLE void requestDeleteReport(const QString &fileName);
+    /**
+     * Writes a copy of a report in the other format (JSON <-> CBOR)
+     * next to it
+     */
+    Q_INVOKABLE Status convertReport(const QString &fileName);
+    int reportFormat() const { return m_writer.format(); }
+    void setReportFormat(int format);
+    /**
+     * Which iteration rows go to the report (RowPolicy) and its N
+     */
+    int rowPolicy() const { return static_cast<int>(m_writer.rowSampling().policy); }
+    void setRowPolicy(int policy);
+    int rowPolicyParameter() const { return static_cast<int>(m_writer.rowSampling().parameter); }
+    void setRowPolicyParameter(int parameter);
     Q_INVOKABLE int openReportsCount() { return m_openReports.count(); }
     QList<Report *> &openReports() { return m_openReports; }
     Q_INVOKABLE void askConfirm(const QString &title, const QString &text, bool twoButtons = false) {
@@ -51,11 +97,42 @@ signals:
     void quickInfoModelChanged();
     void openReportsUpdated();
     void requestConfirm(const QString &title, const QString &text, bool twoButtons);
+    void solvingChanged();
+    void reportFormatChanged();
+    void rowSamplingChanged();
+    void solveProgress(int iteration, double bestValue, double evalsPerSecond);
+    void solveFinished(Status status);
+    void pendingReportsChanged();
+    /**
+     * The report file is on disk (ok == true) or could not be written
+     */
+    void reportSaved(const QString &fileName, bool ok);
 
 public slots:
     void deleteConfirmed();
 
+private slots:
+    void onSolveFinished();
+    void onReportSaved(const QString &fileName, bool ok);
+    void publishProgress();
+    /**
+     * Applies added, rewritten and deleted reports to the report list
+     */
+    void applyReportChanges();
+
 private:
+    /**
+     * Outcome of runSolver(), taken from the result code of the solver
+     */
+    struct SolveResult {
+        bool cancelled = false; // Result::Cancelled
+        QString error;          // message of any other failure, empty on success
+    };
+
+    static constexpr int PROGRESS_INTERVAL_MS = 100; // solveProgress is emitted at most this often
+    static constexpr int RESCAN_DELAY_MS = 200; // directory events within this time are applied at once
+
+    ReportSaver m_saver;
     ReportWriter m_writer;
     AlgoType::Type m_currAlgorithm;
     ExtensionType::Type m_currExtension;
@@ -64,12 +141,33 @@ private:
     GDAlgoType m_gdAlgo;
     GD::InputData m_gdData;
     QuickInfoListModel m_quickInfoModel;
+    ReportIndex m_reportIndex;
+    ReportWatcher m_reportWatcher;
+    QTimer m_rescanTimer;
+    QSet<QString> m_changedReports; // named by the watcher since the last rescan
+    bool m_rescanAll;               // the watcher could not name the changes
     CGAlgoType m_cgAlgo;
     CG::InputData m_cgData;
     QList<Report *> m_openReports;
     QString m_filePendingDeletion;
+    QString m_reportToOpen; // opened as soon as it is saved
+    QString m_lastSaved;    // may be saved before the end of the solve is seen
     EnumHelper m_enumHelper;
+    SC::Progress m_progress;
+    QThread *m_solveThread;
+    SolveResult m_solveResult; // written by the solver thread
+    QTimer m_progressTimer;
+    QElapsedTimer m_progressClock;
+    qint64 m_lastProgressMs;
+    int m_lastFunctionCalls;
 
+    /**
+     * Runs the selected solver. Called on the solver thread.
+     * @return whether the solve was cancelled and the error message, if any
+     */
+    SolveResult runSolver();
+    void watchReportDir();
+    static QuickInfo *makeQuickInfo(const ReportIndex::Entry &entry, QObject *parent);
     void fillCDData(const InputData *data);
     void fillGDData(const InputData *data);
     void fillCGData(const InputData *data);
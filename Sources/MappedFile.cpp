@@ -0,0 +1,43 @@
+//
+// Created on 17 Oct, 2026
+//  by alecproj
+//
+
+#include "MappedFile.hpp"
+
+#include <QDebug>
+
+MappedFile::MappedFile(const QString &path)
+    : m_file{path}
+    , m_map{nullptr}
+    , m_fallback{}
+    , m_bytes{}
+{
+}
+
+MappedFile::~MappedFile()
+{
+    if (m_map) {
+        m_file.unmap(m_map);
+    }
+}
+
+std::shared_ptr<const MappedFile> MappedFile::open(const QString &path)
+{
+    std::shared_ptr<MappedFile> file(new MappedFile(path));
+    if (!file->m_file.open(QIODevice::ReadOnly)) {
+        qWarning() << "MappedFile: cannot open file for reading:" << path;
+        return nullptr;
+    }
+    const qint64 size = file->m_file.size();
+    if (size > 0) {
+        file->m_map = file->m_file.map(0, size);
+    }
+    if (file->m_map) {
+        file->m_bytes = QByteArrayView(file->m_map, size);
+    } else {
+        file->m_fallback = file->m_file.readAll();
+        file->m_bytes = file->m_fallback;
+    }
+    return file;
+}
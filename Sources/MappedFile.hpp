@@ -0,0 +1,42 @@
+//
+// Created on 17 Oct, 2026
+//  by alecproj
+//
+
+#ifndef SOURCES_MAPPEDFILE_HPP_
+#define SOURCES_MAPPEDFILE_HPP_
+
+#include <QByteArray>
+#include <QByteArrayView>
+#include <QFile>
+#include <QString>
+
+#include <memory>
+
+/**
+ * Read-only view of a whole file. The file is memory-mapped, so only the
+ * pages that are actually read are loaded, and they can be dropped by the
+ * OS at any time. Falls back to reading the file if it cannot be mapped.
+ * Shared by everything that keeps pointers into the file (see DeferredRows).
+ */
+class MappedFile {
+
+public:
+    static std::shared_ptr<const MappedFile> open(const QString &path);
+
+    ~MappedFile();
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    QByteArrayView bytes() const { return m_bytes; }
+
+private:
+    explicit MappedFile(const QString &path);
+
+    QFile m_file;
+    uchar *m_map;
+    QByteArray m_fallback; // contents when the file could not be mapped
+    QByteArrayView m_bytes;
+};
+
+#endif // SOURCES_MAPPEDFILE_HPP_
@@ -20,7 +20,7 @@ QVariant QuickInfoListModel::data(const QModelIndex &index, int role) const
     if (!index.isValid())
         return QVariant();
 
-    const auto &obj = m_data.at(index.row());
+    const auto &obj = m_data.at(rowOf(index.row()));
     switch (role) {
         case NameRole: return obj->name();
         case InfoRole: return obj->info();
@@ -38,25 +38,55 @@ QHash<int, QByteArray> QuickInfoListModel::roleNames() const
     return roles;
 }
 
-bool QuickInfoListModel::exists(const QString &fileName) const
+void QuickInfoListModel::setEntries(const ObjectList &entries)
 {
-    for (const auto entry : m_data) {
-        if (QString::compare(entry->name(), fileName) == 0) {
-            return true;
-        }
+    beginResetModel();
+    for (auto entry : std::as_const(m_data)) {
+        entry->deleteLater();
     }
-    return false;
+    m_data.clear();
+    m_data.reserve(entries.count());
+    for (auto it = entries.crbegin(); it != entries.crend(); ++it) {
+        m_data.append(*it);
+    }
+    m_position.clear();
+    m_position.reserve(m_data.count());
+    for (int i = 0; i < m_data.count(); ++i) {
+        m_position.insert(m_data.at(i)->name(), i);
+    }
+    endResetModel();
+}
+
+bool QuickInfoListModel::updateEntry(const QString &fileName, const QString &info, int status)
+{
+    const auto it = m_position.constFind(fileName);
+    if (it == m_position.cend()) {
+        return false;
+    }
+    QuickInfo *entry = m_data.at(it.value());
+    entry->setInfo(info);
+    entry->setStatus(status);
+    const QModelIndex idx = index(rowOf(it.value()));
+    emit dataChanged(idx, idx, {InfoRole, StatusRole});
+    return true;
 }
 
 void QuickInfoListModel::deleteEntry(const QString &fileName)
 {
-    const int len = m_data.count();
-    for (int i = 0; i < len; ++i) {
-        if (QString::compare(m_data[i]->name(), fileName) == 0) {
-            beginRemoveRows(QModelIndex(), i, i);
-            m_data.remove(i);
-            endRemoveRows();
-            return;
-        }
+    const auto it = m_position.constFind(fileName);
+    if (it == m_position.cend()) {
+        return;
+    }
+    const int position = it.value();
+    m_position.erase(it);
+    QuickInfo *entry = m_data.at(position);
+    const int row = rowOf(position);
+    beginRemoveRows(QModelIndex(), row, row);
+    m_data.remove(position);
+    // Only the newer entries move; deleting a recent report is cheap
+    for (int i = position; i < m_data.count(); ++i) {
+        m_position[m_data.at(i)->name()] = i;
     }
+    endRemoveRows();
+    entry->deleteLater();
 }
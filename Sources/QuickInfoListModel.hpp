@@ -19,6 +19,7 @@ public:
     explicit QuickInfoListModel(QObject *parent = nullptr)
         : QAbstractListModel{parent}
         , m_data{}
+        , m_position{}
     {
     }
 
@@ -33,18 +34,38 @@ public:
     QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
     RoleNames roleNames() const override;
 
-    bool exists(const QString &fileName) const;
-    void prepend(QuickInfo *entry) 
+    bool exists(const QString &fileName) const { return m_position.contains(fileName); }
+    QuickInfo *find(const QString &fileName) const
+    {
+        const auto it = m_position.constFind(fileName);
+        return (it != m_position.cend()) ? m_data.at(it.value()) : nullptr;
+    }
+    void prepend(QuickInfo *entry)
     {
         beginInsertRows(QModelIndex(), 0, 0);
-        m_data.prepend(entry);
+        m_position.insert(entry->name(), m_data.count());
+        m_data.append(entry);
         endInsertRows();
     }
+    /**
+     * Replaces all entries with the given ones, newest first
+     */
+    void setEntries(const ObjectList &entries);
+    /**
+     * Updates the info and the status of an existing entry
+     * @return false if there is no entry with this name
+     */
+    bool updateEntry(const QString &fileName, const QString &info, int status);
     void deleteEntry(const QString &fileName);
     int count() const { return m_data.count(); }
 
 private:
+    // Oldest first, so that prepending a new report does not move the others:
+    // row r of the model is m_data[count() - 1 - r]
     QList<QuickInfo *> m_data;
+    QHash<QString, int> m_position; // file name -> index in m_data
+
+    int rowOf(int position) const { return m_data.count() - 1 - position; }
 
 };
 
@@ -0,0 +1,468 @@
+//
+// Created on 17 Oct, 2026
+//  by alecproj
+//
+
+#include "ReportCbor.hpp"
+#include "Checksum.hpp"
+
+#include <QCborArray>
+#include <QCborStreamReader>
+#include <QCborValue>
+#include <QJsonArray>
+#include <QtEndian>
+
+#include <cmath>
+#include <limits>
+
+// tag 55799 (self-described CBOR), map of 2, text "data"
+static constexpr char HEADER[] = "\xD9\xD9\xF7\xA2\x64" "data";
+static constexpr qsizetype HEADER_LEN = sizeof(HEADER) - 1;
+// text "checksum", byte string of 4
+static constexpr char TRAILER[] = "\x68" "checksum" "\x44";
+static constexpr qsizetype TRAILER_LEN = sizeof(TRAILER) - 1 + 4;
+
+bool ReportCbor::isCbor(QByteArrayView bytes)
+{
+    return bytes.startsWith(QByteArrayView(HEADER, 3));
+}
+
+bool ReportCbor::dataSection(QByteArrayView bytes, QByteArrayView *outData, uint32_t *outChecksum)
+{
+    if (bytes.size() < HEADER_LEN + TRAILER_LEN || !bytes.startsWith(QByteArrayView(HEADER, HEADER_LEN))) {
+        return false;
+    }
+    const QByteArrayView trailer = bytes.last(TRAILER_LEN);
+    if (!trailer.startsWith(QByteArrayView(TRAILER, TRAILER_LEN - 4))) {
+        return false;
+    }
+    if (outData) {
+        *outData = bytes.sliced(HEADER_LEN, bytes.size() - HEADER_LEN - TRAILER_LEN);
+    }
+    if (outChecksum) {
+        *outChecksum = qFromBigEndian<quint32>(trailer.data() + TRAILER_LEN - 4);
+    }
+    return true;
+}
+
+QByteArray ReportCbor::header()
+{
+    return QByteArray(HEADER, HEADER_LEN);
+}
+
+QByteArray ReportCbor::trailer(quint32 checksum)
+{
+    QByteArray out(TRAILER, TRAILER_LEN);
+    qToBigEndian<quint32>(checksum, out.data() + TRAILER_LEN - 4);
+    return out;
+}
+
+QByteArray ReportCbor::wrap(const QByteArray &data)
+{
+    return header() + data + trailer(Crc32::compute(data.constData(), static_cast<std::size_t>(data.size())));
+}
+
+bool ReportCbor::toJson(QByteArrayView bytes, QJsonObject *out)
+{
+    QByteArrayView data;
+    uint32_t checksum = 0;
+    if (!out || !dataSection(bytes, &data, &checksum)) {
+        return false;
+    }
+    QCborParserError err;
+    const QCborValue value = QCborValue::fromCbor(
+        reinterpret_cast<const quint8 *>(data.data()), data.size(), &err);
+    if (err.error != QCborError::NoError || !value.isMap()) {
+        return false;
+    }
+
+    const QCborMap dataMap = value.toMap();
+    QJsonObject dataObj;
+    for (auto it = dataMap.constBegin(); it != dataMap.constEnd(); ++it) {
+        const QString key = it.key().toString();
+        if (key != QLatin1String("solution")) {
+            dataObj.insert(key, it.value().toJsonValue());
+            continue;
+        }
+        QJsonArray solution;
+        for (const QCborValue &item : it.value().toArray()) {
+            const QCborMap itemMap = item.toMap();
+            if (itemMap.value(QLatin1String("type")).toString() == QLatin1String("table")) {
+                solution.append(tableToJson(itemMap));
+            } else {
+                solution.append(item.toJsonValue());
+            }
+        }
+        dataObj.insert(key, solution);
+    }
+
+    QJsonObject report;
+    report.insert("data", dataObj);
+    report.insert("checksum", QString("0x%1").arg(checksum, 8, 16, QLatin1Char('0')).toUpper());
+    *out = report;
+    return true;
+}
+
+static bool readText(QCborStreamReader &reader, QString *out)
+{
+    if (!reader.isString()) {
+        return false;
+    }
+    out->clear();
+    auto chunk = reader.readString();
+    while (chunk.status == QCborStreamReader::Ok) {
+        out->append(chunk.data);
+        chunk = reader.readString();
+    }
+    return chunk.status == QCborStreamReader::EndOfString;
+}
+
+bool ReportCbor::read(const std::shared_ptr<const MappedFile> &file, QJsonObject *out,
+                      qsizetype *outSolutionCount, QList<std::shared_ptr<const CborTable>> *outTables)
+{
+    QByteArrayView data;
+    uint32_t checksum = 0;
+    if (!file || !out || !dataSection(file->bytes(), &data, &checksum)) {
+        return false;
+    }
+    QCborStreamReader reader(data.data(), data.size());
+    if (!reader.isMap() || !reader.enterContainer()) {
+        return false;
+    }
+
+    QJsonObject dataObj;
+    qsizetype count = 0;
+    QString key;
+    while (reader.lastError() == QCborError::NoError && reader.hasNext()) {
+        if (!readText(reader, &key)) {
+            return false;
+        }
+        if (key != QLatin1String("solution")) {
+            dataObj.insert(key, QCborValue::fromCbor(reader).toJsonValue());
+            continue;
+        }
+        if (!reader.isArray()) {
+            return false;
+        }
+        QJsonArray solution;
+        if (!outTables && reader.isLengthKnown()) {
+            // Only the number of items is needed, the cells are not even looked at
+            count = static_cast<qsizetype>(reader.length());
+            reader.next();
+        } else if (reader.enterContainer()) {
+            while (reader.lastError() == QCborError::NoError && reader.hasNext()) {
+                ++count;
+                if (!outTables) {
+                    reader.next();
+                    continue;
+                }
+                QJsonValue item;
+                std::shared_ptr<const CborTable> table;
+                if (!readSolutionItem(reader, data, file, &item, &table)) {
+                    return false;
+                }
+                solution.append(item);
+                outTables->append(std::move(table));
+            }
+            reader.leaveContainer();
+        }
+        dataObj.insert(key, solution);
+    }
+    if (reader.lastError() != QCborError::NoError) {
+        return false;
+    }
+
+    QJsonObject report;
+    report.insert("data", dataObj);
+    report.insert("checksum", QString("0x%1").arg(checksum, 8, 16, QLatin1Char('0')).toUpper());
+    *out = report;
+    *outSolutionCount = count;
+    return true;
+}
+
+bool ReportCbor::readSolutionItem(QCborStreamReader &reader, QByteArrayView data,
+                                  const std::shared_ptr<const MappedFile> &file,
+                                  QJsonValue *outItem, std::shared_ptr<const CborTable> *outTable)
+{
+    if (!reader.isMap()) {
+        *outItem = QCborValue::fromCbor(reader).toJsonValue();
+        return reader.lastError() == QCborError::NoError;
+    }
+    if (!reader.enterContainer()) {
+        return false;
+    }
+    QJsonObject item;
+    std::vector<CborTable::Column> columns;
+    bool hasCells = false;
+    QString key;
+    while (reader.lastError() == QCborError::NoError && reader.hasNext()) {
+        if (!readText(reader, &key)) {
+            return false;
+        }
+        if (key == QLatin1String("cells")) {
+            if (!readCells(reader, data, &columns)) {
+                return false;
+            }
+            hasCells = true;
+        } else {
+            item.insert(key, QCborValue::fromCbor(reader).toJsonValue());
+        }
+    }
+    if (!reader.leaveContainer()) {
+        return false;
+    }
+    if (hasCells) {
+        const int rowCount = item.take("rowCount").toInt();
+        *outTable = std::make_shared<const CborTable>(file, rowCount, std::move(columns));
+    }
+    *outItem = item;
+    return true;
+}
+
+bool ReportCbor::readCells(QCborStreamReader &reader, QByteArrayView data,
+                           std::vector<CborTable::Column> *outColumns)
+{
+    if (!reader.isArray() || !reader.enterContainer()) {
+        return false;
+    }
+    while (reader.lastError() == QCborError::NoError && reader.hasNext()) {
+        CborTable::Column column;
+        const qint64 begin = reader.currentOffset();
+        if (reader.isTag() && reader.toTag() == QCborTag(TYPED_FLOAT64_LE)) {
+            reader.next();
+            if (!reader.isByteArray()) {
+                return false;
+            }
+            if (reader.isLengthKnown()) {
+                // The values are the last bytes of a definite-length string
+                const qint64 length = static_cast<qint64>(reader.length());
+                reader.next();
+                const qint64 end = reader.currentOffset();
+                if (end - length < begin || end > data.size()) {
+                    return false;
+                }
+                column.packed = data.sliced(end - length, length);
+            } else {
+                auto chunk = reader.readByteArray();
+                while (chunk.status == QCborStreamReader::Ok) {
+                    column.copy.append(chunk.data);
+                    chunk = reader.readByteArray();
+                }
+                if (chunk.status != QCborStreamReader::EndOfString) {
+                    return false;
+                }
+            }
+        } else {
+            reader.next();
+            column.encoded = data.sliced(begin, reader.currentOffset() - begin);
+        }
+        outColumns->push_back(std::move(column));
+    }
+    return reader.leaveContainer();
+}
+
+QByteArray ReportCbor::fromJson(const QJsonObject &report)
+{
+    const QJsonObject dataObj = report.value("data").toObject();
+    QByteArray data = mapHead(dataObj.size());
+    for (auto it = dataObj.constBegin(); it != dataObj.constEnd(); ++it) {
+        data += encodeJson(it.key());
+        if (it.key() != QLatin1String("solution")) {
+            data += encodeJson(it.value());
+            continue;
+        }
+        const QJsonArray solution = it.value().toArray();
+        data += arrayHead(solution.size());
+        for (const QJsonValue &item : solution) {
+            const QJsonObject obj = item.toObject();
+            if (obj.value("type").toString() != QLatin1String("table")) {
+                data += encodeJson(item);
+                continue;
+            }
+            const QJsonArray rows = obj.value("rows").toArray();
+            const qsizetype columns = obj.value("columns").toArray().size();
+            data += tableHead(obj, rows.size());
+            for (qsizetype c = 0; c < columns; ++c) {
+                std::vector<double> numbers;
+                numbers.reserve(rows.size());
+                bool numeric = true;
+                for (const QJsonValue &row : rows) {
+                    const QJsonValue cell = row.toArray().at(c);
+                    if (cell.isDouble()) {
+                        numbers.push_back(cell.toDouble());
+                    } else if (cell.isNull() || cell.isUndefined()) {
+                        numbers.push_back(std::numeric_limits<double>::quiet_NaN());
+                    } else {
+                        numeric = false;
+                        break;
+                    }
+                }
+                if (numeric) {
+                    data += packedHead(rows.size());
+                    appendPacked(data, numbers.data(), static_cast<qsizetype>(numbers.size()));
+                } else {
+                    data += arrayHead(rows.size());
+                    for (const QJsonValue &row : rows) {
+                        data += encodeJson(row.toArray().at(c));
+                    }
+                }
+            }
+        }
+    }
+    return wrap(data);
+}
+
+void ReportCbor::appendJson(QCborStreamWriter &writer, const QJsonValue &value)
+{
+    switch (value.type()) {
+    case QJsonValue::Bool:
+        writer.append(value.toBool());
+        break;
+    case QJsonValue::Double: {
+        // Integers stay integers, as they were in the JSON report
+        const QVariant v = value.toVariant();
+        if (v.typeId() == QMetaType::LongLong) writer.append(v.toLongLong());
+        else writer.append(value.toDouble());
+        break;
+    }
+    case QJsonValue::String:
+        writer.append(value.toString());
+        break;
+    case QJsonValue::Array: {
+        const QJsonArray arr = value.toArray();
+        writer.startArray(arr.size());
+        for (const QJsonValue &v : arr) appendJson(writer, v);
+        writer.endArray();
+        break;
+    }
+    case QJsonValue::Object: {
+        const QJsonObject obj = value.toObject();
+        writer.startMap(obj.size());
+        for (auto it = obj.constBegin(); it != obj.constEnd(); ++it) {
+            writer.append(it.key());
+            appendJson(writer, it.value());
+        }
+        writer.endMap();
+        break;
+    }
+    default:
+        writer.appendNull();
+    }
+}
+
+QByteArray ReportCbor::head(quint8 majorType, quint64 value)
+{
+    const char major = char(majorType << 5);
+    char bytes[9];
+    if (value < 24) {
+        return QByteArray(1, char(major | char(value)));
+    }
+    qsizetype size = 0;
+    if (value <= 0xFF) {
+        bytes[0] = char(major | 24);
+        bytes[1] = char(value);
+        size = 2;
+    } else if (value <= 0xFFFF) {
+        bytes[0] = char(major | 25);
+        qToBigEndian<quint16>(quint16(value), bytes + 1);
+        size = 3;
+    } else if (value <= 0xFFFFFFFF) {
+        bytes[0] = char(major | 26);
+        qToBigEndian<quint32>(quint32(value), bytes + 1);
+        size = 5;
+    } else {
+        bytes[0] = char(major | 27);
+        qToBigEndian<quint64>(value, bytes + 1);
+        size = 9;
+    }
+    return QByteArray(bytes, size);
+}
+
+QByteArray ReportCbor::mapHead(quint64 size)
+{
+    return head(5, size);
+}
+
+QByteArray ReportCbor::arrayHead(quint64 size)
+{
+    return head(4, size);
+}
+
+QByteArray ReportCbor::encodeJson(const QJsonValue &value)
+{
+    // A writer overwrites a byte array that is not empty, so each piece
+    // gets its own
+    QByteArray out;
+    QCborStreamWriter writer(&out);
+    appendJson(writer, value);
+    return out;
+}
+
+QByteArray ReportCbor::tableHead(const QJsonObject &table, qsizetype rowCount)
+{
+    const QJsonArray columns = table.value("columns").toArray();
+    return mapHead(5)
+        + encodeJson(QStringLiteral("type")) + encodeJson(QStringLiteral("table"))
+        + encodeJson(QStringLiteral("title")) + encodeJson(table.value("title").toString())
+        + encodeJson(QStringLiteral("columns")) + encodeJson(columns)
+        + encodeJson(QStringLiteral("rowCount")) + encodeJson(static_cast<qint64>(rowCount))
+        + encodeJson(QStringLiteral("cells")) + arrayHead(columns.size());
+}
+
+QByteArray ReportCbor::packedHead(qsizetype count)
+{
+    return head(6, TYPED_FLOAT64_LE) + head(2, quint64(count) * sizeof(double));
+}
+
+void ReportCbor::appendPacked(QByteArray &out, const double *values, qsizetype count)
+{
+    const qsizetype at = out.size();
+    out.resize(at + count * qsizetype(sizeof(double)));
+    qToLittleEndian<double>(values, count, out.data() + at);
+}
+
+QJsonObject ReportCbor::tableToJson(const QCborMap &table)
+{
+    struct Column {
+        const char *packed = nullptr; // float64 little-endian values
+        QCborArray values;            // any other column
+    };
+
+    const qsizetype rowCount = table.value(QLatin1String("rowCount")).toInteger();
+    const QCborArray cells = table.value(QLatin1String("cells")).toArray();
+    std::vector<QByteArray> storage; // keeps packed columns alive
+    storage.reserve(cells.size());
+    std::vector<Column> columns(cells.size());
+    for (qsizetype c = 0; c < cells.size(); ++c) {
+        const QCborValue cell = cells.at(c);
+        if (cell.isTag() && cell.tag() == QCborTag(TYPED_FLOAT64_LE)) {
+            storage.push_back(cell.taggedValue().toByteArray());
+            if (storage.back().size() >= rowCount * qsizetype(sizeof(double))) {
+                columns[c].packed = storage.back().constData();
+            }
+        } else {
+            columns[c].values = cell.toArray();
+        }
+    }
+
+    QJsonArray rows;
+    for (qsizetype r = 0; r < rowCount; ++r) {
+        QJsonArray row;
+        for (const Column &column : columns) {
+            if (column.packed) {
+                const double v = qFromLittleEndian<double>(column.packed + r * sizeof(double));
+                row.append(std::isnan(v) ? QJsonValue() : QJsonValue(v));
+            } else {
+                row.append(column.values.at(r).toJsonValue());
+            }
+        }
+        rows.append(row);
+    }
+
+    QJsonObject obj;
+    obj.insert("type", "table");
+    obj.insert("title", table.value(QLatin1String("title")).toString());
+    obj.insert("columns", table.value(QLatin1String("columns")).toJsonValue());
+    obj.insert("rows", rows);
+    return obj;
+}
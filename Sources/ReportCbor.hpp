@@ -0,0 +1,118 @@
+//
+// Created on 17 Oct, 2026
+//  by alecproj
+//
+
+#ifndef SOURCES_REPORTCBOR_HPP_
+#define SOURCES_REPORTCBOR_HPP_
+
+#include "CborTable.hpp"
+
+#include <QByteArray>
+#include <QByteArrayView>
+#include <QCborMap>
+#include <QCborStreamWriter>
+#include <QJsonObject>
+#include <QJsonValue>
+#include <QList>
+
+#include <memory>
+#include <vector>
+
+class QCborStreamReader;
+
+/**
+ * Binary report format. The logical layout is the same as in JSON reports:
+ *
+ *   tag 55799 { "data": { "result": {...}, "solution": [...], "task": {...} },
+ *               "checksum": h'XXXXXXXX' }
+ *
+ * but a table item keeps its cells column by column:
+ *
+ *   { "type": "table", "title": ..., "columns": [...], "rowCount": N,
+ *     "cells": [column, ...] }
+ *
+ * A column of numbers is a float64 little-endian typed array (RFC 8746,
+ * tag 85) with NaN for empty cells, any other column is a plain array.
+ * The checksum is the CRC-32 of the encoded data value, stored big-endian
+ * in a 4 byte string, so the file is checked without decoding it.
+ */
+class ReportCbor {
+
+public:
+    /**
+     * @return true if bytes start with the CBOR report signature
+     */
+    static bool isCbor(QByteArrayView bytes);
+    /**
+     * Finds the encoded data value and the stored checksum
+     * @return false if bytes are not a CBOR report
+     */
+    static bool dataSection(QByteArrayView bytes, QByteArrayView *outData, uint32_t *outChecksum);
+    /**
+     * Wraps an encoded data value into a complete report file
+     */
+    static QByteArray wrap(const QByteArray &data);
+
+    /**
+     * Reads a mapped report file with QCborStreamReader, without building
+     * a DOM of it. Everything but the solution goes to out as JSON. A
+     * table item goes there without its cells, which are left in the file
+     * (outTables gets the table or nullptr for every item). With
+     * outTables == nullptr the solution array is skipped unread and only
+     * the number of its items is kept.
+     * @return false if the file cannot be decoded
+     */
+    static bool read(const std::shared_ptr<const MappedFile> &file, QJsonObject *out,
+                     qsizetype *outSolutionCount, QList<std::shared_ptr<const CborTable>> *outTables);
+    /**
+     * Converts a report file to the JSON report object (tables with "rows")
+     * @return false if bytes cannot be decoded
+     */
+    static bool toJson(QByteArrayView bytes, QJsonObject *out);
+    /**
+     * Converts a JSON report object to a report file
+     */
+    static QByteArray fromJson(const QJsonObject &report);
+
+    // Building blocks of the encoder, also used by ReportWriter. They give
+    // encoded pieces that are simply written one after another, so a
+    // report is written as it goes and a table is never in memory whole.
+
+    /**
+     * Start of the file, up to the data value
+     */
+    static QByteArray header();
+    /**
+     * End of the file after the data value with the given CRC-32
+     */
+    static QByteArray trailer(quint32 checksum);
+    static QByteArray mapHead(quint64 size);
+    static QByteArray arrayHead(quint64 size);
+    static QByteArray encodeJson(const QJsonValue &value);
+    /**
+     * A table map up to the head of its "cells" array; the columns
+     * follow, one item each
+     */
+    static QByteArray tableHead(const QJsonObject &table, qsizetype rowCount);
+    /**
+     * Head of a packed column of count values; the values follow, see
+     * appendPacked
+     */
+    static QByteArray packedHead(qsizetype count);
+    static void appendPacked(QByteArray &out, const double *values, qsizetype count);
+
+private:
+    static constexpr quint64 TYPED_FLOAT64_LE = 85;   // RFC 8746
+
+    static QByteArray head(quint8 majorType, quint64 value);
+    static void appendJson(QCborStreamWriter &writer, const QJsonValue &value);
+    static QJsonObject tableToJson(const QCborMap &table);
+    static bool readSolutionItem(QCborStreamReader &reader, QByteArrayView data,
+                                 const std::shared_ptr<const MappedFile> &file,
+                                 QJsonValue *outItem, std::shared_ptr<const CborTable> *outTable);
+    static bool readCells(QCborStreamReader &reader, QByteArrayView data,
+                          std::vector<CborTable::Column> *outColumns);
+};
+
+#endif // SOURCES_REPORTCBOR_HPP_
@@ -0,0 +1,301 @@
+//
+// Created on 17 Oct, 2026
+//  by alecproj
+//
+
+#include "ReportIndex.hpp"
+#include "FileManager.hpp"
+
+#include <QDateTime>
+#include <QDebug>
+#include <QJsonDocument>
+
+#include <algorithm>
+
+ReportIndex::ReportIndex(const QString &indexFileName)
+    : m_fileName{indexFileName}
+    , m_journalName{indexFileName + QStringLiteral(".journal")}
+    , m_entries{}
+    , m_changed{}
+    , m_journalLines{0}
+    , m_loaded{false}
+    , m_rewrite{false}
+{
+}
+
+ReportIndex::Changes ReportIndex::refresh()
+{
+    if (!m_loaded) {
+        load();
+    }
+
+    Changes changes;
+    QSet<QString> present;
+    const QFileInfoList files = FileManager::listFileInfos();
+    present.reserve(files.count());
+    for (const auto &fi : files) {
+        present.insert(fi.fileName());
+        update(fi, changes);
+    }
+
+    QStringList gone;
+    for (auto it = m_entries.cbegin(); it != m_entries.cend(); ++it) {
+        if (!present.contains(it.key())) {
+            gone.append(it.key());
+        }
+    }
+    for (const auto &name : std::as_const(gone)) {
+        forget(name, changes);
+    }
+
+    if (!m_changed.isEmpty()) {
+        qDebug() << "ReportIndex:" << files.count() << "files,"
+                 << changes.upserted.count() << "updated," << changes.removed.count() << "removed";
+    }
+    save();
+    return changes;
+}
+
+ReportIndex::Changes ReportIndex::refresh(const QStringList &fileNames)
+{
+    if (!m_loaded) {
+        load();
+    }
+
+    Changes changes;
+    for (const auto &name : fileNames) {
+        const QFileInfo fi = FileManager::reportFileInfo(name);
+        if (fi.exists() && fi.isFile() && fi.isReadable()) {
+            update(fi, changes);
+        } else {
+            forget(name, changes);
+        }
+    }
+    save();
+    return changes;
+}
+
+void ReportIndex::update(const QFileInfo &fi, Changes &changes)
+{
+    const QString name = fi.fileName();
+    const qint64 modified = fi.lastModified().toMSecsSinceEpoch();
+    const qint64 size = fi.size();
+
+    auto it = m_entries.find(name);
+    if (it != m_entries.end() && it->modified == modified && it->size == size) {
+        return;
+    }
+    const bool wasListed = (it != m_entries.end() && it->listed);
+    Entry entry;
+    entry.fileName = name;
+    entry.modified = modified;
+    entry.size = size;
+    entry.readStatus = ReportReader::summary(name, &entry.summary);
+    entry.listed = (entry.readStatus == ReportStatus::Ok);
+    m_entries.insert(name, entry);
+    m_changed.insert(name);
+    if (entry.listed) {
+        changes.upserted.append(entry);
+    } else if (wasListed) {
+        changes.removed.append(name);
+    }
+}
+
+void ReportIndex::forget(const QString &fileName, Changes &changes)
+{
+    auto it = m_entries.find(fileName);
+    if (it == m_entries.end()) {
+        return;
+    }
+    if (it->listed) {
+        changes.removed.append(fileName);
+    }
+    m_entries.erase(it);
+    m_changed.insert(fileName);
+}
+
+QList<ReportIndex::Entry> ReportIndex::listedEntries() const
+{
+    QList<Entry> listed;
+    listed.reserve(m_entries.count());
+    for (const auto &entry : m_entries) {
+        if (entry.listed) {
+            listed.append(entry);
+        }
+    }
+    std::sort(listed.begin(), listed.end(), [](const Entry &a, const Entry &b) {
+        return a.modified < b.modified;
+    });
+    return listed;
+}
+
+void ReportIndex::remove(const QString &fileName)
+{
+    if (m_entries.remove(fileName) > 0) {
+        m_changed.insert(fileName);
+    }
+}
+
+bool ReportIndex::save()
+{
+    if (m_changed.isEmpty() && !m_rewrite) {
+        return true;
+    }
+    if (!m_rewrite && m_journalLines + m_changed.count() <= std::max<qsizetype>(MIN_JOURNAL_LINES, m_entries.count())) {
+        // One line per changed entry: {"name": ..., "entry": {...}} or {"name": ..., "removed": true}
+        QByteArray lines;
+        for (const auto &name : std::as_const(m_changed)) {
+            QJsonObject line;
+            line.insert("name", name);
+            auto it = m_entries.constFind(name);
+            if (it != m_entries.cend()) {
+                line.insert("entry", toJson(it.value()));
+            } else {
+                line.insert("removed", true);
+            }
+            lines += QJsonDocument(line).toJson(QJsonDocument::Compact);
+            lines += '\n';
+        }
+        if (FileManager::appendFile(m_journalName, lines)) {
+            m_journalLines += m_changed.count();
+            m_changed.clear();
+            return true;
+        }
+    }
+
+    QJsonObject entries;
+    for (auto it = m_entries.cbegin(); it != m_entries.cend(); ++it) {
+        entries.insert(it.key(), toJson(it.value()));
+    }
+    QJsonObject root;
+    root.insert("version", VERSION);
+    root.insert("entries", entries);
+    if (!FileManager::saveJsonFile(m_fileName, root, QJsonDocument::Compact)) {
+        return false;
+    }
+    // A journal left behind by a failed deletion only repeats entries that
+    // are validated against the file size and time anyway
+    if (FileManager::fileExists(m_journalName)) {
+        FileManager::deleteFile(m_journalName);
+    }
+    m_journalLines = 0;
+    m_changed.clear();
+    m_rewrite = false;
+    return true;
+}
+
+void ReportIndex::load()
+{
+    m_loaded = true;
+    m_entries.clear();
+    m_changed.clear();
+    m_journalLines = 0;
+    QJsonObject root;
+    if (!FileManager::fileExists(m_fileName) || !FileManager::loadJsonFile(m_fileName, root)) {
+        // Earlier versions kept the index among the reports
+        if (FileManager::fileExists(QStringLiteral("reports.index"))) {
+            FileManager::deleteFile(QStringLiteral("reports.index"));
+        }
+        m_rewrite = true;
+        return;
+    }
+    if (root.value("version").toInt() != VERSION) {
+        qDebug() << "ReportIndex: index version changed, rebuilding";
+        m_rewrite = true;
+        return;
+    }
+    const QJsonObject entries = root.value("entries").toObject();
+    m_entries.reserve(entries.count());
+    for (auto it = entries.constBegin(); it != entries.constEnd(); ++it) {
+        Entry entry;
+        if (fromJson(it.key(), it.value().toObject(), &entry)) {
+            m_entries.insert(it.key(), entry);
+        } else {
+            m_rewrite = true;
+        }
+    }
+    loadJournal();
+}
+
+void ReportIndex::loadJournal()
+{
+    QByteArray data;
+    if (!FileManager::fileExists(m_journalName) || !FileManager::loadFile(m_journalName, data)) {
+        return;
+    }
+    for (const QByteArray &line : data.split('\n')) {
+        if (line.isEmpty()) {
+            continue;
+        }
+        ++m_journalLines;
+        // A line cut short by a crash is skipped; its report is re-read by the next refresh
+        const QJsonObject obj = QJsonDocument::fromJson(line).object();
+        const QString name = obj.value("name").toString();
+        if (name.isEmpty()) {
+            m_rewrite = true;
+            continue;
+        }
+        Entry entry;
+        if (obj.value("removed").toBool()) {
+            m_entries.remove(name);
+        } else if (fromJson(name, obj.value("entry").toObject(), &entry)) {
+            m_entries.insert(name, entry);
+        } else {
+            m_entries.remove(name);
+            m_rewrite = true;
+        }
+    }
+}
+
+QJsonObject ReportIndex::toJson(const Entry &entry)
+{
+    QJsonObject obj;
+    obj.insert("modified", entry.modified);
+    obj.insert("size", entry.size);
+    obj.insert("readStatus", static_cast<int>(entry.readStatus));
+    if (!entry.listed) {
+        return obj;
+    }
+    const ReportSummary &s = entry.summary;
+    obj.insert("algorithm", s.algorithm);
+    obj.insert("function", s.function);
+    obj.insert("info", s.info);
+    obj.insert("status", static_cast<int>(s.status));
+    if (s.hasResult) {
+        QJsonObject result;
+        result.insert("x", s.x);
+        result.insert("y", s.y);
+        result.insert("funcValue", s.funcValue);
+        obj.insert("result", result);
+    }
+    return obj;
+}
+
+bool ReportIndex::fromJson(const QString &fileName, const QJsonObject &obj, Entry *out)
+{
+    if (!obj.contains("modified") || !obj.contains("size") || !obj.contains("readStatus")) {
+        return false;
+    }
+    out->fileName = fileName;
+    out->modified = obj.value("modified").toInteger();
+    out->size = obj.value("size").toInteger();
+    out->readStatus = static_cast<ReportStatus::Status>(obj.value("readStatus").toInt());
+    out->listed = (out->readStatus == ReportStatus::Ok);
+    if (!out->listed) {
+        return true;
+    }
+    if (!obj.contains("info") || !obj.contains("status")) {
+        return false;
+    }
+    ReportSummary &s = out->summary;
+    s.algorithm = obj.value("algorithm").toString();
+    s.function = obj.value("function").toString();
+    s.info = obj.value("info").toString();
+    s.status = static_cast<ReportStatus::Status>(obj.value("status").toInt());
+    const QJsonObject result = obj.value("result").toObject();
+    s.hasResult = !result.isEmpty();
+    s.x = result.value("x").toDouble();
+    s.y = result.value("y").toDouble();
+    s.funcValue = result.value("funcValue").toDouble();
+    return true;
+}
@@ -0,0 +1,102 @@
+//
+// Created on 17 Oct, 2026
+//  by alecproj
+//
+
+#ifndef SOURCES_REPORTINDEX_HPP_
+#define SOURCES_REPORTINDEX_HPP_
+
+#include "ReportReader.hpp"
+
+#include <QFileInfo>
+#include <QHash>
+#include <QJsonObject>
+#include <QList>
+#include <QSet>
+#include <QString>
+#include <QStringList>
+
+/**
+ * Persistent summary of the report directory, kept in a subdirectory of it
+ * (so that writing the index does not look like a change of the reports to
+ * a directory watcher). An entry is trusted as long as the size and the
+ * modification time of its file are unchanged, so a full refresh costs one
+ * index read plus one directory listing, and only new or changed reports
+ * are parsed; refresh(fileNames) does not list the directory at all.
+ *
+ * Changed entries are appended to a journal next to the index; the index
+ * itself is rewritten (and the journal dropped) only when the journal
+ * grows longer than the index or the index has to be rebuilt.
+ */
+class ReportIndex {
+
+public:
+    struct Entry {
+        QString fileName;
+        qint64 modified = 0;        // ms since epoch
+        qint64 size = 0;
+        bool listed = false;        // the report can be shown in the report list
+        ReportStatus::Status readStatus = ReportStatus::NotVerified; // ReportReader::summary result
+        ReportSummary summary;
+    };
+
+    /**
+     * Difference made by a refresh, in terms of the report list
+     */
+    struct Changes {
+        QList<Entry> upserted; // listed reports that are new or were rewritten
+        QStringList removed;   // reports that are gone or can no longer be listed
+        bool isEmpty() const { return upserted.isEmpty() && removed.isEmpty(); }
+    };
+
+    explicit ReportIndex(const QString &indexFileName = QStringLiteral(".index/reports.index"));
+
+    /**
+     * Brings the index in line with the report directory and saves it if
+     * anything changed. Only new or modified files are parsed.
+     */
+    Changes refresh();
+    /**
+     * Same as refresh() for the given reports only, which were created,
+     * rewritten or deleted (see ReportWatcher)
+     */
+    Changes refresh(const QStringList &fileNames);
+    /**
+     * @return entries of all listed reports, oldest first
+     */
+    QList<Entry> listedEntries() const;
+    /**
+     * Forgets the entry of a deleted report
+     */
+    void remove(const QString &fileName);
+    /**
+     * Writes unsaved changes to the journal, or rewrites the index
+     */
+    bool save();
+
+    int count() const { return m_entries.count(); }
+
+private:
+    static constexpr int VERSION = 1; // bump when the entry format changes
+    static constexpr int MIN_JOURNAL_LINES = 64; // the index is not rewritten for a shorter journal
+
+    QString m_fileName;
+    QString m_journalName;
+    QHash<QString, Entry> m_entries; // file name -> entry
+    QSet<QString> m_changed;         // entries added, updated or removed since the last save
+    int m_journalLines;
+    bool m_loaded;
+    bool m_rewrite; // the whole index has to be written
+
+    void load();
+    void loadJournal();
+    /**
+     * Re-reads the report if its size or modification time changed
+     */
+    void update(const QFileInfo &fi, Changes &changes);
+    void forget(const QString &fileName, Changes &changes);
+    static QJsonObject toJson(const Entry &entry);
+    static bool fromJson(const QString &fileName, const QJsonObject &obj, Entry *out);
+};
+
+#endif // SOURCES_REPORTINDEX_HPP_
@@ -5,12 +5,33 @@
 
 #include "ReportReader.hpp"
 #include "FileManager.hpp"
+#include "Checksum.hpp"
+#include "ReportCbor.hpp"
+#include "JsonCursor.hpp"
 
 #include <QDateTime>
+#include <QDebug>
+#include <QJsonDocument>
 #include <QMetaEnum>
 #include <QTextStream>
 
 ReportStatus::Status ReportReader::quickInfo(const QString &fileName, QuickInfo *out)
+{
+    if (!out) {
+        return ReportStatus::NotVerified;
+    }
+    ReportSummary summary;
+    ReportStatus::Status rv = ReportReader::summary(fileName, &summary);
+    if (rv != ReportStatus::Ok) {
+        return rv;
+    }
+    out->setName(fileName);
+    out->setInfo(summary.info);
+    out->setStatus(summary.status);
+    return ReportStatus::Ok;
+}
+
+ReportStatus::Status ReportReader::summary(const QString &fileName, ReportSummary *out)
 {
     if (!out) {
         return ReportStatus::NotVerified;
@@ -26,14 +47,7 @@ ReportStatus::Status ReportReader::quickInfo(const QString &fileName, QuickInfo
         default:
             return rv;
     }
-    
-    out->setName(fileName);
-    QString info;
-    QTextStream(&info) 
-        << data.abbreviation
-        << data.date.toString(" dd.MM.yyyy ")
-        << data.time.toString("HH:mm:ss ")
-        << "f(x,y)=";
+
     QJsonObject dataObj = data.json.value("data").toObject();
     if (dataObj.isEmpty()) {
         return ReportStatus::InvalidDataStruct;
@@ -50,13 +64,26 @@ ReportStatus::Status ReportReader::quickInfo(const QString &fileName, QuickInfo
     }
 
     if (inputObj.contains("function") && !inputObj.value("function").isNull()) {
-        QTextStream(&info) << inputObj.value("function").toString();
+        out->function = inputObj.value("function").toString();
     } else {
         return ReportStatus::InvalidDataStruct;
     }
 
-    out->setInfo(info);
-    out->setStatus(rv);
+    out->algorithm = data.abbreviation;
+    out->info.clear();
+    QTextStream(&out->info)
+        << data.abbreviation
+        << data.date.toString(" dd.MM.yyyy ")
+        << data.time.toString("HH:mm:ss ")
+        << "f(x,y)="
+        << out->function;
+
+    QJsonObject resultObj = dataObj.value("result").toObject();
+    out->hasResult = !resultObj.isEmpty();
+    out->x = resultObj.value("x").toDouble();
+    out->y = resultObj.value("y").toDouble();
+    out->funcValue = resultObj.value("funcValue").toDouble();
+    out->status = rv;
     return ReportStatus::Ok;
 }
 
@@ -82,13 +109,13 @@ ReportStatus::Status ReportReader::inputData(const QString &fileName, InputData
 
 
 ReportStatus::Status ReportReader::reportData(const QString &fileName,
-    InputData *outInput, QJsonArray &outSolution, ResultData *outResult)
+    InputData *outInput, ReportSolution &outSolution, ResultData *outResult)
 {
     if (!outInput) {
         return ReportStatus::NotVerified;
     }
     FileData data{};
-    auto rv = validateFile(fileName, &data);
+    auto rv = validateFile(fileName, &data, true);
     switch (rv) {
         case ReportStatus::Ok:
         case ReportStatus::InvalidCRC:
@@ -101,7 +128,7 @@ ReportStatus::Status ReportReader::reportData(const QString &fileName,
     if (rv != ReportStatus::Ok) {
         return rv;
     }
-    rv = readSolution(data.json, &outSolution);
+    rv = readSolution(data, &outSolution);
     if (rv != ReportStatus::Ok) {
         return rv;
     }
@@ -254,14 +281,16 @@ ReportStatus::Status ReportReader::readInputData(const QJsonObject &obj, InputDa
     return ReportStatus::Ok;
 }
 
-ReportStatus::Status ReportReader::readSolution(const QJsonObject &obj, QJsonArray *out)
+ReportStatus::Status ReportReader::readSolution(const FileData &data, ReportSolution *out)
 {
-    QJsonObject dataObj = obj.value("data").toObject();
+    QJsonObject dataObj = data.json.value("data").toObject();
     if (dataObj.isEmpty()) {
         return ReportStatus::InvalidDataStruct;
     }
-    *out = dataObj.value("solution").toArray();
-    if (out->isEmpty()) {
+    out->items = dataObj.value("solution").toArray();
+    out->deferredRows = data.deferredRows;
+    out->cborTables = data.cborTables;
+    if (out->items.isEmpty()) {
         return ReportStatus::NoSolution;
     }
     return ReportStatus::Ok;
@@ -300,7 +329,7 @@ ReportStatus::Status ReportReader::readResult(const QJsonObject &obj, ResultData
     return ReportStatus::Ok;
 }
 
-ReportStatus::Status ReportReader::validateFile(const QString &fileName, FileData *out)
+ReportStatus::Status ReportReader::validateFile(const QString &fileName, FileData *out, bool withSolution)
 {
     if (!FileManager::fileExists(fileName)) {
         return ReportStatus::FileDoesNotExists;
@@ -308,29 +337,135 @@ ReportStatus::Status ReportReader::validateFile(const QString &fileName, FileDat
     if (!validateName(fileName, out)) {
         return ReportStatus::InvalidName;
     }
-    if (!FileManager::loadJsonFile(fileName, out->json)) {
+    out->file = FileManager::mapFile(fileName);
+    if (!out->file) {
         return ReportStatus::InvalidFile;
     }
+    const QByteArrayView bytes = out->file->bytes();
+    const bool cbor = ReportCbor::isCbor(bytes);
+    QByteArrayView dataSection;
+    qsizetype solutionCount = 0;
+    if (cbor) {
+        if (!ReportCbor::dataSection(bytes, &dataSection, nullptr)
+            || !ReportCbor::read(out->file, &out->json, &solutionCount,
+                                 withSolution ? &out->cborTables : nullptr)) {
+            qWarning() << "ReportReader: invalid CBOR report:" << fileName;
+            return ReportStatus::InvalidFile;
+        }
+    } else {
+        auto rv = pullJson(out, withSolution, &dataSection, &solutionCount);
+        if (rv != ReportStatus::Ok) {
+            qWarning() << "ReportReader: cannot read report:" << fileName;
+            return rv;
+        }
+    }
     auto dataObj = out->json.value("data").toObject();
     if (dataObj.isEmpty()) {
         return ReportStatus::InvalidDataStruct;
     }
-    auto solutionArr = dataObj.value("solution").toArray();
-    if (solutionArr.isEmpty()) {
+    if (solutionCount == 0) {
         return ReportStatus::NoSolution;
     }
     auto resultObj = dataObj.value("result").toObject();
     if (resultObj.isEmpty()) {
         return ReportStatus::NoResult;
     }
-    ReportStatus::Status rv = validateCRC(out->json);
-    return rv;
+    return validateCRC(out->json.value("checksum"), dataSection, !cbor);
+}
+
+ReportStatus::Status ReportReader::pullJson(FileData *out, bool withSolution,
+    QByteArrayView *outData, qsizetype *outSolutionCount)
+{
+    JsonCursor top(out->file->bytes());
+    QByteArrayView key;
+    QByteArrayView value;
+    QByteArrayView dataText;
+    QJsonObject report;
+    if (!top.enterObject()) {
+        return ReportStatus::InvalidFile;
+    }
+    while (top.nextKey(&key) && top.skipValue(&value)) {
+        if (key == "data") {
+            dataText = value;
+        } else {
+            report.insert(QString::fromUtf8(key), parseValue(value));
+        }
+    }
+    if (top.failed()) {
+        return ReportStatus::InvalidFile;
+    }
+    if (dataText.isEmpty()) {
+        return ReportStatus::InvalidDataStruct;
+    }
+
+    QJsonObject dataObj;
+    qsizetype count = 0;
+    JsonCursor data(dataText);
+    if (!data.enterObject()) {
+        return ReportStatus::InvalidDataStruct;
+    }
+    while (data.nextKey(&key)) {
+        if (key != "solution") {
+            if (!data.skipValue(&value)) break;
+            dataObj.insert(QString::fromUtf8(key), parseValue(value));
+            continue;
+        }
+        QJsonArray solution;
+        if (!data.enterArray()) break;
+        while (data.nextElement()) {
+            ++count;
+            if (!withSolution) {
+                if (!data.skipValue()) break;
+                continue;
+            }
+            QJsonObject item;
+            std::shared_ptr<DeferredRows> rows;
+            if (!pullSolutionItem(data, *out, &item, &rows)) break;
+            solution.append(item);
+            out->deferredRows.append(rows);
+        }
+        dataObj.insert("solution", solution);
+    }
+    if (data.failed()) {
+        return ReportStatus::InvalidFile;
+    }
+    report.insert("data", dataObj);
+    out->json = report;
+    *outData = dataText;
+    *outSolutionCount = count;
+    return ReportStatus::Ok;
+}
+
+bool ReportReader::pullSolutionItem(JsonCursor &cursor, const FileData &data,
+    QJsonObject *outItem, std::shared_ptr<DeferredRows> *outRows)
+{
+    if (!cursor.enterObject()) {
+        return false;
+    }
+    QByteArrayView key;
+    QByteArrayView value;
+    while (cursor.nextKey(&key) && cursor.skipValue(&value)) {
+        if (key == "rows") {
+            *outRows = std::make_shared<DeferredRows>(data.file, value);
+        } else {
+            outItem->insert(QString::fromUtf8(key), parseValue(value));
+        }
+    }
+    return !cursor.failed();
+}
+
+QJsonValue ReportReader::parseValue(QByteArrayView text)
+{
+    QByteArray array;
+    array.reserve(text.size() + 2);
+    array.append('[').append(text).append(']');
+    return QJsonDocument::fromJson(array).array().at(0);
 }
 
 bool ReportReader::validateName(const QString &fileName, FileData *out)
 {
     static const QRegularExpression re(QStringLiteral(
-        "^([BCDGSR]+)-(\\d{1,2})-(\\d{1,2})-(\\d{4})-(\\d{1,2})-(\\d{1,2})-(\\d{1,2})\\.json$"
+        "^([BCDGSR]+)-(\\d{1,2})-(\\d{1,2})-(\\d{4})-(\\d{1,2})-(\\d{1,2})-(\\d{1,2})\\.(json|cbor)$"
     ), QRegularExpression::CaseInsensitiveOption);
 
     QRegularExpressionMatch match;
@@ -362,14 +497,12 @@ bool ReportReader::validateName(const QString &fileName, FileData *out)
 }
 
 
-ReportStatus::Status ReportReader::validateCRC(const QJsonObject &obj)
+ReportStatus::Status ReportReader::validateCRC(const QJsonValue &value, QByteArrayView dataSection, bool json)
 {
-    QJsonValue value = obj.value("checksum");
-    if (value.isNull()) {
+    if (value.isNull() || value.isUndefined()) {
         return ReportStatus::CheckFailed;
     }
 
-    uint32_t crc = calculateCRC(obj);
     uint32_t parsed = 0;
 
     if (value.isString()) {
@@ -388,17 +521,18 @@ ReportStatus::Status ReportReader::validateCRC(const QJsonObject &obj)
         return ReportStatus::InvalidDataStruct;
     }
 
+    uint32_t crc = Crc32::compute(dataSection.data(), static_cast<std::size_t>(dataSection.size()));
+    if (parsed != crc && json && dataSection.startsWith(QByteArrayView("{\n"))) {
+        // Old layout: the data section was written indented, but the checksum
+        // is of its compact form. The current writer never indents it, so any
+        // other mismatch is reported without re-serializing the section
+        QJsonDocument doc = QJsonDocument::fromJson(dataSection.toByteArray());
+        crc = FileManager::crc32FromBytes(doc.toJson(QJsonDocument::Compact));
+    }
+
     if (parsed == crc) {
         return ReportStatus::Ok;
     } else {
         return ReportStatus::InvalidCRC;
     }
 }
-
-uint32_t ReportReader::calculateCRC(const QJsonObject &obj)
-{
-    QJsonObject dataObj = obj.value("data").toObject();
-    QJsonDocument doc(dataObj);
-    QByteArray ba = doc.toJson(QJsonDocument::Compact);
-    return FileManager::crc32FromBytes(ba);
-}
@@ -10,45 +10,99 @@
 #include "QuickInfo.hpp"
 #include "ResultData.hpp"
 #include "AppEnums.hpp"
+#include "DeferredRows.hpp"
+#include "MappedFile.hpp"
 
 #include <QString>
 #include <QDateTime>
 #include <QJsonObject>
 #include <QJsonArray>
 
+class JsonCursor;
+
 struct FileData {
-    QJsonObject json;
+    QJsonObject json;      // report without table rows and cells
+    std::shared_ptr<const MappedFile> file;
+    QList<std::shared_ptr<DeferredRows>> deferredRows; // solution item -> rows left in file
+    QList<std::shared_ptr<const CborTable>> cborTables; // solution item -> cells left in file
     QString abbreviation;
     FullAlgoType::Type fullType;
     QDate date;
     QTime time;
 };
 
+/**
+ * Everything the report list needs to know about a report file.
+ * Small enough to be kept in the report index (see ReportIndex).
+ */
+struct ReportSummary {
+    QString algorithm;  // abbreviation from the file name (CDB, GDS, ...)
+    QString function;
+    QString info;       // the line shown in the report list
+    ReportStatus::Status status = ReportStatus::NotVerified;
+    bool hasResult = false;
+    double x = 0.0;
+    double y = 0.0;
+    double funcValue = 0.0;
+};
+
 class ReportReader {
 
 public:
 
     static ReportStatus::Status quickInfo(const QString &fileName, QuickInfo *out);
+    /**
+     * Reads the summary of a report. The file status (e.g. InvalidCRC)
+     * goes to out->status.
+     * @return Ok if the report can be listed
+     */
+    static ReportStatus::Status summary(const QString &fileName, ReportSummary *out);
     static ReportStatus::Status inputData(const QString &fileName, InputData *out);
+    /**
+     * Reads everything needed to show a report. Table cells are not read
+     * here, they come with outSolution as DeferredRows (JSON) or as
+     * CborTable (CBOR).
+     */
     static ReportStatus::Status reportData(
         const QString &fileName, InputData *outInput,
-        QJsonArray &outSolution, ResultData *outResult
+        ReportSolution &outSolution, ResultData *outResult
     );
 
 private:
     static inline ReportStatus::Status readInputData(const QJsonObject &obj, InputData *out);
-    static inline ReportStatus::Status readSolution(const QJsonObject &obj, QJsonArray *out);
+    static inline ReportStatus::Status readSolution(const FileData &data, ReportSolution *out);
     static inline ReportStatus::Status readResult(const QJsonObject &obj, ResultData *out);
 
-    static inline ReportStatus::Status validateFile(const QString &fileName, FileData *out);
+    /**
+     * Maps the file and reads the sections of the report. Table rows are
+     * never decoded here; with withSolution == false the solution items
+     * are only counted.
+     */
+    static inline ReportStatus::Status validateFile(
+        const QString &fileName, FileData *out, bool withSolution = false
+    );
+    /**
+     * Pulls the sections of a JSON report out of the mapped text without
+     * building a DOM of the whole file
+     */
+    static inline ReportStatus::Status pullJson(
+        FileData *out, bool withSolution, QByteArrayView *outData, qsizetype *outSolutionCount
+    );
+    static inline bool pullSolutionItem(
+        JsonCursor &cursor, const FileData &data, QJsonObject *outItem,
+        std::shared_ptr<DeferredRows> *outRows
+    );
+    static inline QJsonValue parseValue(QByteArrayView text);
     static inline bool validateName(const QString &fileName, FileData *out = nullptr);
-    static inline ReportStatus::Status validateCRC(const QJsonObject &obj);
     /**
-     * Calculates a checksum from the entire contents of the data section
-     * in obj.
-     * @return checksum
+     * Checks the stored checksum against the CRC-32 of the raw bytes of the
+     * data section. Only JSON reports of the old layout, recognized by an
+     * indented data section ("{\n"), are checked by serializing the data
+     * section again, as they were written.
      */
-    static inline uint32_t calculateCRC(const QJsonObject &obj);
+    static inline ReportStatus::Status validateCRC(
+        const QJsonValue &stored, QByteArrayView dataSection, bool json
+    );
 };
 
 
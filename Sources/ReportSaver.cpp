@@ -0,0 +1,85 @@
+//
+// Created on 17 Oct, 2026
+//  by alecproj
+//
+
+#include "ReportSaver.hpp"
+
+#include <QDebug>
+
+ReportSaver::ReportSaver(int capacity, QObject *parent)
+    : QObject{parent}
+    , m_capacity{qMax(1, capacity)}
+    , m_mutex{}
+    , m_notFull{}
+    , m_notEmpty{}
+    , m_queue{}
+    , m_writing{0}
+    , m_stopping{false}
+    , m_thread{nullptr}
+{
+    m_thread = QThread::create([this] { run(); });
+    m_thread->setObjectName("ReportSaver");
+    m_thread->start();
+}
+
+ReportSaver::~ReportSaver()
+{
+    {
+        QMutexLocker lock(&m_mutex);
+        m_stopping = true;
+        m_notEmpty.wakeAll();
+    }
+    m_thread->wait();
+    delete m_thread;
+}
+
+void ReportSaver::enqueue(std::unique_ptr<ReportWriter::Contents> report)
+{
+    if (!report) {
+        return;
+    }
+    QMutexLocker lock(&m_mutex);
+    while (static_cast<int>(m_queue.size()) >= m_capacity) {
+        m_notFull.wait(&m_mutex);
+    }
+    m_queue.push_back(std::move(report));
+    m_notEmpty.wakeOne();
+}
+
+int ReportSaver::pending() const
+{
+    QMutexLocker lock(&m_mutex);
+    return static_cast<int>(m_queue.size()) + m_writing;
+}
+
+void ReportSaver::run()
+{
+    QMutexLocker lock(&m_mutex);
+    while (true) {
+        while (m_queue.empty() && !m_stopping) {
+            m_notEmpty.wait(&m_mutex);
+        }
+        if (m_queue.empty()) {
+            return;
+        }
+        auto report = std::move(m_queue.front());
+        m_queue.pop_front();
+        ++m_writing;
+        m_notFull.wakeOne();
+        lock.unlock();
+
+        const QString fileName = report->fileName;
+        const bool ok = ReportWriter::save(*report);
+        if (!ok) {
+            qWarning() << "ReportSaver: cannot write report:" << fileName;
+        }
+        report.reset(); // the rows are in the file, free them before the next one
+
+        lock.relock();
+        --m_writing;
+        lock.unlock();
+        emit reportSaved(fileName, ok);
+        lock.relock();
+    }
+}
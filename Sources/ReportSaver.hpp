@@ -0,0 +1,66 @@
+//
+// Created on 17 Oct, 2026
+//  by alecproj
+//
+
+#ifndef SOURCES_REPORTSAVER_HPP_
+#define SOURCES_REPORTSAVER_HPP_
+
+#include "ReportWriter.hpp"
+
+#include <QMutex>
+#include <QObject>
+#include <QThread>
+#include <QWaitCondition>
+
+#include <deque>
+#include <memory>
+
+/**
+ * Writes finished reports on its own I/O thread, so a solver does not wait
+ * for serialization, the file lock and the disk. The queue is bounded: when
+ * reports come faster than the disk takes them, enqueue() blocks the
+ * producer instead of keeping an unbounded number of reports in memory.
+ * Reports still queued on destruction are written before it returns.
+ */
+class ReportSaver : public QObject {
+    Q_OBJECT
+
+public:
+    static constexpr int DEFAULT_CAPACITY = 4;
+
+    explicit ReportSaver(int capacity = DEFAULT_CAPACITY, QObject *parent = nullptr);
+    ~ReportSaver() override;
+
+    /**
+     * Queues the report for writing, blocks while the queue is full.
+     * Thread-safe.
+     */
+    void enqueue(std::unique_ptr<ReportWriter::Contents> report);
+    /**
+     * Number of reports queued or being written
+     */
+    int pending() const;
+
+signals:
+    /**
+     * Emitted on the I/O thread when the report file is committed (it is
+     * flushed to disk before it replaces the old file) or when writing
+     * has failed
+     */
+    void reportSaved(const QString &fileName, bool ok);
+
+private:
+    const int m_capacity;
+    mutable QMutex m_mutex;
+    QWaitCondition m_notFull;
+    QWaitCondition m_notEmpty;
+    std::deque<std::unique_ptr<ReportWriter::Contents>> m_queue;
+    int m_writing; // reports taken from the queue and not written yet
+    bool m_stopping;
+    QThread *m_thread;
+
+    void run();
+};
+
+#endif // SOURCES_REPORTSAVER_HPP_
@@ -0,0 +1,125 @@
+//
+// Created on 17 Oct, 2026
+//  by alecproj
+//
+
+#include "ReportWatcher.hpp"
+
+#include <QDebug>
+#include <QFile>
+#include <QSet>
+
+#ifdef Q_OS_LINUX
+#include <QSocketNotifier>
+
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+ReportWatcher::ReportWatcher(QObject *parent)
+    : QObject{parent}
+    , m_dir{}
+#ifdef Q_OS_LINUX
+    , m_fd{inotify_init1(IN_NONBLOCK | IN_CLOEXEC)}
+    , m_watch{-1}
+    , m_notifier{nullptr}
+#else
+    , m_watcher{}
+#endif
+{
+#ifdef Q_OS_LINUX
+    if (m_fd < 0) {
+        qWarning() << "ReportWatcher: inotify is unavailable, reports are not watched";
+        return;
+    }
+    m_notifier = new QSocketNotifier(m_fd, QSocketNotifier::Read, this);
+    connect(m_notifier, &QSocketNotifier::activated, this, &ReportWatcher::readEvents);
+#else
+    connect(&m_watcher, &QFileSystemWatcher::directoryChanged, this, &ReportWatcher::directoryChanged);
+#endif
+}
+
+ReportWatcher::~ReportWatcher()
+{
+#ifdef Q_OS_LINUX
+    // The notifier must not outlive the descriptor it polls
+    delete m_notifier;
+    if (m_fd >= 0) {
+        ::close(m_fd);
+    }
+#endif
+}
+
+bool ReportWatcher::watch(const QString &dir)
+{
+#ifdef Q_OS_LINUX
+    if (m_fd < 0) {
+        return false;
+    }
+    if (m_watch >= 0 && dir == m_dir) {
+        return true;
+    }
+    if (m_watch >= 0) {
+        inotify_rm_watch(m_fd, m_watch);
+    }
+    m_dir = dir;
+    m_watch = inotify_add_watch(m_fd, QFile::encodeName(dir).constData(),
+                                IN_CLOSE_WRITE | IN_MOVED_TO | IN_MOVED_FROM | IN_DELETE | IN_ATTRIB |
+                                IN_DELETE_SELF | IN_MOVE_SELF | IN_ONLYDIR);
+    return m_watch >= 0;
+#else
+    if (m_watcher.directories().contains(dir)) {
+        return true;
+    }
+    if (!m_dir.isEmpty()) {
+        m_watcher.removePath(m_dir);
+    }
+    m_dir = dir;
+    return m_watcher.addPath(dir);
+#endif
+}
+
+#ifdef Q_OS_LINUX
+void ReportWatcher::readEvents()
+{
+    alignas(inotify_event) char buffer[4096];
+    QSet<QString> names;
+    bool rescan = false;
+    for (;;) {
+        const ssize_t length = ::read(m_fd, buffer, sizeof(buffer));
+        if (length <= 0) {
+            break; // EAGAIN: all queued events are read
+        }
+        for (ssize_t offset = 0; offset < length;) {
+            const auto *event = reinterpret_cast<const inotify_event *>(buffer + offset);
+            offset += static_cast<ssize_t>(sizeof(inotify_event) + event->len);
+            if (event->mask & IN_Q_OVERFLOW) {
+                rescan = true; // events were dropped
+                continue;
+            }
+            if (event->wd != m_watch) {
+                continue;
+            }
+            if (event->mask & (IN_IGNORED | IN_DELETE_SELF | IN_MOVE_SELF)) {
+                m_watch = -1; // the directory is gone; watch() renews the watch
+                rescan = true;
+                continue;
+            }
+            const QString name = (event->len > 0) ? QFile::decodeName(event->name) : QString();
+            if (isReport(name)) {
+                names.insert(name);
+            }
+        }
+    }
+    if (rescan) {
+        emit directoryChanged();
+    } else if (!names.isEmpty()) {
+        emit reportsChanged(names.values());
+    }
+}
+#endif
+
+bool ReportWatcher::isReport(const QString &fileName)
+{
+    return fileName.endsWith(QLatin1String(".json")) || fileName.endsWith(QLatin1String(".cbor"));
+}
@@ -0,0 +1,64 @@
+//
+// Created on 17 Oct, 2026
+//  by alecproj
+//
+
+#ifndef SOURCES_REPORTWATCHER_HPP_
+#define SOURCES_REPORTWATCHER_HPP_
+
+#include <QObject>
+#include <QString>
+#include <QStringList>
+
+#ifdef Q_OS_LINUX
+class QSocketNotifier;
+#else
+#include <QFileSystemWatcher>
+#endif
+
+/**
+ * Watches the report directory. On Linux it reads inotify events, so every
+ * change names its report and anything that is not a .json or .cbor report
+ * (the index subdirectory, lock files, temporary files of QSaveFile) is
+ * ignored. Elsewhere QFileSystemWatcher only tells that the directory
+ * changed, and the whole directory has to be rescanned.
+ */
+class ReportWatcher : public QObject {
+    Q_OBJECT
+
+public:
+    explicit ReportWatcher(QObject *parent = nullptr);
+    ~ReportWatcher() override;
+
+    /**
+     * Starts watching the directory unless it is already watched. The watch
+     * is lost if the directory is removed, so this is called on every rescan.
+     */
+    bool watch(const QString &dir);
+
+signals:
+    /**
+     * These reports were created, rewritten, renamed or deleted
+     */
+    void reportsChanged(const QStringList &fileNames);
+    /**
+     * The directory changed in an unknown way; every report has to be checked
+     */
+    void directoryChanged();
+
+private:
+    QString m_dir;
+#ifdef Q_OS_LINUX
+    int m_fd;    // inotify instance, -1 if unavailable
+    int m_watch; // watch descriptor of m_dir, -1 if not watched
+    QSocketNotifier *m_notifier;
+
+    void readEvents();
+#else
+    QFileSystemWatcher m_watcher;
+#endif
+
+    static bool isReport(const QString &fileName);
+};
+
+#endif // SOURCES_REPORTWATCHER_HPP_
@@ -5,37 +5,116 @@
 
 #include "ReportWriter.hpp"
 #include "FileManager.hpp"
+#include "Checksum.hpp"
+#include "ReportCbor.hpp"
+#include "ReportSaver.hpp"
+#include "JsonCursor.hpp"
+#include "MappedFile.hpp"
 
 #include <QString>
+#include <QCborValue>
 #include <QDateTime>
+#include <QDir>
 #include <QMetaEnum>
 #include <QDebug>
+#include <QLocale>
+
+#include <limits>
+#include <memory>
+#include <utility>
 
 // Helper: convert std::string -> QString
 static inline QString qs(const std::string &s) { return QString::fromStdString(s); }
 
-// Convert Cell variant to QJsonValue
-static QJsonValue cellToJsonValue(const ReportWriter::Cell &c) {
+// Same as QJsonDocument::Compact output for a string value
+static void appendJsonString(QByteArray &out, const QString &str)
+{
+    const QByteArray json = QJsonDocument(QJsonArray{str}).toJson(QJsonDocument::Compact);
+    out.append(json.constData() + 1, json.size() - 2); // without [ ]
+}
+
+// Same as QJsonDocument::Compact output for the QJsonValue of the cell
+static void appendCell(QByteArray &out, const ReportWriter::Cell &c)
+{
     if (std::holds_alternative<std::string>(c)) {
-        return QJsonValue(QString::fromStdString(std::get<std::string>(c)));
+        appendJsonString(out, QString::fromStdString(std::get<std::string>(c)));
     } else if (std::holds_alternative<double>(c)) {
-        return QJsonValue(std::get<double>(c));
+        const double d = std::get<double>(c);
+        if (qIsFinite(d)) out += QByteArray::number(d, 'g', QLocale::FloatingPointShortest);
+        else out += "null";
     } else if (std::holds_alternative<long long>(c)) {
-        return QJsonValue(static_cast<qint64>(std::get<long long>(c)));
+        out += QByteArray::number(static_cast<qint64>(std::get<long long>(c)));
     } else if (std::holds_alternative<bool>(c)) {
-        return QJsonValue(std::get<bool>(c));
+        out += std::get<bool>(c) ? "true" : "false";
     } else {
-        return QJsonValue(); // null
+        out += "null";
     }
 }
 
+// Function value of an iteration row, for the sampling: f is the fourth
+// column in the iteration tables of all solvers
+static double rowValue(const std::vector<ReportWriter::Cell> &row)
+{
+    static constexpr std::size_t VALUE_COLUMN = 3;
+    if (row.size() <= VALUE_COLUMN) return std::numeric_limits<double>::quiet_NaN();
+    const ReportWriter::Cell &c = row[VALUE_COLUMN];
+    if (std::holds_alternative<double>(c)) return std::get<double>(c);
+    if (std::holds_alternative<long long>(c)) return static_cast<double>(std::get<long long>(c));
+    return std::numeric_limits<double>::quiet_NaN();
+}
+
+class ReportWriter::Stream {
+public:
+    static constexpr qsizetype FLUSH_SIZE = 1 << 16;
+
+    explicit Stream(QIODevice &device)
+        : m_device{device}
+        , m_buffer{}
+        , m_crc{}
+        , m_hashing{false}
+        , m_ok{true}
+    {
+        m_buffer.reserve(FLUSH_SIZE + 4096);
+    }
+
+    QByteArray &buffer() { return m_buffer; }
+    void write(const char *text) { m_buffer += text; maybeFlush(); }
+    void write(const QByteArray &bytes) { m_buffer += bytes; maybeFlush(); }
+    void maybeFlush() { if (m_buffer.size() >= FLUSH_SIZE) flush(); }
+    void flush()
+    {
+        if (m_buffer.isEmpty()) return;
+        if (m_hashing) m_crc.update(m_buffer.constData(), static_cast<std::size_t>(m_buffer.size()));
+        m_ok = m_ok && (m_device.write(m_buffer) == m_buffer.size());
+        m_buffer.clear();
+    }
+    // Only the bytes written while hashing is on go into the checksum
+    void setHashing(bool on) { flush(); m_hashing = on; }
+    uint32_t checksum() const { return m_crc.value(); }
+    bool ok() const { return m_ok; }
+    void fail() { m_ok = false; }
+
+private:
+    QIODevice &m_device;
+    QByteArray m_buffer;
+    Crc32 m_crc;
+    bool m_hashing;
+    bool m_ok;
+};
+
 ReportWriter::ReportWriter()
     : m_inputData{nullptr}
+    , m_format{ReportFormat::JSON}
+    , m_saver{nullptr}
+    , m_spillBytes{0}
+    , m_sampling{}
     , m_path{QString{}}
     , m_fileName{QString{}}
     , m_report{QJsonObject{}}
     , m_solution{}
     , m_result{}
+    , m_stats{}
+    , m_tables{}
     , m_openTables{}
     , m_nextTableId{1}
 {
@@ -53,8 +132,12 @@ int ReportWriter::begin()
         static_cast<FullAlgoType::Type>(m_inputData->fullAlgoId())
     );
     m_solution = QJsonArray{};
+    m_result = QJsonObject{};
+    m_stats = QJsonObject{};
+    m_tables.clear();
     m_openTables.clear();
     m_nextTableId = 1;
+    m_sampling.minimize = (m_inputData->extremumId() != ExtremumType::MAXIMUM);
     prepare();
     writeInputData();
     return 0;
@@ -87,36 +170,107 @@ int ReportWriter::beginTable(const std::string &title, const std::vector<std::st
     tbl["columns"] = cols;
     tbl["rows"] = QJsonArray();
     m_solution.append(tbl);
-    int index = m_solution.size() - 1;
+
+    TableBuffer buffer{};
+    buffer.itemIndex = m_solution.size() - 1;
+    if (m_sampling.sampled()) {
+        buffer.sampler = std::make_unique<SC::RowSampler<std::vector<Cell>>>(m_sampling);
+    }
+    m_tables.push_back(std::move(buffer));
 
     int tableId = m_nextTableId++;
-    m_openTables.insert(tableId, index);
+    m_openTables.insert(tableId, static_cast<int>(m_tables.size()) - 1);
     return tableId;
 }
 
 int ReportWriter::insertRow(int tableId, const std::vector<Cell> &row)
 {
-    if (!m_openTables.contains(tableId)) {
+    auto it = m_openTables.constFind(tableId);
+    if (it == m_openTables.constEnd()) {
         qWarning("ReportWriter::writeRow: tableId not open");
         return -1;
     }
-    int idx = m_openTables.value(tableId);
-    QJsonObject tbl = m_solution.at(idx).toObject();
-    QJsonArray rows = tbl["rows"].toArray();
-
-    QJsonArray jsonRow;
-    for (const auto &cell : row) {
-        jsonRow.append(cellToJsonValue(cell));
+    TableBuffer &buffer = m_tables[it.value()];
+    if (buffer.sampler) {
+        buffer.sampler->add(row, rowValue(row), [this, &buffer](const std::vector<Cell> &r) {
+            appendRow(buffer, r);
+        });
+    } else {
+        appendRow(buffer, row);
     }
-    rows.append(jsonRow);
-    tbl["rows"] = rows;
-    m_solution.replace(idx, tbl);
     return 0;
 }
 
+void ReportWriter::appendRow(TableBuffer &buffer, const std::vector<Cell> &row)
+{
+    buffer.cells.insert(buffer.cells.end(), row.begin(), row.end());
+    buffer.rowEnds.push_back(buffer.cells.size());
+    if (buffer.textColumns.size() < row.size()) {
+        buffer.textColumns.resize(row.size(), false);
+    }
+    for (std::size_t i = 0; i < row.size(); ++i) {
+        if (!std::holds_alternative<double>(row[i]) && !std::holds_alternative<long long>(row[i])) {
+            buffer.textColumns[i] = true;
+        }
+    }
+    if (m_spillBytes > 0 && !buffer.spillFailed && buffer.cells.size() * sizeof(Cell) >= m_spillBytes) {
+        spill(buffer);
+    }
+}
+
+void ReportWriter::spill(TableBuffer &buffer)
+{
+    if (!buffer.segment) {
+        buffer.segment = std::make_unique<QTemporaryFile>(QDir::tempPath() + "/optdemo-rows-XXXXXX");
+        if (!buffer.segment->open()) {
+            qWarning() << "ReportWriter: cannot create a row segment, rows are kept in memory";
+            buffer.segment.reset();
+            buffer.spillFailed = true;
+            return;
+        }
+    }
+    QTemporaryFile &segment = *buffer.segment;
+    const qint64 start = segment.pos();
+    QByteArray chunk;
+    chunk.reserve(Stream::FLUSH_SIZE + 4096);
+    bool ok = true;
+    for (std::size_t r = 0; r < buffer.rowEnds.size() && ok; ++r) {
+        appendRows(chunk, buffer, r, r + 1);
+        if (chunk.size() >= Stream::FLUSH_SIZE || r + 1 == buffer.rowEnds.size()) {
+            ok = (segment.write(chunk) == chunk.size());
+            chunk.clear();
+        }
+    }
+    if (!ok) {
+        // Drop the partly written chunk, the rows stay in memory
+        qWarning() << "ReportWriter: cannot write a row segment, rows are kept in memory";
+        segment.resize(start);
+        segment.seek(start);
+        buffer.spillFailed = true;
+        return;
+    }
+    buffer.spilledRows += buffer.rowEnds.size();
+    buffer.cells.clear();   // the capacity is reused by the next chunk
+    buffer.rowEnds.clear();
+}
+
 void ReportWriter::endTable(int tableId)
 {
-    m_openTables.remove(tableId);
+    auto it = m_openTables.constFind(tableId);
+    if (it == m_openTables.constEnd()) {
+        return;
+    }
+    finishTable(m_tables[it.value()]);
+    m_openTables.erase(it);
+}
+
+void ReportWriter::finishTable(TableBuffer &buffer)
+{
+    if (buffer.sampler) {
+        buffer.sampler->finish([this, &buffer](const std::vector<Cell> &r) {
+            appendRow(buffer, r);
+        });
+    }
 }
 
 void ReportWriter::insertResult(double x, double y, double funcValue)
@@ -126,14 +280,72 @@ void ReportWriter::insertResult(double x, double y, double funcValue)
     m_result["funcValue"] = funcValue;
 }
 
+void ReportWriter::insertStats(const SC::SolveStats &stats)
+{
+    if (!stats.enabled) {
+        return;
+    }
+    QJsonObject phases;
+    for (int i = 0; i < SC::kPhaseCount; ++i) {
+        QJsonObject phase;
+        phase.insert("count", static_cast<qint64>(stats.phases[i].count));
+        phase.insert("seconds", stats.phases[i].seconds);
+        phases.insert(QLatin1String(SC::phaseToString(static_cast<SC::Phase>(i))), phase);
+    }
+    m_stats = QJsonObject{};
+    m_stats.insert("phases", phases);
+    m_stats.insert("lineSearchEvaluations", static_cast<qint64>(stats.lineSearchEvaluations));
+    m_stats.insert("memoHits", static_cast<qint64>(stats.memoHits));
+    m_stats.insert("totalSeconds", stats.totalSeconds);
+}
+
 int ReportWriter::end()
 {
-    writeSolutionAndResult();
-    writeCRC();
-    if (!FileManager::saveJsonFile(m_fileName, m_report)) {
-        return -1;
+    for (int index : std::as_const(m_openTables)) {
+        finishTable(m_tables[index]);
     }
-    return 0;
+    m_openTables.clear();
+    // The report leaves the writer, so the next begin() can start at once
+    auto report = std::make_unique<Contents>();
+    report->fileName = m_fileName;
+    report->format = m_format;
+    report->task = m_report.value("data").toObject().value("task").toObject();
+    if (m_sampling.sampled()) {
+        report->task.insert("rowSampling", samplingInfo());
+    }
+    if (!m_stats.isEmpty()) {
+        report->task.insert("stats", std::exchange(m_stats, QJsonObject{}));
+    }
+    report->solution = std::exchange(m_solution, QJsonArray{});
+    report->result = std::exchange(m_result, QJsonObject{});
+    report->tables = std::exchange(m_tables, {});
+    if (m_saver) {
+        m_saver->enqueue(std::move(report));
+        return 0;
+    }
+    return save(*report) ? 0 : -1;
+}
+
+QJsonObject ReportWriter::samplingInfo() const
+{
+    QJsonArray totalRows; // per table, in the order of the tables in the solution
+    for (const TableBuffer &buffer : m_tables) {
+        totalRows.append(static_cast<qint64>(buffer.sampler ? buffer.sampler->total() : buffer.rowCount()));
+    }
+    QJsonObject info;
+    info.insert("policy", QLatin1String(SC::rowPolicyToString(m_sampling.policy)));
+    info.insert("parameter", static_cast<qint64>(m_sampling.parameter));
+    info.insert("totalRows", totalRows);
+    return info;
+}
+
+bool ReportWriter::save(const Contents &report)
+{
+    return FileManager::saveFile(report.fileName, [&report](QIODevice &device) {
+        return (report.format == ReportFormat::CBOR)
+            ? writeCborReport(device, report)
+            : writeReport(device, report);
+    });
 }
 
 void ReportWriter::prepare()
@@ -182,19 +394,196 @@ void ReportWriter::writeInputData()
     m_report.insert("data", dataObj);
 }
 
-void ReportWriter::writeSolutionAndResult()
+bool ReportWriter::writeReport(QIODevice &device, const Contents &report)
 {
-    QJsonObject dataObj = m_report.value("data").toObject();
-    dataObj.insert("solution", m_solution);
-    dataObj.insert("result", m_result);
-    m_report.insert("data", dataObj);
+    std::vector<int> tableOf(report.solution.size(), -1); // item index -> index in tables
+    for (std::size_t i = 0; i < report.tables.size(); ++i) {
+        tableOf[report.tables[i].itemIndex] = static_cast<int>(i);
+    }
+
+    // Keys in the order QJsonObject keeps them (sorted), so the bytes are
+    // the same as QJsonDocument(data).toJson(Compact)
+    Stream out(device);
+    out.write("{\"data\":");
+    out.setHashing(true);
+    out.write("{\"result\":");
+    out.write(QJsonDocument(report.result).toJson(QJsonDocument::Compact));
+    out.write(",\"solution\":[");
+    for (qsizetype i = 0; i < report.solution.size(); ++i) {
+        if (i > 0) out.write(",");
+        const QJsonObject item = report.solution.at(i).toObject();
+        if (tableOf[i] >= 0) {
+            writeTable(out, item, report.tables[tableOf[i]]);
+        } else {
+            out.write(QJsonDocument(item).toJson(QJsonDocument::Compact));
+        }
+    }
+    out.write("],\"task\":");
+    out.write(QJsonDocument(report.task).toJson(QJsonDocument::Compact));
+    out.write("}");
+    out.setHashing(false);
+
+    const QString hex = QString("0x%1").arg(out.checksum(), 8, 16, QLatin1Char('0')).toUpper();
+    out.write(",\"checksum\":\"");
+    out.write(hex.toLatin1());
+    out.write("\"}\n");
+    out.flush();
+    return out.ok();
+}
+
+void ReportWriter::writeTable(Stream &out, const QJsonObject &table, const TableBuffer &buffer)
+{
+    out.write("{\"columns\":");
+    out.write(QJsonDocument(table.value("columns").toArray()).toJson(QJsonDocument::Compact));
+    out.write(",\"rows\":[");
+    if (buffer.segment) {
+        // Spilled rows are already JSON text, they are copied as is
+        QTemporaryFile &segment = *buffer.segment;
+        qint64 copied = 0;
+        if (segment.seek(0)) {
+            QByteArray chunk;
+            while (!(chunk = segment.read(Stream::FLUSH_SIZE)).isEmpty()) {
+                out.write(chunk);
+                copied += chunk.size();
+            }
+        }
+        if (copied != segment.size()) {
+            qWarning() << "ReportWriter: cannot read a row segment back";
+            out.fail();
+        }
+    }
+    QByteArray &bytes = out.buffer();
+    for (std::size_t r = 0; r < buffer.rowEnds.size(); ++r) {
+        appendRows(bytes, buffer, r, r + 1);
+        out.maybeFlush();
+    }
+    out.write("],\"title\":");
+    QByteArray title;
+    appendJsonString(title, table.value("title").toString());
+    out.write(title);
+    out.write(",\"type\":\"table\"}");
 }
 
-void ReportWriter::writeCRC()
+void ReportWriter::appendRows(QByteArray &out, const TableBuffer &buffer, std::size_t first, std::size_t last)
 {
-    uint32_t crc = calculateCRC();
-    QString hex = QString("0x%1").arg(crc, 8, 16, QLatin1Char('0')).toUpper();
-    m_report.insert("checksum", hex);
+    for (std::size_t r = first; r < last; ++r) {
+        const std::size_t begin = (r == 0) ? 0 : buffer.rowEnds[r - 1];
+        const std::size_t end = buffer.rowEnds[r];
+        if (buffer.spilledRows + r > 0) out += ',';
+        out += '[';
+        for (std::size_t i = begin; i < end; ++i) {
+            if (i > begin) out += ',';
+            appendCell(out, buffer.cells[i]);
+        }
+        out += ']';
+    }
+}
+
+bool ReportWriter::writeCborReport(QIODevice &device, const Contents &report)
+{
+    std::vector<int> tableOf(report.solution.size(), -1); // item index -> index in tables
+    for (std::size_t i = 0; i < report.tables.size(); ++i) {
+        tableOf[report.tables[i].itemIndex] = static_cast<int>(i);
+    }
+
+    // Keys in the order QJsonObject keeps them, as in the JSON report
+    Stream out(device);
+    out.write(ReportCbor::header());
+    out.setHashing(true);
+    out.write(ReportCbor::mapHead(3));
+    out.write(ReportCbor::encodeJson(QStringLiteral("result")));
+    out.write(ReportCbor::encodeJson(report.result));
+    out.write(ReportCbor::encodeJson(QStringLiteral("solution")));
+    out.write(ReportCbor::arrayHead(report.solution.size()));
+    for (qsizetype i = 0; i < report.solution.size() && out.ok(); ++i) {
+        const QJsonObject item = report.solution.at(i).toObject();
+        if (tableOf[i] < 0) {
+            out.write(ReportCbor::encodeJson(item));
+        } else if (!writeCborTable(out, item, report.tables[tableOf[i]])) {
+            qWarning() << "ReportWriter: cannot read a row segment back";
+            return false;
+        }
+    }
+    out.write(ReportCbor::encodeJson(QStringLiteral("task")));
+    out.write(ReportCbor::encodeJson(report.task));
+    out.setHashing(false);
+    out.write(ReportCbor::trailer(out.checksum()));
+    out.flush();
+    return out.ok();
+}
+
+bool ReportWriter::writeCborTable(Stream &out, const QJsonObject &table, const TableBuffer &buffer)
+{
+    std::shared_ptr<const MappedFile> segment;
+    if (buffer.segment) {
+        if (!buffer.segment->flush() || !(segment = MappedFile::open(buffer.segment->fileName()))) {
+            return false;
+        }
+    }
+    const std::size_t rows = buffer.rowCount();
+    const std::size_t columns = static_cast<std::size_t>(table.value("columns").toArray().size());
+    out.write(ReportCbor::tableHead(table, static_cast<qsizetype>(rows)));
+    QByteArray &bytes = out.buffer();
+    for (std::size_t c = 0; c < columns; ++c) {
+        const bool numeric = (c >= buffer.textColumns.size() || !buffer.textColumns[c]);
+        out.write(numeric ? ReportCbor::packedHead(static_cast<qsizetype>(rows))
+                          : ReportCbor::arrayHead(rows));
+        // Appends a cell of the column, invalid for an empty one
+        auto append = [&](const QVariant &value) {
+            if (numeric) {
+                const double v = value.isValid() ? value.toDouble() : std::numeric_limits<double>::quiet_NaN();
+                ReportCbor::appendPacked(bytes, &v, 1);
+            } else {
+                bytes += (value.isValid() ? QCborValue::fromVariant(value) : QCborValue(nullptr)).toCbor();
+            }
+            out.maybeFlush();
+        };
+
+        if (segment) {
+            // Spilled rows are "[...],[...]": cell c of every row, the
+            // other cells are only skipped
+            JsonCursor cursor(segment->bytes());
+            for (std::size_t r = 0; r < buffer.spilledRows; ++r) {
+                if ((r > 0 && !cursor.nextElement()) || !cursor.enterArray()) {
+                    return false;
+                }
+                QVariant value;
+                for (std::size_t i = 0; cursor.nextElement(); ++i) {
+                    if (i == c ? !cursor.readValue(&value) : !cursor.skipValue()) break;
+                }
+                if (cursor.failed()) {
+                    return false;
+                }
+                append(value);
+            }
+        }
+        for (std::size_t r = 0; r < buffer.rowEnds.size(); ++r) {
+            const std::size_t begin = (r == 0) ? 0 : buffer.rowEnds[r - 1];
+            if (begin + c >= buffer.rowEnds[r]) {
+                append(QVariant()); // short row
+                continue;
+            }
+            const Cell &cell = buffer.cells[begin + c];
+            if (std::holds_alternative<std::string>(cell)) append(qs(std::get<std::string>(cell)));
+            else if (std::holds_alternative<double>(cell)) append(std::get<double>(cell));
+            else if (std::holds_alternative<long long>(cell)) append(static_cast<qint64>(std::get<long long>(cell)));
+            else append(std::get<bool>(cell));
+        }
+    }
+    return true;
+}
+
+bool ReportWriter::saveJson(const QString &fileName, const QJsonObject &report)
+{
+    return FileManager::saveFile(fileName, [&](QIODevice &device) {
+        const QByteArray data = QJsonDocument(report.value("data").toObject()).toJson(QJsonDocument::Compact);
+        const uint32_t crc = Crc32::compute(data.constData(), static_cast<std::size_t>(data.size()));
+        const QString hex = QString("0x%1").arg(crc, 8, 16, QLatin1Char('0')).toUpper();
+        const QByteArray tail = ",\"checksum\":\"" + hex.toLatin1() + "\"}\n";
+        return device.write("{\"data\":") == 8
+            && device.write(data) == data.size()
+            && device.write(tail) == tail.size();
+    });
 }
 
 QString ReportWriter::fileName(FullAlgoType::Type type)
@@ -204,13 +593,6 @@ QString ReportWriter::fileName(FullAlgoType::Type type)
     QString enumName = key ? QString::fromLatin1(key) : QString::number(static_cast<int>(type));
 
     QString timestamp = QDateTime::currentDateTime().toString("dd-MM-yyyy-HH-mm-ss");
-    return QString("%1-%2.json").arg(enumName, timestamp);
-}
-
-uint32_t ReportWriter::calculateCRC()
-{
-    QJsonObject dataObj = m_report.value("data").toObject();
-    QJsonDocument doc(dataObj);
-    QByteArray ba = doc.toJson(QJsonDocument::Compact);
-    return FileManager::crc32FromBytes(ba);
+    const char *extension = (m_format == ReportFormat::CBOR) ? "cbor" : "json";
+    return QString("%1-%2.%3").arg(enumName, timestamp, QLatin1String(extension));
 }
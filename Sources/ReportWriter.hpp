@@ -9,23 +9,92 @@
 #include "AppEnums.hpp"
 #include "InputData.hpp"
 
+#include <SolverCore/Instrument.hpp>
+#include <SolverCore/RowSampling.hpp>
+
 #include <QJsonArray>
 #include <QJsonObject>
 #include <QJsonDocument>
+#include <QIODevice>
+#include <QTemporaryFile>
 #include <QVariant>
 #include <QString>
 
+#include <memory>
+#include <variant>
+#include <vector>
+
+class ReportSaver;
+
 class ReportWriter {
 
 public:
     using Cell = std::variant<std::string, double, long long, bool>;
 
+    static constexpr std::size_t DEFAULT_SPILL_BYTES = 8 << 20;
+
+    /**
+     * Append-only storage of a single table. Rows are packed one after
+     * another into cells and serialized straight to the file. With
+     * spilling on, full chunks of rows go to a temporary segment file as
+     * JSON text and only the last chunk is kept in memory.
+     */
+    struct TableBuffer {
+        int itemIndex;                    // index of the table in solution
+        std::vector<Cell> cells;          // cells of the rows in memory, row by row
+        std::vector<std::size_t> rowEnds; // end offset of each row in cells
+        std::vector<bool> textColumns;    // column -> has a text or bool cell
+        std::unique_ptr<QTemporaryFile> segment; // rows written out, "[...],[...]"
+        std::size_t spilledRows = 0;
+        bool spillFailed = false;         // keep the rest in memory
+        std::unique_ptr<SC::RowSampler<std::vector<Cell>>> sampler; // nullptr: every row
+
+        std::size_t rowCount() const { return spilledRows + rowEnds.size(); }
+    };
+    /**
+     * A finished report, taken out of the writer by end()
+     */
+    struct Contents {
+        QString fileName;
+        ReportFormat::Type format;
+        QJsonObject task;
+        QJsonArray solution;
+        QJsonObject result;
+        std::vector<TableBuffer> tables;
+    };
+
     ReportWriter();
 
     void setInputData(const InputData *inputData)
     {
         m_inputData = inputData;
     }
+    /**
+     * Format of the reports written from the next begin() on
+     */
+    void setFormat(ReportFormat::Type format) { m_format = format; }
+    ReportFormat::Type format() const { return m_format; }
+    /**
+     * With a saver end() only hands the report over to it and returns,
+     * the file is written on the I/O thread (see ReportSaver::reportSaved).
+     * Without one end() writes the file itself.
+     */
+    void setSaver(ReportSaver *saver) { m_saver = saver; }
+    /**
+     * Rows of a table that take more than bytes in memory are moved to a
+     * temporary file and put into the report in end(), so the memory of a
+     * report does not grow with the number of iterations. 0 keeps all rows
+     * in memory.
+     */
+    void setSpillThreshold(std::size_t bytes) { m_spillBytes = bytes; }
+    std::size_t spillThreshold() const { return m_spillBytes; }
+    /**
+     * Which rows of the tables opened from the next begin() on are
+     * recorded. The policy goes to task.rowSampling of the report together
+     * with the number of rows each table had before sampling.
+     */
+    void setRowSampling(const SC::RowSampling &sampling) { m_sampling = sampling; }
+    const SC::RowSampling &rowSampling() const { return m_sampling; }
 
     int begin();
 
@@ -50,19 +119,44 @@ public:
      * Closes the table so that no more rows can be written to it
      */
     void endTable(int tableId);
+    /**
+     * Stores the per-phase timings of the solve, written to task.stats.
+     * Ignored when the instrumentation is compiled out.
+     */
+    void insertStats(const SC::SolveStats &stats);
 
+    /**
+     * Finishes the report and writes it, or queues it when a saver is set
+     * @return 0 on success (queued), -1 if the file cannot be written
+     */
     int end();
 
     const QString &fileName() const { return m_fileName; }
 
+    /**
+     * Writes a report object (e.g. converted from CBOR) as a JSON report
+     * with a freshly calculated checksum.
+     */
+    static bool saveJson(const QString &fileName, const QJsonObject &report);
+    /**
+     * Writes a finished report to report.fileName in report.format
+     */
+    static bool save(const Contents &report);
+
 private:
     const InputData *m_inputData;
+    ReportFormat::Type m_format;
+    ReportSaver *m_saver;
+    std::size_t m_spillBytes;
+    SC::RowSampling m_sampling;
     QString m_path;
     QString m_fileName;
     QJsonObject m_report;
     QJsonArray m_solution;
     QJsonObject m_result;
-    QHash<int,int> m_openTables; // tableId -> index in items
+    QJsonObject m_stats;
+    std::vector<TableBuffer> m_tables; // tableId - 1 -> table buffer
+    QHash<int,int> m_openTables; // tableId -> index in m_tables
     int m_nextTableId;
     
     /**
@@ -75,21 +169,50 @@ private:
      */
     inline void writeInputData();
     /**
-     * Inserts m_solution into data.solution and m_result into
-     * data.result in m_report .
+     * Buffered output that keeps a running CRC of the data section.
+     * Defined in ReportWriter.cpp.
      */
-    inline void writeSolutionAndResult();
+    class Stream;
     /**
-     * Inserts CRC calculated with calculateCRC method into m_report.
+     * Serializes the report into device in a single pass:
+     * { "data": {...}, "checksum": "0X........" }
+     * The data section is written in compact form, byte for byte as
+     * QJsonDocument would write it, and the checksum is the CRC-32 of
+     * exactly these bytes, so it can be verified without parsing.
      */
-    inline void writeCRC();
-
-    inline QString fileName(FullAlgoType::Type type);
+    static bool writeReport(QIODevice &device, const Contents &report);
+    static void writeTable(Stream &out, const QJsonObject &table, const TableBuffer &buffer);
+    /**
+     * Writes the rows held back by the sampler of the table
+     */
+    void finishTable(TableBuffer &buffer);
+    QJsonObject samplingInfo() const;
     /**
-     * Calculates a checksum from the entire contents of the data section
-     * in m_report.
+     * Stores a row that passed the sampling
      */
-    inline uint32_t calculateCRC();
+    void appendRow(TableBuffer &buffer, const std::vector<Cell> &row);
+    /**
+     * Moves the rows in memory to the segment file of the table
+     */
+    void spill(TableBuffer &buffer);
+    /**
+     * Appends rows [first, last) of the rows in memory as JSON text,
+     * each but the first one of the table preceded by a comma
+     */
+    static void appendRows(QByteArray &out, const TableBuffer &buffer, std::size_t first, std::size_t last);
+    /**
+     * Serializes the report into device in the CBOR format, see ReportCbor,
+     * in a single pass like writeReport
+     */
+    static bool writeCborReport(QIODevice &device, const Contents &report);
+    /**
+     * Writes the cells of a table column by column. The spilled rows are
+     * not read back into memory: each column is picked out of the mapped
+     * segment file in its own pass.
+     */
+    static bool writeCborTable(Stream &out, const QJsonObject &table, const TableBuffer &buffer);
+
+    inline QString fileName(FullAlgoType::Type type);
 };
 
 #endif // SOURCES_REPORTWRITER_HPP_
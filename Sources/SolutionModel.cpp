@@ -4,12 +4,14 @@
 //
 
 #include "SolutionModel.hpp"
+#include "SolutionTableModel.hpp"
 
 #include <QVariant>
 
 SolutionModel::SolutionModel(QObject *parent)
     : QAbstractListModel(parent)
     , m_items{}
+    , m_tables{}
 {
 }
 
@@ -36,17 +38,7 @@ QVariant SolutionModel::data(const QModelIndex &index, int role) const
         for (const QJsonValue &v : cols) list << v.toString();
         return list;
     }
-    case RowsRole: {
-        QJsonArray rows = obj.value("rows").toArray();
-        QVariantList out;
-        for (const QJsonValue &r : rows) {
-            QJsonArray row = r.toArray();
-            QVariantList rowList;
-            for (const QJsonValue &cell : row) rowList << cell.toVariant();
-            out << QVariant::fromValue(rowList);
-        }
-        return out;
-    }
+    case TableRole: return QVariant::fromValue<QObject *>(m_tables.at(index.row()));
     default:
         return {};
     }
@@ -60,13 +52,37 @@ QHash<int, QByteArray> SolutionModel::roleNames() const
     roles[ValueRole] = "value";
     roles[TextRole] = "text";
     roles[ColumnsRole] = "columns";
-    roles[RowsRole] = "rows";
+    roles[TableRole] = "table";
     return roles;
 }
 
-void SolutionModel::setData(const QJsonArray &arr)
+void SolutionModel::setData(const ReportSolution &solution)
 {
+    const QJsonArray &arr = solution.items;
     beginResetModel();
-    m_items = arr;
+    qDeleteAll(m_tables);
+    m_tables.clear();
+    m_items = QJsonArray();
+    m_tables.reserve(arr.size());
+    for (qsizetype i = 0; i < arr.size(); ++i) {
+        QJsonObject obj = arr.at(i).toObject();
+        SolutionTableModel *table = nullptr;
+        if (obj.value("type").toString() == "table") {
+            table = new SolutionTableModel(this);
+            auto deferred = solution.deferredRows.value(i);
+            auto cbor = solution.cborTables.value(i);
+            if (deferred) {
+                table->setDeferred(obj.value("columns").toArray(), std::move(deferred));
+            } else if (cbor) {
+                table->setCbor(obj.value("columns").toArray(), std::move(cbor));
+            } else {
+                // Rows move into the typed storage of the table model
+                table->setData(obj.value("columns").toArray(), obj.value("rows").toArray());
+                obj.remove("rows");
+            }
+        }
+        m_items.append(obj);
+        m_tables.append(table);
+    }
     endResetModel();
 }
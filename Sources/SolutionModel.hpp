@@ -6,11 +6,16 @@
 #ifndef SOURCES_SOLUTIONMODEL_HPP_
 #define SOURCES_SOLUTIONMODEL_HPP_
 
+#include "DeferredRows.hpp"
+
 #include <QAbstractListModel>
 #include <QJsonArray>
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QString>
+#include <QVector>
+
+class SolutionTableModel;
 
 class SolutionModel : public QAbstractListModel {
     Q_OBJECT
@@ -21,7 +26,7 @@ public:
         ValueRole,
         TextRole,
         ColumnsRole,
-        RowsRole
+        TableRole   // SolutionTableModel of a "table" item, null for the others
     };
 
     SolutionModel(QObject *parent = nullptr);
@@ -31,10 +36,11 @@ public:
     QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
     QHash<int, QByteArray> roleNames() const override;
 
-    void setData(const QJsonArray &arr);
+    void setData(const ReportSolution &solution);
 
 private:
-    QJsonArray m_items;
+    QJsonArray m_items;                      // items without the table rows
+    QVector<SolutionTableModel *> m_tables;  // item index -> table model or nullptr
 };
 
 #endif // SOURCES_SOLUTIONMODEL_HPP_
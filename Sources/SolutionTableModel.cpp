@@ -0,0 +1,167 @@
+//
+// Created on 17 Oct, 2026
+//  by alecproj
+//
+
+#include "SolutionTableModel.hpp"
+
+#include <QJsonValue>
+#include <QtEndian>
+
+#include <cmath>
+#include <limits>
+
+static constexpr double NULL_CELL = std::numeric_limits<double>::quiet_NaN();
+
+SolutionTableModel::SolutionTableModel(QObject *parent)
+    : QAbstractTableModel(parent)
+    , m_columns{}
+    , m_rowCount{0}
+    , m_deferred{}
+    , m_cbor{}
+{
+}
+
+void SolutionTableModel::setData(const QJsonArray &columns, const QJsonArray &rows)
+{
+    beginResetModel();
+    m_deferred.reset();
+    m_cbor.reset();
+    m_columns.clear();
+    m_columns.resize(columns.size());
+    for (qsizetype i = 0; i < columns.size(); ++i) {
+        m_columns[i].title = columns.at(i).toString();
+        m_columns[i].numbers.reserve(rows.size());
+    }
+    for (const QJsonValue &r : rows) {
+        const QJsonArray row = r.toArray();
+        for (qsizetype i = 0; i < qsizetype(m_columns.size()); ++i) {
+            // Short rows are padded with empty cells
+            m_columns[i].append(i < row.size() ? row.at(i) : QJsonValue());
+        }
+    }
+    m_rowCount = rows.size();
+    endResetModel();
+}
+
+void SolutionTableModel::setDeferred(const QJsonArray &columns, std::shared_ptr<DeferredRows> rows)
+{
+    beginResetModel();
+    m_columns.clear();
+    m_columns.resize(columns.size());
+    for (qsizetype i = 0; i < columns.size(); ++i) {
+        m_columns[i].title = columns.at(i).toString();
+    }
+    m_rowCount = 0;
+    m_cbor.reset();
+    m_deferred = std::move(rows);
+    endResetModel();
+}
+
+void SolutionTableModel::setCbor(const QJsonArray &columns, std::shared_ptr<const CborTable> table)
+{
+    beginResetModel();
+    m_deferred.reset();
+    m_columns.clear();
+    m_columns.resize(columns.size());
+    m_rowCount = table->rowCount();
+    for (qsizetype i = 0; i < columns.size(); ++i) {
+        Column &col = m_columns[i];
+        col.title = columns.at(i).toString();
+        if (i < table->columnCount() && !table->column(int(i)).packed.isEmpty()) {
+            col.typeKnown = true;
+            col.packed = table->column(int(i)).packed.data();
+        }
+    }
+    m_cbor = std::move(table);
+    endResetModel();
+}
+
+int SolutionTableModel::rowCount(const QModelIndex &parent) const
+{
+    if (parent.isValid()) return 0;
+    return rows();
+}
+
+int SolutionTableModel::columnCount(const QModelIndex &parent) const
+{
+    if (parent.isValid()) return 0;
+    return static_cast<int>(m_columns.size());
+}
+
+QVariant SolutionTableModel::data(const QModelIndex &index, int role) const
+{
+    if (role != Qt::DisplayRole) return {};
+    if (!index.isValid()) return {};
+    if (index.row() < 0 || index.row() >= rows()) return {};
+    if (index.column() < 0 || index.column() >= columnCount()) return {};
+
+    if (m_deferred) {
+        const QVariant value = m_deferred->cell(index.row(), index.column());
+        return value.isValid() ? value : QString();
+    }
+
+    const Column &col = m_columns[index.column()];
+    if (m_cbor && !col.packed) {
+        const QVariant value = m_cbor->cell(index.row(), index.column());
+        return value.isValid() ? value : QString();
+    }
+    if (col.type == Column::Text) {
+        return col.texts.at(index.row());
+    }
+    const double value = col.packed
+        ? qFromLittleEndian<double>(col.packed + index.row() * sizeof(double))
+        : col.numbers[index.row()];
+    if (std::isnan(value)) return QString();
+    if (col.type == Column::Bool) return value != 0.0;
+    return value;
+}
+
+QVariant SolutionTableModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    if (role != Qt::DisplayRole) return {};
+    if (orientation == Qt::Horizontal) {
+        if (section < 0 || section >= columnCount()) return {};
+        return m_columns[section].title;
+    }
+    return section + 1;
+}
+
+void SolutionTableModel::Column::append(const QJsonValue &value)
+{
+    if (value.isNull() || value.isUndefined()) {
+        if (type == Text) texts.append(QString());
+        else numbers.push_back(NULL_CELL);
+        return;
+    }
+
+    Type valueType = Text;
+    if (value.isDouble()) valueType = Number;
+    else if (value.isBool()) valueType = Bool;
+
+    if (!typeKnown) {
+        typeKnown = true;
+        if (valueType == Text) toText();
+        else type = valueType;
+    } else if (type != Text && valueType != type) {
+        toText();
+    }
+
+    switch (type) {
+    case Number: numbers.push_back(value.toDouble()); break;
+    case Bool:   numbers.push_back(value.toBool() ? 1.0 : 0.0); break;
+    case Text:   texts.append(value.toVariant().toString()); break;
+    }
+}
+
+void SolutionTableModel::Column::toText()
+{
+    texts.reserve(numbers.capacity());
+    for (double v : numbers) {
+        if (std::isnan(v)) texts.append(QString());
+        else if (type == Bool) texts.append(v != 0.0 ? QStringLiteral("true") : QStringLiteral("false"));
+        else texts.append(QString::number(v, 'g', 17));
+    }
+    numbers = {};
+    type = Text;
+}
@@ -0,0 +1,84 @@
+//
+// Created on 17 Oct, 2026
+//  by alecproj
+//
+
+#ifndef SOURCES_SOLUTIONTABLEMODEL_HPP_
+#define SOURCES_SOLUTIONTABLEMODEL_HPP_
+
+#include "CborTable.hpp"
+#include "DeferredRows.hpp"
+
+#include <QAbstractTableModel>
+#include <QJsonArray>
+#include <QStringList>
+
+#include <memory>
+#include <vector>
+
+/**
+ * One table of a report solution. Cells are kept column by column in
+ * typed storage and converted to QVariant only when a view asks for them,
+ * so a view that creates delegates for the visible cells only (TableView)
+ * costs the same for 10 rows and for 100k rows. Rows that were left in
+ * the report file (DeferredRows) and packed columns of a CBOR report
+ * (CborTable) are not copied at all.
+ */
+class SolutionTableModel : public QAbstractTableModel {
+    Q_OBJECT
+
+    Q_PROPERTY(int rows READ rows CONSTANT)
+    Q_PROPERTY(int columns READ columns CONSTANT)
+public:
+    explicit SolutionTableModel(QObject *parent = nullptr);
+
+    /**
+     * Fills the model from the "columns" and "rows" arrays of a report table
+     */
+    void setData(const QJsonArray &columns, const QJsonArray &rows);
+    /**
+     * Shows the rows from the report file, they are read as they are viewed
+     */
+    void setDeferred(const QJsonArray &columns, std::shared_ptr<DeferredRows> rows);
+    /**
+     * Shows the cells of a CBOR report table. Packed columns are read from
+     * the report file in place, other columns are decoded block by block
+     * as they are viewed (see CborTable).
+     */
+    void setCbor(const QJsonArray &columns, std::shared_ptr<const CborTable> table);
+
+    int rows() const { return m_deferred ? m_deferred->rowCount() : m_rowCount; }
+    int columns() const { return static_cast<int>(m_columns.size()); }
+
+    // QAbstractTableModel
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+
+private:
+    /**
+     * Storage of one column. A column holds numbers (null is NaN) until a
+     * value of another type shows up, then it is converted to text.
+     */
+    struct Column {
+        enum Type { Number, Bool, Text };
+
+        QString title;
+        Type type = Number;
+        bool typeKnown = false;          // no non-null value seen yet
+        std::vector<double> numbers;     // Number and Bool (0/1) columns
+        const char *packed = nullptr;    // Number column read in place (float64 LE)
+        QStringList texts;               // Text columns
+
+        void append(const QJsonValue &value);
+        void toText();
+    };
+
+    std::vector<Column> m_columns;   // only titles for deferred rows and encoded CBOR columns
+    int m_rowCount;
+    std::shared_ptr<DeferredRows> m_deferred;
+    std::shared_ptr<const CborTable> m_cbor; // keeps packed columns valid
+};
+
+#endif // SOURCES_SOLUTIONTABLEMODEL_HPP_
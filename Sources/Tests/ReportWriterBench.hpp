@@ -0,0 +1,84 @@
+#ifndef SOURCES_TESTS_REPORTWRITERBENCH_HPP_
+#define SOURCES_TESTS_REPORTWRITERBENCH_HPP_
+
+#include "ReportWriter.hpp"
+#include "FileManager.hpp"
+#include "AppEnums.hpp"
+#include <QElapsedTimer>
+#include <QDebug>
+
+/**
+ * Measures how the cost of building a report grows with the number of
+ * rows in an iteration table. With append-only tables the time per row
+ * must stay flat for 10k, 100k and 1M rows.
+ */
+class ReportWriterBench {
+    ReportWriter reporter;
+    InputData data;
+public:
+    void run()
+    {
+        prepareData();
+        reporter.setInputData(&data);
+        // All rows in memory, then rows spilled to a segment file
+        for (std::size_t spill : {std::size_t{0}, ReportWriter::DEFAULT_SPILL_BYTES}) {
+            reporter.setSpillThreshold(spill);
+            for (long long rows : {10000LL, 100000LL, 1000000LL}) {
+                runOnce(rows);
+            }
+        }
+    }
+private:
+    void runOnce(long long rowsCnt)
+    {
+        QElapsedTimer timer;
+        timer.start();
+        if (reporter.begin() != 0) {
+            qDebug() << "BENCH FAIL: reporter.begin";
+            return;
+        }
+        auto tid = reporter.beginTable("Шаги запуска",
+            {"Номер итерации i", "x_i", "y_i", "f_i", "Градиент", "Шаг"});
+        for (long long i = 0; i < rowsCnt; ++i) {
+            double x = 1.0 / (i + 1);
+            reporter.insertRow(tid, {i, x, -x, x * x, 2.0 * x, 0.1});
+        }
+        reporter.endTable(tid);
+        reporter.insertResult(0.0, 0.0, 0.0);
+        const qint64 insertNs = timer.nsecsElapsed();
+        if (reporter.end() != 0) {
+            qDebug() << "BENCH FAIL: reporter.end";
+            return;
+        }
+        const qint64 totalNs = timer.nsecsElapsed();
+        FileManager::deleteFile(reporter.fileName());
+
+        qDebug().nospace() << "BENCH ReportWriter rows=" << rowsCnt
+            << " spill=" << reporter.spillThreshold()
+            << " insert=" << insertNs / 1000000 << "ms"
+            << " end=" << (totalNs - insertNs) / 1000000 << "ms"
+            << " total=" << totalNs / 1000000 << "ms"
+            << " perRow=" << double(totalNs) / rowsCnt << "ns";
+    }
+
+    inline void prepareData()
+    {
+        data.setFunction("x^2 + y^2");
+        data.setAlgorithmId(AlgoType::GD);
+        data.setExtensionId(ExtensionType::B);
+        data.setFullAlgoId(FullAlgoType::GDB);
+        data.setExtremumId(ExtremumType::MINIMUM);
+        data.setStepId(StepType::CONSTANT);
+        data.setMinX(-10.0);
+        data.setMaxX(10.0);
+        data.setMinY(-10.0);
+        data.setMaxY(10.0);
+        data.setResultAccuracy(6);
+        data.setCalcAccuracy(8);
+        data.setStep(0.1);
+        data.setMaxIterations(1000000);
+        data.setMaxFuncCalls(10000000);
+    }
+};
+
+#endif // SOURCES_TESTS_REPORTWRITERBENCH_HPP_
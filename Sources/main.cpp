@@ -3,6 +3,7 @@
 #include "MainController.hpp"
 
 #include "Tests/TestReporter.hpp"
+#include "Tests/ReportWriterBench.hpp"
 #include <muParser.h>
 
 #include <QGuiApplication>
@@ -43,6 +44,8 @@ int main(int argc, char *argv[])
         //testMuparser();
         //TestReporter test;
         //test.test();
+        //ReportWriterBench bench;
+        //bench.run();
     }
 
     /* ------------- /TEST ------------- */
@@ -55,6 +58,8 @@ int main(int argc, char *argv[])
     qmlRegisterUncreatableType<FullAlgoType>("AppEnums", 1, 0, "FullAlgoType", "Full algo type ID");
     qmlRegisterUncreatableType<CheckList>("AppEnums", 1, 0, "CheckList", "Input data check list");
     qmlRegisterUncreatableType<Result>("AppEnums", 1, 0, "Result", "Result of MainController methods");
+    qmlRegisterUncreatableType<ReportFormat>("AppEnums", 1, 0, "ReportFormat", "Report file format");
+    qmlRegisterUncreatableType<RowPolicy>("AppEnums", 1, 0, "RowPolicy", "Iteration rows recorded in reports");
     qmlRegisterType<EnumHelper>("AppEnums", 1, 0, "EnumHelper");
     qmlRegisterType<InputData>("InputData", 1, 0, "InputData");
 